@@ -1395,7 +1395,7 @@ CbcHeuristicFPump::solution(double & solutionValue,
                     solution = solver->getColSolution();
                     numberIterations = solver->getIterationCount();
                 } else {
-                    int * addStart = new int[2*general+1];
+                    CoinBigIndex * addStart = new CoinBigIndex[2*general+1];
                     int * addIndex = new int[4*general];
                     double * addElement = new double[4*general];
                     double * addLower = new double[2*general];
@@ -411,7 +411,7 @@ expandKnapsack(CoinModel & model, int * whichColumn, int * knapsackStart,
                 nelLargest = CoinMax(nelLargest, nLargest) + 1;
                 double * buildObj = new double [nLargest];
                 double * buildElement = new double [nelLargest];
-                int * buildStart = new int[nLargest+1];
+                CoinBigIndex * buildStart = new CoinBigIndex[nLargest+1];
                 int * buildRow = new int[nelLargest];
                 // alow for integers in knapsacks
                 OsiObject ** object = new OsiObject * [numberKnapsack+nTotal];
@@ -424,7 +424,7 @@ expandKnapsack(CoinModel & model, int * whichColumn, int * knapsackStart,
                     coinModel.expandKnapsack(iRow, nCreate, buildObj, buildStart, buildRow, buildElement);
                     // Redo row numbers
                     for (iColumn = 0; iColumn < nCreate; iColumn++) {
-                        for (int j = buildStart[iColumn]; j < buildStart[iColumn+1]; j++) {
+                        for (CoinBigIndex j = buildStart[iColumn]; j < buildStart[iColumn+1]; j++) {
                             int jRow = buildRow[j];
                             jRow = lookupRow[jRow];
                             assert (jRow >= 0 && jRow < nRow);
@@ -59,7 +59,7 @@ CglFlowCover::flowPreprocess(const OsiSolverInterface& si) const
 
   const double* coefByRow  = matrixByRow.getElements();
   const int* colInds       = matrixByRow.getIndices();
-  const int* rowStarts     = matrixByRow.getVectorStarts();
+  const CoinBigIndex* rowStarts     = matrixByRow.getVectorStarts();
   const int* rowLengths    = matrixByRow.getVectorLengths();
   int iRow      = -1; 
   int iCol      = -1;
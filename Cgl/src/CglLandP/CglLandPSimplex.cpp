@@ -1227,7 +1227,7 @@ CglLandPSimplex::fastFindCutImprovingPivotRow( int &direction, int &gammaSign,
     const CoinPackedMatrix* mat = si_->getMatrixByCol();
 
     const CoinBigIndex* starts = mat->getVectorStarts();
-    const CoinBigIndex * lengths = mat->getVectorLengths();
+    const int * lengths = mat->getVectorLengths();
     const int * indices = mat->getIndices();
     const double * elements = mat->getElements();
 
@@ -2617,7 +2617,7 @@ CglLandPSimplex::createIntersectionCut(TabRow & row, OsiRowCut &cut) const
     const CoinBigIndex * starts = mat->getVectorStarts();
     const int * lengths = mat->getVectorLengths();
     const double * values = mat->getElements();
-    const CoinBigIndex * indices = mat->getIndices();
+    const int * indices = mat->getIndices();
     for (int j = 0 ; j < ncols_ ; j++)
     {
         const int& start = starts[j];
@@ -2788,7 +2788,7 @@ CglLandPSimplex::eliminate_slacks(double * vec) const
     const CoinBigIndex * starts = mat->getVectorStarts();
     const int * lengths = mat->getVectorLengths();
     const double * values = mat->getElements();
-    const CoinBigIndex * indices = mat->getIndices();
+    const int * indices = mat->getIndices();
     const double * vecSlacks = vec + ncols_orig_;
     for (int j = 0 ; j < ncols_ ; j++)
     {
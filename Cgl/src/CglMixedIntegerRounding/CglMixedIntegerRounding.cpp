@@ -72,14 +72,14 @@ CglMixedIntegerRounding::generateCuts(const OsiSolverInterface& si,
   const double* LHS        = si.getRowActivity();
   const double* coefByRow  = matrixByRow.getElements();
   const int* colInds       = matrixByRow.getIndices();
-  const int* rowStarts     = matrixByRow.getVectorStarts();
+  const CoinBigIndex* rowStarts     = matrixByRow.getVectorStarts();
   const int* rowLengths    = matrixByRow.getVectorLengths();
 
   // get matrix by column
   //const CoinPackedMatrix & matrixByCol = *si.getMatrixByCol();
   const double* coefByCol  = matrixByCol.getElements();
   const int* rowInds       = matrixByCol.getIndices();
-  const int* colStarts     = matrixByCol.getVectorStarts();
+  const CoinBigIndex* colStarts     = matrixByCol.getVectorStarts();
   const int* colLengths    = matrixByCol.getVectorLengths();
 
 
@@ -321,7 +321,7 @@ mixIntRoundPreprocess(const OsiSolverInterface& si) const
   numCols_ = si.getNumCols();
   const double* coefByRow  = matrixByRow.getElements();
   const int* colInds       = matrixByRow.getIndices();
-  const int* rowStarts     = matrixByRow.getVectorStarts();
+  const CoinBigIndex* rowStarts     = matrixByRow.getVectorStarts();
   const int* rowLengths    = matrixByRow.getVectorLengths();
   // Get copies of sense and RHS so we can modify if ranges
   if (sense_) {
@@ -659,12 +659,12 @@ CglMixedIntegerRounding::generateMirCuts(
 			    const double* LHS,
 			    const double* /*coefByRow*/,
 			    const int* /*colInds*/,
-			    const int* /*rowStarts*/,
+			    const CoinBigIndex* /*rowStarts*/,
 			    const int* /*rowLengths*/,
 			    //const CoinPackedMatrix& matrixByCol,
 			    const double* coefByCol,
 			    const int* rowInds,
-			    const int* colStarts,
+			    const CoinBigIndex* colStarts,
 			    const int* colLengths,
 			    OsiCuts& cs ) const
 {
@@ -904,7 +904,7 @@ CglMixedIntegerRounding::selectRowToAggregate(
 			    const double* colLowerBound,
 			    const std::set<int>& setRowsAggregated,
 			    const double* xlp, const double* coefByCol,
-			    const int* rowInds, const int* colStarts,
+			    const int* rowInds, const CoinBigIndex* colStarts,
 			    const int* colLengths,
 			    int& rowSelected,
 			    int& colSelected ) const
@@ -80,7 +80,7 @@ CglMixedIntegerRounding2::generateCuts(const OsiSolverInterface& si,
   //const CoinPackedMatrix & matrixByCol = *si.getMatrixByCol();
   const double* coefByCol  = matrixByCol.getElements();
   const int* rowInds       = matrixByCol.getIndices();
-  const int* colStarts     = matrixByCol.getVectorStarts();
+  const CoinBigIndex* colStarts     = matrixByCol.getVectorStarts();
 
 
   generateMirCuts(si, xlp, colUpperBound, colLowerBound,
@@ -331,7 +331,7 @@ mixIntRoundPreprocess(const OsiSolverInterface& si) const
   numCols_ = si.getNumCols();
   const double* coefByRow  = matrixByRow.getElements();
   const int* colInds       = matrixByRow.getIndices();
-  const int* rowStarts     = matrixByRow.getVectorStarts();
+  const CoinBigIndex* rowStarts     = matrixByRow.getVectorStarts();
   const int* rowLengths    = matrixByRow.getVectorLengths();
   // Get copies of sense and RHS so we can modify if ranges
   if (sense_) {
@@ -681,7 +681,7 @@ CglMixedIntegerRounding2::generateMirCuts(
 			    //const CoinPackedMatrix& matrixByCol,
 			    const double* coefByCol,
 			    const int* rowInds,
-			    const int* colStarts,
+			    const CoinBigIndex* colStarts,
 			    OsiCuts& cs ) const
 {
 
@@ -917,7 +917,7 @@ CglMixedIntegerRounding2::selectRowToAggregate(
 			    const double* colLowerBound,
 			    const CoinIndexedVector& setRowsAggregated,
 			    const double* xlp, const double* coefByCol,
-			    const int* rowInds, const int* colStarts,
+			    const int* rowInds, const CoinBigIndex* colStarts,
 			    int& rowSelected,
 			    int& colSelected ) const
 {
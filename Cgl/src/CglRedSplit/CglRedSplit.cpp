@@ -545,7 +545,7 @@ int CglRedSplit::generate_cgcut_2(int/* basic_ind*/, double *row, double *rhs) {
 /************************************************************************/
 void CglRedSplit::eliminate_slacks(double *row, 
 				   const double *elements, 
-				   const int *rowStart,
+				   const CoinBigIndex *rowStart,
 				   const int *indices,
 				   const int *rowLength,
 				   const double *rhs, double *tabrowrhs) {
@@ -1124,12 +1124,12 @@ bool CglRedSplit::rs_are_different_matrices(const CoinPackedMatrix *mat1,
 					    const int nmaj,
 					    const int /*nmin*/) {
   
-  const int *matStart1 = mat1->getVectorStarts();
+  const CoinBigIndex *matStart1 = mat1->getVectorStarts();
   const double *matElements1 = mat1->getElements();
   const int *matIndices1 = mat1->getIndices();
   const int *matRowLength1 = mat1->getVectorLengths(); 
 
-  const int *matStart2 = mat2->getVectorStarts();
+  const CoinBigIndex *matStart2 = mat2->getVectorStarts();
   const double *matElements2 = mat2->getElements();
   const int *matIndices2 = mat2->getIndices();
   const int *matRowLength2 = mat2->getVectorLengths(); 
@@ -1534,7 +1534,7 @@ double *slack_val = new double[nrow];
   double *rowelem = new double[ncol];
 
   const double *elements = byRow->getElements();
-  const int *rowStart = byRow->getVectorStarts();
+  const CoinBigIndex *rowStart = byRow->getVectorStarts();
   const int *indices = byRow->getIndices();
   const int *rowLength = byRow->getVectorLengths(); 
 
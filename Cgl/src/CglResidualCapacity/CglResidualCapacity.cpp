@@ -69,7 +69,7 @@ CglResidualCapacity::generateCuts(const OsiSolverInterface& si,
   const double* LHS        = si.getRowActivity();
   const double* coefByRow  = matrixByRow.getElements();
   const int* colInds       = matrixByRow.getIndices();
-  const int* rowStarts     = matrixByRow.getVectorStarts();
+  const CoinBigIndex* rowStarts     = matrixByRow.getVectorStarts();
   const int* rowLengths    = matrixByRow.getVectorLengths();
 
 
@@ -245,7 +245,7 @@ resCapPreprocess(const OsiSolverInterface& si) const
     numCols_ = si.getNumCols();
     const double* coefByRow  = matrixByRow.getElements();
     const int* colInds       = matrixByRow.getIndices();
-    const int* rowStarts     = matrixByRow.getVectorStarts();
+    const CoinBigIndex* rowStarts     = matrixByRow.getVectorStarts();
     const int* rowLengths    = matrixByRow.getVectorLengths();
     const double * colLowerBound = si.getColLower();
     const double * colUpperBound = si.getColUpper();
@@ -468,7 +468,7 @@ CglResidualCapacity::generateResCapCuts(
 				     const double* /*LHS*/,
 				     const double* coefByRow,
 				     const int* colInds,
-				     const int* rowStarts,
+				     const CoinBigIndex* rowStarts,
 				     const int* rowLengths,
 				     OsiCuts& cs ) const
 {
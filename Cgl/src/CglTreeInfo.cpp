@@ -1149,13 +1149,15 @@ CglTreeProbingInfo::analyze(const OsiSolverInterface & si,int createSolver)
   if (numberCliques>numberMatrixCliques) {
     newSolver = si.clone();
     // Delete all rows
-    int * start = new int [ CoinMax(numberRows,numberCliques+1)];
+    int * which = new int [numberRows];
     int i;
     for (i=0;i<numberRows;i++)
-      start[i]=i;
-    newSolver->deleteRows(numberRows,start);
+      which[i]=i;
+    newSolver->deleteRows(numberRows,which);
+    delete [] which;
+    CoinBigIndex * start = new CoinBigIndex [numberCliques+1];
     start[0]=0;
-    int numberElements = cliqueStart[numberCliques];
+    CoinBigIndex numberElements = cliqueStart[numberCliques];
     int * column = new int [numberElements];
     double * element = new double [numberElements];
     double * lower = new double [numberCliques];
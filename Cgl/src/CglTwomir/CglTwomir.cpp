@@ -379,7 +379,8 @@ DGG_data_t* DGG_getData(const void *osi_ptr )
 
   /* retrieve the matrix in row format */
   const CoinPackedMatrix *rowMatrixPtr = si->getMatrixByRow();
-  const int *rowBeg = 0, *rowCnt = 0, *rowInd = 0;
+  const CoinBigIndex *rowBeg = 0;
+  const int *rowCnt = 0, *rowInd = 0;
   const double *rowMat;
     
   rowBeg = rowMatrixPtr->getVectorStarts();
@@ -577,7 +578,8 @@ DGG_getSlackExpression(const void *osi_ptr, DGG_data_t* data, int row_index)
   /* retrieve the matrix in row format */
   const OsiSolverInterface *si = reinterpret_cast<const OsiSolverInterface *> (osi_ptr);
   const CoinPackedMatrix *rowMatrixPtr = si->getMatrixByRow();
-  const int *rowBeg = 0, *rowCnt = 0, *rowInd = 0;
+  const CoinBigIndex *rowBeg = 0;
+  const int *rowCnt = 0, *rowInd = 0;
   const double *rowMat;
   const double *rowUpper;
   const double *rowLower;
@@ -642,7 +644,7 @@ DGG_getTableauConstraint( int index,  const void *osi_ptr, DGG_data_t *data,
 
   /* obtain address of the LP matrix */
   const CoinPackedMatrix *colMatrixPtr = si->getMatrixByCol();
-  const int* colBeg = colMatrixPtr->getVectorStarts();
+  const CoinBigIndex* colBeg = colMatrixPtr->getVectorStarts();
   const int* colCnt = colMatrixPtr->getVectorLengths();
   const int* colInd = colMatrixPtr->getIndices();
   const double* colMat = colMatrixPtr->getElements();
@@ -774,7 +776,7 @@ DGG_getFormulaConstraint( int da_row,
   
   /* obtain address of the LP matrix */
   const CoinPackedMatrix *rowMatrixPtr = si->getMatrixByRow();
-  const int* rowBeg = rowMatrixPtr->getVectorStarts();
+  const CoinBigIndex* rowBeg = rowMatrixPtr->getVectorStarts();
   const int* rowCnt = rowMatrixPtr->getVectorLengths();
   const int* rowInd = rowMatrixPtr->getIndices();
   const double* rowMat = rowMatrixPtr->getElements();
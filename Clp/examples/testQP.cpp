@@ -37,7 +37,7 @@ int main(int argc, const char *argv[])
                             m.getObjCoefficients(),
                             m.getRowLower(), m.getRowUpper());
           // get quadratic part
-          int * start = NULL;
+          CoinBigIndex * start = NULL;
           int * column = NULL;
           double * element = NULL;
           m.readQuadraticMps(NULL, start, column, element, 2);
@@ -1830,8 +1830,9 @@ ClpCholeskyBase::orderAMD()
      int space = 2 * sizeFactor_ + 10000 + 4 * numberRows_;
      int * temp = new int [space];
      CoinBigIndex * count = new CoinBigIndex [numberRows_];
-     CoinBigIndex * tempStart = new CoinBigIndex [numberRows_+1];
-     memset(count, 0, numberRows_ * sizeof(int));
+     // ordering code works with int starts
+     WSI * tempStart = new WSI [numberRows_+1];
+     memset(count, 0, numberRows_ * sizeof(CoinBigIndex));
      for (int iRow = 0; iRow < numberRows_; iRow++) {
           count[iRow] += choleskyStart_[iRow+1] - choleskyStart_[iRow] - 1;
           for (CoinBigIndex j = choleskyStart_[iRow] + 1; j < choleskyStart_[iRow+1]; j++) {
@@ -1868,7 +1869,7 @@ ClpCholeskyBase::orderAMD()
      delete [] choleskyRow_;
      choleskyRow_ = temp;
      delete [] choleskyStart_;
-     choleskyStart_ = tempStart;
+     choleskyStart_ = NULL;
      int locaux = sizeFactor + OFFSET;
      delete [] count;
      int speed = integerParameters_[0];
@@ -1883,7 +1884,7 @@ ClpCholeskyBase::orderAMD()
      int * flag = lsize + numberRows_;
      int * erscore;
      for (int i = 0; i < numberRows_; i++) {
-          dgree[i] = choleskyStart_[i+1] - choleskyStart_[i];
+          dgree[i] = tempStart[i+1] - tempStart[i];
           head[i] = dgree[i];
           snxt[i] = 0;
           permute_[i] = 0;
@@ -1900,7 +1901,7 @@ ClpCholeskyBase::orderAMD()
      } else {
           erscore = dgree;
      }
-     myamlf(numberRows_, choleskyStart_, choleskyRow_,
+     myamlf(numberRows_, tempStart, choleskyRow_,
             dgree, varbl, snxt, permute_, permuteInverse_,
             head, lsize, flag, erscore, locaux, space, speed);
      for (int iRow = 0; iRow < numberRows_; iRow++) {
@@ -1915,8 +1916,7 @@ ClpCholeskyBase::orderAMD()
      delete [] use;
      delete [] choleskyRow_;
      choleskyRow_ = NULL;
-     delete [] choleskyStart_;
-     choleskyStart_ = NULL;
+     delete [] tempStart;
      return returnCode;
 }
 /* Does Symbolic factorization given permutation.
@@ -1971,7 +1971,7 @@ ClpCholeskyBase::symbolic()
           delete [] Astart;
           return -1;
      }
-     choleskyStart_ = new int[numberRows_+1];
+     choleskyStart_ = new CoinBigIndex[numberRows_+1];
      link_ = new int[numberRows_];
      workInteger_ = new CoinBigIndex[numberRows_];
      indexStart_ = new CoinBigIndex[numberRows_];
@@ -3564,7 +3564,7 @@ ClpCholeskyBase::factorizePart2(int * rowsDropped)
      return;
 }
 // Updates dense part (broken out for profiling)
-void ClpCholeskyBase::updateDense(longDouble * d, /*longDouble * work,*/ int * first)
+void ClpCholeskyBase::updateDense(longDouble * d, /*longDouble * work,*/ CoinBigIndex * first)
 {
      for (int iRow = 0; iRow < firstDense_; iRow++) {
           CoinBigIndex start = first[iRow];
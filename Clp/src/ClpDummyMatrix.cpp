@@ -161,7 +161,7 @@ void
 ClpDummyMatrix::fillBasis(ClpSimplex * ,
                           const int * ,
                           int & ,
-                          int * , int * ,
+                          int * , CoinBigIndex * ,
                           int * , int * ,
                           CoinFactorizationDouble * )
 {
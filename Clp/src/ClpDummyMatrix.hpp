@@ -70,7 +70,7 @@ public:
      virtual void fillBasis(ClpSimplex * model,
                             const int * whichColumn,
                             int & numberColumnBasic,
-                            int * row, int * start,
+                            int * row, CoinBigIndex * start,
                             int * rowCount, int * columnCount,
                             CoinFactorizationDouble * element);
      /** Unpacks a column into an CoinIndexedvector
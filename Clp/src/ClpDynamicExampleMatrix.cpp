@@ -223,7 +223,7 @@ ClpDynamicExampleMatrix::ClpDynamicExampleMatrix(ClpSimplex * model, int numberS
 ClpDynamicExampleMatrix::ClpDynamicExampleMatrix(ClpSimplex * model, int numberSets,
           int numberGubColumns, int * starts,
           const double * lower, const double * upper,
-          int * startColumn, int * row,
+          CoinBigIndex * startColumn, int * row,
           double * element, double * cost,
           double * columnLower, double * columnUpper,
           const unsigned char * status,
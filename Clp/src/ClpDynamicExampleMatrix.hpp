@@ -65,7 +65,7 @@ public:
      ClpDynamicExampleMatrix(ClpSimplex * model, int numberSets,
                              int numberColumns, const int * starts,
                              const double * lower, const double * upper,
-                             const int * startColumn, const int * row,
+                             const CoinBigIndex * startColumn, const int * row,
                              const double * element, const double * cost,
                              const double * columnLower = NULL, const double * columnUpper = NULL,
                              const unsigned char * status = NULL,
@@ -75,7 +75,7 @@ public:
      ClpDynamicExampleMatrix(ClpSimplex * model, int numberSets,
                              int numberColumns, int * starts,
                              const double * lower, const double * upper,
-                             int * startColumn, int * row,
+                             CoinBigIndex * startColumn, int * row,
                              double * element, double * cost,
                              double * columnLower = NULL, double * columnUpper = NULL,
                              const unsigned char * status = NULL,
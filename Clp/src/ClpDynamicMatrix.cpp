@@ -231,7 +231,7 @@ ClpDynamicMatrix::ClpDynamicMatrix(ClpSimplex * model, int numberSets,
      double guess = numberElements;
      guess /= static_cast<double> (numberColumns);
      guess *= 2 * numberGubInSmall;
-     numberElements_ = static_cast<int> (guess);
+     numberElements_ = static_cast<CoinBigIndex> (guess);
      numberElements_ = CoinMin(numberElements_, numberElements) + originalMatrix->getNumElements();
      matrix_ = originalMatrix;
      //delete originalMatrixA;
@@ -2397,7 +2397,7 @@ ClpDynamicMatrix::writeMps(const char * name)
   int numberTotalRows = numberStaticRows_+numberSets_;
   int numberTotalColumns = firstDynamic_+numberGubColumns_;
   // over estimate
-  int numberElements = getNumElements()+startColumn_[numberGubColumns_]
+  CoinBigIndex numberElements = getNumElements()+startColumn_[numberGubColumns_]
     + numberGubColumns_;
   double * columnLower = new double [numberTotalColumns];
   double * columnUpper = new double [numberTotalColumns];
@@ -2517,7 +2517,7 @@ ClpDynamicMatrix::addColumn(int numberEntries, const int * row, const double * e
           CoinBigIndex j;
           int i;
           int put = 0;
-          int numberElements = 0;
+          CoinBigIndex numberElements = 0;
           CoinBigIndex start = 0;
           // compress - leave ones at ub and basic
           int * which = new int [numberGubColumns_];
@@ -266,7 +266,7 @@ public:
           return numberStaticRows_;
      }
      /// size of working matrix (max)
-     inline int numberElements() const {
+     inline CoinBigIndex numberElements() const {
           return numberElements_;
      }
      inline int * keyVariable() const {
@@ -336,7 +336,7 @@ protected:
      /// number of rows in original model
      int numberStaticRows_;
      /// size of working matrix (max)
-     int numberElements_;
+     CoinBigIndex numberElements_;
      /// Number of dual infeasibilities
      int numberDualInfeasibilities_;
      /// Number of primal infeasibilities
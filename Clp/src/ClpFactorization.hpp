@@ -15,7 +15,12 @@ class ClpSimplex;
 class ClpNetworkBasis;
 class CoinOtherFactorization;
 #ifndef CLP_MULTIPLE_FACTORIZATIONS
+#if COIN_BIG_INDEX==0
 #define CLP_MULTIPLE_FACTORIZATIONS 4
+#else
+// OSL factorization keeps int starts
+#define CLP_MULTIPLE_FACTORIZATIONS 3
+#endif
 #endif
 #ifdef CLP_MULTIPLE_FACTORIZATIONS
 #include "CoinDenseFactorization.hpp"
@@ -166,7 +166,7 @@ ClpGubDynamicMatrix::ClpGubDynamicMatrix(ClpSimplex * model, int numberSets,
      double guess = originalMatrix->getNumElements() + 10;
      guess /= static_cast<double> (numberColumns);
      guess *= 2 * numberGubColumns_;
-     numberElements_ = static_cast<int> (CoinMin(guess, 10000000.0));
+     numberElements_ = static_cast<CoinBigIndex> (CoinMin(guess, 10000000.0));
      numberElements_ = CoinMin(numberElements_, numberElements) + originalMatrix->getNumElements();
      matrix_ = originalMatrix;
      flags_ &= ~1;
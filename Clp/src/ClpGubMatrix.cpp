@@ -971,7 +971,7 @@ void
 ClpGubMatrix::fillBasis(ClpSimplex * model,
                         const int * whichColumn,
                         int & numberColumnBasic,
-                        int * indexRowU, int * start,
+                        int * indexRowU, CoinBigIndex * start,
                         int * rowCount, int * columnCount,
                         CoinFactorizationDouble * elementU)
 {
@@ -1000,7 +1000,7 @@ ClpGubMatrix::fillBasis(ClpSimplex * model,
                int k = keyVariable_[i];
                if (k < numberColumns) {
                     printf("key %d on set %d, %d elements\n", k, i, columnStart[k+1] - columnStart[k]);
-                    for (int j = columnStart[k]; j < columnStart[k+1]; j++)
+                    for (CoinBigIndex j = columnStart[k]; j < columnStart[k+1]; j++)
                          printf("row %d el %g\n", row[j], elementByColumn[j]);
                } else {
                     printf("slack key on set %d\n", i);
@@ -1017,7 +1017,7 @@ ClpGubMatrix::fillBasis(ClpSimplex * model,
                if (0) {
                     int k = iColumn;
                     printf("column %d in set %d, %d elements\n", k, iSet, columnStart[k+1] - columnStart[k]);
-                    for (int j = columnStart[k]; j < columnStart[k+1]; j++)
+                    for (CoinBigIndex j = columnStart[k]; j < columnStart[k+1]; j++)
                          printf("row %d el %g\n", row[j], elementByColumn[j]);
                }
                CoinBigIndex j;
@@ -96,7 +96,7 @@ public:
      virtual void fillBasis(ClpSimplex * model,
                             const int * whichColumn,
                             int & numberColumnBasic,
-                            int * row, int * start,
+                            int * row, CoinBigIndex * start,
                             int * rowCount, int * columnCount,
                             CoinFactorizationDouble * element) = 0;
      /** Creates scales for column copy (rowCopy in model may be modified)
@@ -378,7 +378,7 @@ ClpModel::loadProblem (
 {
      gutsOfLoadModel(numrows, numcols,
                      collb, colub, obj, rowlb, rowub, rowObjective);
-     int numberElements = start ? start[numcols] : 0;
+     CoinBigIndex numberElements = start ? start[numcols] : 0;
      CoinPackedMatrix matrix(true, numrows, numrows ? numcols : 0, numberElements,
                              value, index, start, NULL);
      matrix_ = new ClpPackedMatrix(matrix);
@@ -1666,13 +1666,13 @@ ClpModel::addRows(int number, const double * rowLower,
           int iRow;
           for (iRow = 0; iRow < number; iRow++)
                numberElements += rowLengths[iRow];
-          int * newStarts = new int[number+1];
+          CoinBigIndex * newStarts = new CoinBigIndex[number+1];
           int * newIndex = new int[numberElements];
           double * newElements = new double[numberElements];
           numberElements = 0;
           newStarts[0] = 0;
           for (iRow = 0; iRow < number; iRow++) {
-               int iStart = rowStarts[iRow];
+               CoinBigIndex iStart = rowStarts[iRow];
                int length = rowLengths[iRow];
                CoinMemcpyN(columns + iStart, length, newIndex + numberElements);
                CoinMemcpyN(elements + iStart, length, newElements + numberElements);
@@ -2070,7 +2070,7 @@ void
 ClpModel::addColumns(int number, const double * columnLower,
                      const double * columnUpper,
                      const double * objIn,
-                     const int * columnStarts, const int * rows,
+                     const CoinBigIndex * columnStarts, const int * rows,
                      const double * elements)
 {
      // Create a list of CoinPackedVectors
@@ -2139,7 +2139,7 @@ void
 ClpModel::addColumns(int number, const double * columnLower,
                      const double * columnUpper,
                      const double * objIn,
-                     const int * columnStarts,
+                     const CoinBigIndex * columnStarts,
                      const int * columnLengths, const int * rows,
                      const double * elements)
 {
@@ -2148,13 +2148,13 @@ ClpModel::addColumns(int number, const double * columnLower,
           int iColumn;
           for (iColumn = 0; iColumn < number; iColumn++)
                numberElements += columnLengths[iColumn];
-          int * newStarts = new int[number+1];
+          CoinBigIndex * newStarts = new CoinBigIndex[number+1];
           int * newIndex = new int[numberElements];
           double * newElements = new double[numberElements];
           numberElements = 0;
           newStarts[0] = 0;
           for (iColumn = 0; iColumn < number; iColumn++) {
-               int iStart = columnStarts[iColumn];
+               CoinBigIndex iStart = columnStarts[iColumn];
                int length = columnLengths[iColumn];
                CoinMemcpyN(rows + iStart, length, newIndex + numberElements);
                CoinMemcpyN(elements + iStart, length, newElements + numberElements);
@@ -2748,7 +2748,7 @@ ClpModel::readMps(const char *fileName,
 #ifndef SLIM_CLP
           // get quadratic part
           if (m.reader()->whichSection (  ) == COIN_QUAD_SECTION ) {
-               int * start = NULL;
+               CoinBigIndex * start = NULL;
                int * column = NULL;
                double * element = NULL;
                status = m.readQuadraticMps(NULL, start, column, element, 2);
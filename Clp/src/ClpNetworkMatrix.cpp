@@ -549,7 +549,7 @@ void
 ClpNetworkMatrix::fillBasis(ClpSimplex * /*model*/,
                             const int * whichColumn,
                             int & numberColumnBasic,
-                            int * indexRowU, int * start,
+                            int * indexRowU, CoinBigIndex * start,
                             int * rowCount, int * columnCount,
                             CoinFactorizationDouble * elementU)
 {
@@ -85,7 +85,7 @@ public:
      virtual void fillBasis(ClpSimplex * model,
                             const int * whichColumn,
                             int & numberColumnBasic,
-                            int * row, int * start,
+                            int * row, CoinBigIndex * start,
                             int * rowCount, int * columnCount,
                             CoinFactorizationDouble * element);
      /** Given positive integer weights for each row fills in sum of weights
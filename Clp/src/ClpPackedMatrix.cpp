@@ -2419,7 +2419,7 @@ ClpPackedMatrix::fillBasis(ClpSimplex * model,
                            const int * COIN_RESTRICT whichColumn,
                            int & numberColumnBasic,
                            int * COIN_RESTRICT indexRowU,
-                           int * COIN_RESTRICT start,
+                           CoinBigIndex * COIN_RESTRICT start,
                            int * COIN_RESTRICT rowCount,
                            int * COIN_RESTRICT columnCount,
                            CoinFactorizationDouble * COIN_RESTRICT elementU)
@@ -2598,8 +2598,8 @@ ClpPackedMatrix::scale2(ClpModel * model) const
           CoinBigIndex j;
           char useful = 0;
           bool deleteSome = false;
-          int start = columnStart[iColumn];
-          int end = start + columnLength[iColumn];
+          CoinBigIndex start = columnStart[iColumn];
+          CoinBigIndex end = start + columnLength[iColumn];
 #ifndef LEAVE_FIXED
           if (columnUpper[iColumn] >
                     columnLower[iColumn] + 1.0e-12) {
@@ -3287,8 +3287,8 @@ ClpPackedMatrix::scale(ClpModel * model, const ClpSimplex * /*baseModel*/) const
           CoinBigIndex j;
           char useful = 0;
           bool deleteSome = false;
-          int start = columnStart[iColumn];
-          int end = start + columnLength[iColumn];
+          CoinBigIndex start = columnStart[iColumn];
+          CoinBigIndex end = start + columnLength[iColumn];
 #ifndef LEAVE_FIXED
           if (columnUpper[iColumn] >
                     columnLower[iColumn] + 1.0e-12) {
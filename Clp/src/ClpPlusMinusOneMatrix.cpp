@@ -937,7 +937,7 @@ void
 ClpPlusMinusOneMatrix::fillBasis(ClpSimplex * ,
                                  const int * whichColumn,
                                  int & numberColumnBasic,
-                                 int * indexRowU, int * start,
+                                 int * indexRowU, CoinBigIndex * start,
                                  int * rowCount, int * columnCount,
                                  CoinFactorizationDouble * elementU)
 {
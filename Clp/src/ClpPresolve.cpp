@@ -911,7 +911,7 @@ void ClpPresolve::postsolve(CoinPostsolveMatrix &prob)
           int *hrow		= prob.hrow_;
           CoinBigIndex *mcstrt		= prob.mcstrt_;
           int *hincol		= prob.hincol_;
-          int *link		= prob.link_;
+          CoinBigIndex *link		= prob.link_;
           int ncols		= prob.ncols_;
 
           char *cdone	= prob.cdone_;
@@ -1448,7 +1448,7 @@ CoinPostsolveMatrix::CoinPostsolveMatrix(ClpSimplex*  si,
      free_list_(0),
      // link, free_list, maxlink
      maxlink_(bulk0_),
-     link_(new int[/*maxlink*/ bulk0_]),
+     link_(new CoinBigIndex[/*maxlink*/ bulk0_]),
 
      cdone_(new char[ncols0_]),
      rdone_(new char[nrows0_in])
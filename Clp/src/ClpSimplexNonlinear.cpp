@@ -3432,7 +3432,7 @@ ClpSimplexNonlinear::primalSLP(int numberConstraints, ClpConstraint ** constrain
      if (numberArtificials) {
           numberArtificials *= SEGMENTS;
           numberColumns2 += numberArtificials;
-          int * addStarts = new int [numberArtificials+1];
+          CoinBigIndex * addStarts = new CoinBigIndex [numberArtificials+1];
           int * addRow = new int[numberArtificials];
           double * addElement = new double[numberArtificials];
           double * addUpper = new double[numberArtificials];
@@ -4112,7 +4112,7 @@ ClpSimplexOther::gubVersion(int * whichRows, int * whichColumns,
   double * fixedRow = new double [numberRows];
   for (iRow = 0 ; iRow < numberRows ; iRow++) {
     double sumFixed=0.0;
-    for (int j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
+    for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
       int iColumn = column[j];
       double value = columnLower[iColumn];
       if (value) 
@@ -4125,7 +4125,7 @@ ClpSimplexOther::gubVersion(int * whichRows, int * whichColumns,
     int numberInRow=0;
     double sumFixed=0.0;
     double gap = fixedRow[iRow]-1.0e-12;
-    for (int j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
+    for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
       int iColumn = column[j];
       if (columnIsGub[iColumn]!=-2) {
 	if (element[j] != 1.0||columnIsGub[iColumn]==-3||
@@ -4151,7 +4151,7 @@ ClpSimplexOther::gubVersion(int * whichRows, int * whichColumns,
 	count = numberInRow;
 	smallestGubRow=iRow;
       }
-      for (int j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
+      for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
 	int iColumn = column[j];
 	if (columnIsGub[iColumn]!=-2) 
 	  columnIsGub[iColumn] = iRow;
@@ -4187,7 +4187,7 @@ ClpSimplexOther::gubVersion(int * whichRows, int * whichColumns,
 	<< message << CoinMessageEol;
       rowIsGub[smallestGubRow]=-1;
       whichRows[numberNonGub++] = smallestGubRow;
-      for (int j = rowStart[smallestGubRow]; 
+      for (CoinBigIndex j = rowStart[smallestGubRow]; 
 	   j < rowStart[smallestGubRow] + rowLength[smallestGubRow]; j++) {
 	int iColumn = column[j];
 	if (columnIsGub[iColumn]>=0) {
@@ -4212,7 +4212,7 @@ ClpSimplexOther::gubVersion(int * whichRows, int * whichColumns,
       if (columnIsGub[iColumn] ==-2) {
 	whichColumns[put2++] = iColumn;
 	double value = columnLower[iColumn];
-	for (int j = columnStart[iColumn]; 
+	for (CoinBigIndex j = columnStart[iColumn]; 
 	     j < columnStart[iColumn] + columnLength[iColumn]; j++) {
 	  int iRow = row[j];
 	  if (lower[iRow]>-1.0e20)
@@ -4232,7 +4232,7 @@ ClpSimplexOther::gubVersion(int * whichRows, int * whichColumns,
       if (rowIsGub[i]==-1) {
 	double largest = 1.0e-30;
 	double smallest = 1.0e30;
-	for (int j = rowStart[i]; j < rowStart[i] + rowLength[i]; j++) {
+	for (CoinBigIndex j = rowStart[i]; j < rowStart[i] + rowLength[i]; j++) {
 	  int iColumn = column[j];
 	  if (columnIsGub[iColumn]!=-2) {
 	    double value =fabs(element[j]);
@@ -4256,7 +4256,7 @@ ClpSimplexOther::gubVersion(int * whichRows, int * whichColumns,
       const CoinBigIndex * columnStart = matrix->getVectorStarts();
       double * element = matrix->getMutableElements();
       for (int i=0;i<numberNormal;i++) {
-	for (int j = columnStart[i]; 
+	for (CoinBigIndex j = columnStart[i]; 
 	     j < columnStart[i] + columnLength[i]; j++) {
 	  int iRow = row[j];
 	  iRow = whichRows[iRow];
@@ -4316,7 +4316,7 @@ ClpSimplexOther::gubVersion(int * whichRows, int * whichColumns,
     CoinFillN(lowerColumn2, numberGubColumnsPlus, 0.0);
     double * upperColumn2 = new double [numberGubColumnsPlus];
     CoinFillN(upperColumn2, numberGubColumnsPlus, COIN_DBL_MAX);
-    int * start2 = new int[numberGubColumnsPlus+1];
+    CoinBigIndex * start2 = new CoinBigIndex[numberGubColumnsPlus+1];
     int * row2 = new int[numberElements];
     double * element2 = new double[numberElements];
     double * cost2 = new double [numberGubColumnsPlus];
@@ -4360,7 +4360,7 @@ ClpSimplexOther::gubVersion(int * whichRows, int * whichColumns,
 	lowerColumn2[i] = columnLower[iColumn];
 	upperColumn2[i] = columnUpper[iColumn];
 	upperColumn2[i] = COIN_DBL_MAX; 
-	for (int j = columnStart[iColumn]; j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+	for (CoinBigIndex j = columnStart[iColumn]; j < columnStart[iColumn] + columnLength[iColumn]; j++) {
 	  int iRow = row[j];
 	  double scaleBy = scaleArray[iRow];
 	  iRow = rowIsGub[iRow];
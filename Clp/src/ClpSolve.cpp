@@ -1504,7 +1504,7 @@ ClpSimplex::initialSolve(ClpSolve & options)
                network = true;
                nRow *= 2;
           }
-          int * addStarts = new int [nRow+1];
+          CoinBigIndex * addStarts = new CoinBigIndex [nRow+1];
           int * addRow = new int[nRow];
           double * addElement = new double[nRow];
           addStarts[0] = 0;
@@ -3890,7 +3890,7 @@ ClpSimplex::solveDW(CoinStructuredModel * model)
      int * rowAdd = new int[spaceNeeded];
      double * elementAdd = new double[spaceNeeded];
      spaceNeeded = numberBlocks;
-     int * columnAdd = new int[spaceNeeded+1];
+     CoinBigIndex * columnAdd = new CoinBigIndex[spaceNeeded+1];
      double * objective = new double[spaceNeeded];
      // Add in costed slacks
      int firstArtificial = master.numberColumns();
@@ -3913,7 +3913,7 @@ ClpSimplex::solveDW(CoinStructuredModel * model)
                spaceNeeded = kCol;
                delete [] columnAdd;
                delete [] objective;
-               columnAdd = new int[spaceNeeded+1];
+               columnAdd = new CoinBigIndex[spaceNeeded+1];
                objective = new double[spaceNeeded];
           }
           for (int i = 0; i < kCol; i++) {
@@ -4532,7 +4532,7 @@ ClpSimplex::solveBenders(CoinStructuredModel * model)
      int * columnAdd = new int[spaceNeeded];
      double * elementAdd = new double[spaceNeeded];
      spaceNeeded = numberBlocks;
-     int * rowAdd = new int[spaceNeeded+1];
+     CoinBigIndex * rowAdd = new CoinBigIndex[spaceNeeded+1];
      double * objective = new double[spaceNeeded];
      int maxPass = 500;
      int iPass;
@@ -4556,15 +4556,16 @@ ClpSimplex::solveBenders(CoinStructuredModel * model)
      // Add extra variables
      {
           int iBlock;
-          columnAdd[0] = 0;
+          rowAdd[0] = 0;
           for (iBlock = 0; iBlock < numberBlocks; iBlock++) {
                objective[iBlock] = 1.0;
-               columnAdd[iBlock+1] = 0;
+               rowAdd[iBlock+1] = 0;
                when[iBlock] = -1;
                whichBlock[iBlock] = iBlock;
           }
+          // empty columns
           master.addColumns(numberBlocks, NULL, NULL, objective,
-                            columnAdd, rowAdd, elementAdd);
+                            rowAdd, columnAdd, elementAdd);
      }
      std::cout << "Time to decompose " << CoinCpuTime() - time1 << " seconds" << std::endl;
      for (iPass = 0; iPass < maxPass; iPass++) {
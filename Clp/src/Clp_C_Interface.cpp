@@ -298,7 +298,7 @@ Clp_deleteRows(Clp_Simplex * model, int number, const int * which)
 COINLIBAPI void COINLINKAGE
 Clp_addRows(Clp_Simplex * model, int number, const double * rowLower,
             const double * rowUpper,
-            const int * rowStarts, const int * columns,
+            const CoinBigIndex * rowStarts, const int * columns,
             const double * elements)
 {
      model->model_->addRows(number, rowLower, rowUpper, rowStarts, columns, elements);
@@ -315,7 +315,7 @@ COINLIBAPI void COINLINKAGE
 Clp_addColumns(Clp_Simplex * model, int number, const double * columnLower,
                const double * columnUpper,
                const double * objective,
-               const int * columnStarts, const int * rows,
+               const CoinBigIndex * columnStarts, const int * rows,
                const double * elements)
 {
      model->model_->addColumns(number, columnLower, columnUpper, objective,
@@ -80,7 +80,7 @@ extern "C" {
      /** Add rows */
      COINLIBAPI void COINLINKAGE Clp_addRows(Clp_Simplex * model, int number, const double * rowLower,
                                              const double * rowUpper,
-                                             const int * rowStarts, const int * columns,
+                                             const CoinBigIndex * rowStarts, const int * columns,
                                              const double * elements);
 
      /** Deletes columns */
@@ -89,7 +89,7 @@ extern "C" {
      COINLIBAPI void COINLINKAGE Clp_addColumns(Clp_Simplex * model, int number, const double * columnLower,
                const double * columnUpper,
                const double * objective,
-               const int * columnStarts, const int * rows,
+               const CoinBigIndex * columnStarts, const int * rows,
                const double * elements);
      /** Change row lower bounds */
      COINLIBAPI void COINLINKAGE Clp_chgRowLower(Clp_Simplex * model, const double * rowLower);
@@ -3166,7 +3166,7 @@ OsiClpSolverInterface::addCols(const int numcols,
 }
 void 
 OsiClpSolverInterface::addCols(const int numcols,
-			       const int * columnStarts, const int * rows, const double * elements,
+			       const CoinBigIndex * columnStarts, const int * rows, const double * elements,
 			       const double* collb, const double* colub,   
 			       const double* obj)
 {
@@ -3394,7 +3394,7 @@ OsiClpSolverInterface::addRows(const int numrows,
 }
 void 
 OsiClpSolverInterface::addRows(const int numrows,
-			       const int * rowStarts, const int * columns, const double * element,
+			       const CoinBigIndex * rowStarts, const int * columns, const double * element,
 			       const double* rowlb, const double* rowub)
 {
   modelPtr_->whatsChanged_ &= (0xffff&~(1|2|4|16|32));
@@ -4856,7 +4856,7 @@ OsiClpSolverInterface::readMps(const char *filename,bool keepNames,bool allowErr
     int nCols=m.getNumCols();
     // get quadratic part
     if (m.reader()->whichSection (  ) == COIN_QUAD_SECTION ) {
-      int * start=NULL;
+      CoinBigIndex * start=NULL;
       int * column = NULL;
       double * element = NULL;
       int status=m.readQuadraticMps(NULL,start,column,element,2);
@@ -1949,8 +1949,8 @@ ClpSimplexUnitTest(const std::string & dirSample)
                double * saveUpper = new double[numberRows+numberColumns];
                int * which = new int [numberRows+numberColumns];
 
-               int numberElements = m.getMatrixByCol()->getNumElements();
-               int * starts = new int[numberRows+numberColumns];
+               CoinBigIndex numberElements = m.getMatrixByCol()->getNumElements();
+               CoinBigIndex * starts = new CoinBigIndex[numberRows+numberColumns];
                int * index = new int[numberElements];
                double * element = new double[numberElements];
 
@@ -2319,7 +2319,7 @@ ClpSimplexUnitTest(const std::string & dirSample)
                //solution.dual();
                // get quadratic part
                int numberColumns = solution.numberColumns();
-               int * start = new int [numberColumns+1];
+               CoinBigIndex * start = new CoinBigIndex [numberColumns+1];
                int * column = new int[numberColumns];
                double * element = new double[numberColumns];
                int i;
@@ -2367,13 +2367,13 @@ ClpSimplexUnitTest(const std::string & dirSample)
                                  m.getRowLower(), m.getRowUpper());
                model.dual();
                // get quadratic part
-               int * start = NULL;
+               CoinBigIndex * start = NULL;
                int * column = NULL;
                double * element = NULL;
                m.readQuadraticMps(NULL, start, column, element, 2);
                int column2[200];
                double element2[200];
-               int start2[80];
+               CoinBigIndex start2[80];
                int j;
                start2[0] = 0;
                int nel = 0;
@@ -2445,7 +2445,7 @@ ClpSimplexUnitTest(const std::string & dirSample)
                solution.setDblParam(ClpObjOffset, m.objectiveOffset());
                solution.dual();
                // get quadratic part
-               int * start = NULL;
+               CoinBigIndex * start = NULL;
                int * column = NULL;
                double * element = NULL;
                m.readQuadraticMps(NULL, start, column, element, 2);
@@ -6,12 +6,80 @@
 #include "CoinPragma.hpp"
 
 #include <iostream>
+#include <cstdlib>
+#include <cmath>
 
 #include "OsiUnitTests.hpp"
 #include "OsiClpSolverInterface.hpp"
 
 using namespace OsiUnitTest;
 
+/*
+  Generates and solves
+
+    min  -x[0] - ... - x[n-2] - 2 x[n-1]
+    s.t.  x[0] + ... + x[n-1] <= i+1  for rows i = 0, ..., numberRows-1
+          x >= 0
+
+  with every column in every row, so the elements of the last column come
+  after numberElements-numberRows others.  The optimum is x[n-1] = 1 with
+  objective -2.
+*/
+static void testBigIndex (CoinBigIndex numberElements)
+{
+  const int numberRows = 1024;
+  const int numberColumns =
+    static_cast<int>((numberElements+numberRows-1)/numberRows);
+  numberElements = static_cast<CoinBigIndex>(numberColumns)*numberRows;
+  double * element = new double [numberElements];
+  int * row = new int [numberElements];
+  CoinBigIndex * start = new CoinBigIndex [numberColumns+1];
+  int * length = new int [numberColumns];
+  CoinBigIndex put = 0;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    start[iColumn] = put;
+    length[iColumn] = numberRows;
+    for (int iRow = 0; iRow < numberRows; iRow++) {
+      row[put] = iRow;
+      element[put++] = 1.0;
+    }
+  }
+  start[numberColumns] = put;
+  CoinPackedMatrix * matrix = new CoinPackedMatrix();
+  matrix->assignMatrix(true, numberRows, numberColumns, numberElements,
+                       element, row, start, length);
+  double * columnLower = new double [numberColumns];
+  double * columnUpper = new double [numberColumns];
+  double * objective = new double [numberColumns];
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    columnLower[iColumn] = 0.0;
+    columnUpper[iColumn] = COIN_DBL_MAX;
+    objective[iColumn] = -1.0;
+  }
+  objective[numberColumns-1] = -2.0;
+  double * rowLower = new double [numberRows];
+  double * rowUpper = new double [numberRows];
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    rowLower[iRow] = -COIN_DBL_MAX;
+    rowUpper[iRow] = iRow+1.0;
+  }
+
+  OsiClpSolverInterface si;
+  si.setHintParam(OsiDoReducePrint, true, OsiHintDo);
+  // presolve would remove everything - solve the full matrix
+  si.setHintParam(OsiDoPresolveInInitial, false, OsiHintDo);
+  // takes over the arrays
+  si.assignProblem(matrix, columnLower, columnUpper, objective,
+                   rowLower, rowUpper);
+  OSIUNITTEST_ASSERT_ERROR(si.getNumElements() == numberElements, return, "clp", "big index: number of elements");
+  const CoinPackedMatrix * byColumn = si.getMatrixByCol();
+  OSIUNITTEST_ASSERT_ERROR(byColumn->getVectorStarts()[numberColumns] == numberElements, return, "clp", "big index: column starts");
+  si.initialSolve();
+  OSIUNITTEST_ASSERT_ERROR(si.isProvenOptimal(), return, "clp", "big index: solve");
+  OSIUNITTEST_ASSERT_ERROR(fabs(si.getObjValue()+2.0) < 1.0e-7, {}, "clp", "big index: objective");
+  OSIUNITTEST_ASSERT_ERROR(fabs(si.getColSolution()[numberColumns-1]-1.0) < 1.0e-7, {}, "clp", "big index: solution");
+}
+
 //----------------------------------------------------------------
 // to see parameter list, call unitTest -usage
 //----------------------------------------------------------------
@@ -85,6 +153,28 @@ int main (int argc, const char *argv[])
   else
     testingMessage( "***Skipped Testing of OsiClpSolverInterface on Netlib problems, use -testOsiSolverInterface to run them.***\n" );
 
+  /*
+    More elements than an int can count.  This needs a 64 bit CoinBigIndex
+    (configure --enable-coinutils-bigindex) and well over 50 GB of memory,
+    so it is only run on request.  A smaller count may be given for a quick
+    check of the same code.
+  */
+  if (parms.find("-testBigIndex") != parms.end())
+  {
+    double numberElements = COIN_INT_MAX_AS_DOUBLE+1025.0;
+    if (!parms["-testBigIndex"].empty())
+      numberElements = atof(parms["-testBigIndex"].c_str());
+    if (numberElements > COIN_INT_MAX_AS_DOUBLE-1024.0 &&
+        sizeof(CoinBigIndex) == sizeof(int)) {
+      testingMessage( "***Skipped Testing of OsiClpSolverInterface with more than 2^31 elements, CoinBigIndex is 32 bit.***\n" );
+    } else {
+      testingMessage( "Testing OsiClpSolverInterface on a generated problem with many elements.\n" );
+      OSIUNITTEST_CATCH_ERROR(testBigIndex(static_cast<CoinBigIndex>(numberElements)), {}, "clp", "big index unittest");
+    }
+  }
+  else
+    testingMessage( "***Skipped Testing of OsiClpSolverInterface with more than 2^31 elements, use -testBigIndex to run it.***\n" );
+
   /*
     We're done. Report on the results.
    */
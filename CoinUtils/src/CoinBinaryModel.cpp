@@ -0,0 +1,524 @@
+/* $Id$ */
+// Copyright (C) 2012, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <algorithm>
+#include <limits>
+
+#include "CoinBinaryModel.hpp"
+#include "CoinError.hpp"
+#include "CoinFileIO.hpp"
+#include "CoinFinite.hpp"
+#include "CoinPackedMatrix.hpp"
+
+namespace {
+
+  /* Layout of a file: a header, then the sections, each starting on a
+     multiple of alignment.  All header fields are 8 bytes.  A new version
+     may only add sections at the end. */
+  const char magic[8] = {'C','O','I','N','B','I','N','\0'};
+  const CoinInt64 version = 1;
+  const CoinInt64 byteOrder = 0x0102030405060708LL;
+  const CoinInt64 alignment = 64;
+
+  enum Section {
+    startsSection = 0,
+    indicesSection,
+    elementsSection,
+    columnLowerSection,
+    columnUpperSection,
+    objectiveSection,
+    rowLowerSection,
+    rowUpperSection,
+    integerSection,
+    rowNameStartsSection,
+    rowNamesSection,
+    columnNameStartsSection,
+    columnNamesSection,
+    problemNameSection,
+    objectiveNameSection,
+    numberSections
+  };
+
+  struct Header {
+    char magic[8];
+    CoinInt64 version;
+    CoinInt64 byteOrder;
+    CoinInt64 bigIndexSize;
+    CoinInt64 numberRows;
+    CoinInt64 numberColumns;
+    CoinInt64 numberElements;
+    double objectiveOffset;
+    CoinInt64 numberSections;
+    // followed by offset and length in bytes of each section
+  };
+
+  inline CoinInt64 aligned (CoinInt64 offset)
+  {
+    return (offset + alignment - 1) / alignment * alignment;
+  }
+
+  // Pads a section of bytes up to the next aligned offset
+  bool padSection (FILE *fp, CoinInt64 bytes)
+  {
+    static const char zeros[alignment] = {0};
+    size_t pad = static_cast<size_t>(aligned (bytes) - bytes);
+    return !pad || fwrite (zeros, 1, pad, fp) == pad;
+  }
+
+  bool writeSection (FILE *fp, const void *data, CoinInt64 bytes)
+  {
+    if (bytes &&
+        fwrite (data, 1, static_cast<size_t>(bytes), fp) !=
+        static_cast<size_t>(bytes))
+      return false;
+    return padSection (fp, bytes);
+  }
+
+  /* Writes n values, value where values is NULL, with anything beyond
+     infinity as COIN_DBL_MAX */
+  bool writeValues (FILE *fp, const double *values, int n, double value,
+                    double infinity)
+  {
+    const int blockSize = 4096;
+    double block[blockSize];
+    for (int start = 0; start < n; start += blockSize) {
+      int size = std::min (blockSize, n - start);
+      for (int i = 0; i < size; i++) {
+        double x = values ? values[start+i] : value;
+        if (x >= infinity)
+          x = COIN_DBL_MAX;
+        else if (x <= -infinity)
+          x = -COIN_DBL_MAX;
+        block[i] = x;
+      }
+      if (fwrite (block, sizeof(double), size, fp) !=
+          static_cast<size_t>(size))
+        return false;
+    }
+    return padSection (fp, static_cast<CoinInt64>(n) * sizeof(double));
+  }
+
+  // Offsets of names, all NUL terminated; bytes of names is last offset
+  void nameStarts (const char *const *names, int number,
+                   std::vector<CoinInt64> &starts)
+  {
+    starts.resize (number + 1);
+    starts[0] = 0;
+    for (int i = 0; i < number; i++)
+      starts[i+1] = starts[i] + strlen (names[i]) + 1;
+  }
+
+  bool writeNames (FILE *fp, const char *const *names, int number)
+  {
+    CoinInt64 bytes = 0;
+    for (int i = 0; i < number; i++) {
+      size_t length = strlen (names[i]) + 1;
+      if (fwrite (names[i], 1, length, fp) != length)
+        return false;
+      bytes += length;
+    }
+    return padSection (fp, bytes);
+  }
+}
+
+CoinBinaryModel::CoinBinaryModel ()
+  : input_(0)
+{
+  clear ();
+}
+
+CoinBinaryModel::~CoinBinaryModel ()
+{
+  delete input_;
+}
+
+void CoinBinaryModel::clear ()
+{
+  delete input_;
+  input_ = 0;
+  std::vector<double>().swap (buffer_);
+  std::vector<CoinBigIndex>().swap (convertedStarts_);
+  numberRows_ = 0;
+  numberColumns_ = 0;
+  numberElements_ = 0;
+  starts_ = 0;
+  indices_ = 0;
+  elements_ = 0;
+  columnLower_ = 0;
+  columnUpper_ = 0;
+  objective_ = 0;
+  rowLower_ = 0;
+  rowUpper_ = 0;
+  integerType_ = 0;
+  rowNameStarts_ = 0;
+  rowNames_ = 0;
+  columnNameStarts_ = 0;
+  columnNames_ = 0;
+  problemName_ = "";
+  objectiveName_ = "";
+  objectiveOffset_ = 0.0;
+}
+
+int CoinBinaryModel::write (const char *filename,
+                            const CoinPackedMatrix &matrix, double infinity,
+                            const double *collb, const double *colub,
+                            const double *obj,
+                            const double *rowlb, const double *rowub,
+                            const char *integerType,
+                            const char *const *rowNames,
+                            const char *const *columnNames,
+                            const char *problemName,
+                            const char *objectiveName,
+                            double objectiveOffset)
+{
+  // column ordered without gaps, copy only if needed
+  const CoinPackedMatrix *columnMatrix = &matrix;
+  CoinPackedMatrix copy;
+  if (!matrix.isColOrdered ()) {
+    copy.reverseOrderedCopyOf (matrix);
+    columnMatrix = &copy;
+  } else if (matrix.hasGaps ()) {
+    copy = matrix;
+    copy.removeGaps ();
+    columnMatrix = &copy;
+  }
+  const int numberRows = columnMatrix->getNumRows ();
+  const int numberColumns = columnMatrix->getNumCols ();
+  const CoinBigIndex numberElements = columnMatrix->getNumElements ();
+  // an empty matrix may have no starts
+  const CoinBigIndex zero = 0;
+  const CoinBigIndex *columnStart = columnMatrix->getVectorStarts ();
+  if (!columnStart)
+    columnStart = &zero;
+  if (!problemName)
+    problemName = "";
+  if (!objectiveName)
+    objectiveName = "";
+  bool anyInteger = false;
+  if (integerType) {
+    for (int i = 0; i < numberColumns; i++) {
+      if (integerType[i]) {
+        anyInteger = true;
+        break;
+      }
+    }
+  }
+  std::vector<CoinInt64> rowStarts;
+  if (rowNames)
+    nameStarts (rowNames, numberRows, rowStarts);
+  std::vector<CoinInt64> columnStarts;
+  if (columnNames)
+    nameStarts (columnNames, numberColumns, columnStarts);
+
+  CoinInt64 bytes[numberSections];
+  bytes[startsSection] = static_cast<CoinInt64>(numberColumns + 1) *
+    sizeof(CoinBigIndex);
+  bytes[indicesSection] =
+    static_cast<CoinInt64>(numberElements) * sizeof(int);
+  bytes[elementsSection] =
+    static_cast<CoinInt64>(numberElements) * sizeof(double);
+  bytes[columnLowerSection] =
+    static_cast<CoinInt64>(numberColumns) * sizeof(double);
+  bytes[columnUpperSection] = bytes[columnLowerSection];
+  bytes[objectiveSection] = bytes[columnLowerSection];
+  bytes[rowLowerSection] =
+    static_cast<CoinInt64>(numberRows) * sizeof(double);
+  bytes[rowUpperSection] = bytes[rowLowerSection];
+  bytes[integerSection] = anyInteger ? numberColumns : 0;
+  bytes[rowNameStartsSection] = rowNames ?
+    static_cast<CoinInt64>(numberRows + 1) * sizeof(CoinInt64) : 0;
+  bytes[rowNamesSection] = rowNames ? rowStarts[numberRows] : 0;
+  bytes[columnNameStartsSection] = columnNames ?
+    static_cast<CoinInt64>(numberColumns + 1) * sizeof(CoinInt64) : 0;
+  bytes[columnNamesSection] = columnNames ? columnStarts[numberColumns] : 0;
+  bytes[problemNameSection] = strlen (problemName) + 1;
+  bytes[objectiveNameSection] = strlen (objectiveName) + 1;
+
+  Header header;
+  memcpy (header.magic, magic, sizeof(magic));
+  header.version = version;
+  header.byteOrder = byteOrder;
+  header.bigIndexSize = sizeof(CoinBigIndex);
+  header.numberRows = numberRows;
+  header.numberColumns = numberColumns;
+  header.numberElements = numberElements;
+  header.objectiveOffset = objectiveOffset;
+  header.numberSections = numberSections;
+  CoinInt64 sections[2*numberSections];
+  CoinInt64 offset = aligned (sizeof(Header) + sizeof(sections));
+  for (int i = 0; i < numberSections; i++) {
+    sections[2*i] = offset;
+    sections[2*i+1] = bytes[i];
+    offset += aligned (bytes[i]);
+  }
+
+  FILE *fp = fopen (filename, "wb");
+  if (!fp)
+    return -1;
+  // header and section table, padded
+  std::vector<char> head (static_cast<size_t>(sections[0]), 0);
+  memcpy (&head[0], &header, sizeof(Header));
+  memcpy (&head[sizeof(Header)], sections, sizeof(sections));
+  bool ok = fwrite (&head[0], 1, head.size (), fp) == head.size ();
+  ok = ok &&
+    writeSection (fp, columnStart, bytes[startsSection]) &&
+    writeSection (fp, columnMatrix->getIndices (), bytes[indicesSection]) &&
+    writeSection (fp, columnMatrix->getElements (), bytes[elementsSection]) &&
+    writeValues (fp, collb, numberColumns, 0.0, infinity) &&
+    writeValues (fp, colub, numberColumns, COIN_DBL_MAX, infinity) &&
+    writeValues (fp, obj, numberColumns, 0.0, COIN_DBL_MAX) &&
+    writeValues (fp, rowlb, numberRows, -COIN_DBL_MAX, infinity) &&
+    writeValues (fp, rowub, numberRows, COIN_DBL_MAX, infinity) &&
+    writeSection (fp, integerType, bytes[integerSection]) &&
+    writeSection (fp, rowNames ? &rowStarts[0] : 0,
+                  bytes[rowNameStartsSection]) &&
+    (!rowNames || writeNames (fp, rowNames, numberRows)) &&
+    writeSection (fp, columnNames ? &columnStarts[0] : 0,
+                  bytes[columnNameStartsSection]) &&
+    (!columnNames || writeNames (fp, columnNames, numberColumns)) &&
+    writeSection (fp, problemName, bytes[problemNameSection]) &&
+    writeSection (fp, objectiveName, bytes[objectiveNameSection]);
+  if (fclose (fp))
+    ok = false;
+  return ok ? 0 : -1;
+}
+
+int CoinBinaryModel::read (const char *filename)
+{
+  clear ();
+  std::string name = filename;
+  if (!fileCoinReadable (name))
+    return -1;
+  CoinFileInput *input = 0;
+  try {
+    input = CoinFileInput::create (name);
+  }
+  catch (CoinError &) {
+    return -1;
+  }
+  const char *begin = 0;
+  CoinInt64 size = 0;
+  if (input->getReadType () == "plain") {
+    // use the file as it is
+    CoinMappedFileInput *mapped = CoinMappedFileInput::map (name);
+    if (mapped) {
+      delete input;
+      input = mapped;
+      begin = mapped->position ();
+      size = mapped->end () - begin;
+    }
+  }
+  if (!begin) {
+    // compressed or no mmap - read in blocks of doubles to keep alignment
+    const int blockSize = 1 << 20;
+    while (true) {
+      size_t used = static_cast<size_t>((size + 7) / 8);
+      buffer_.resize (used + blockSize);
+      int n = input->read (&buffer_[used], blockSize * sizeof(double));
+      if (n <= 0)
+        break;
+      size += n;
+    }
+    delete input;
+    input = 0;
+    begin = reinterpret_cast<const char *>(&buffer_[0]);
+  }
+  input_ = input;
+
+  Header header;
+  if (size < static_cast<CoinInt64>(sizeof(Header))) {
+    clear ();
+    return -2;
+  }
+  memcpy (&header, begin, sizeof(Header));
+  if (memcmp (header.magic, magic, sizeof(magic)) ||
+      header.byteOrder != byteOrder || header.version < 1 ||
+      header.numberSections < 0 ||
+      (header.bigIndexSize != 4 && header.bigIndexSize != 8) ||
+      header.numberRows < 0 || header.numberColumns < 0 ||
+      header.numberElements < 0 ||
+      header.numberRows > std::numeric_limits<int>::max () ||
+      header.numberColumns >= std::numeric_limits<int>::max () ||
+      header.numberSections >
+      (size - static_cast<CoinInt64>(sizeof(Header))) /
+      static_cast<CoinInt64>(2 * sizeof(CoinInt64))) {
+    clear ();
+    return -2;
+  }
+  if (header.numberElements > std::numeric_limits<CoinBigIndex>::max ()) {
+    clear ();
+    return -3;
+  }
+  numberRows_ = static_cast<int>(header.numberRows);
+  numberColumns_ = static_cast<int>(header.numberColumns);
+  numberElements_ = static_cast<CoinBigIndex>(header.numberElements);
+  objectiveOffset_ = header.objectiveOffset;
+  const CoinInt64 numberRows = header.numberRows;
+  const CoinInt64 numberColumns = header.numberColumns;
+  const CoinInt64 numberElements = header.numberElements;
+
+  // where each section is, sections unknown to this version are ignored
+  const char *data[numberSections];
+  CoinInt64 bytes[numberSections];
+  CoinInt64 sections[2*numberSections];
+  const CoinInt64 ourSections = numberSections;
+  int known = static_cast<int>(std::min (header.numberSections, ourSections));
+  memcpy (sections, begin + sizeof(Header), known * 2 * sizeof(CoinInt64));
+  for (int i = 0; i < numberSections; i++) {
+    data[i] = 0;
+    bytes[i] = 0;
+    if (i < known) {
+      CoinInt64 offset = sections[2*i];
+      bytes[i] = sections[2*i+1];
+      if (offset < 0 || offset % sizeof(double) || bytes[i] < 0 ||
+          offset > size || bytes[i] > size - offset) {
+        clear ();
+        return -2;
+      }
+      data[i] = begin + offset;
+    }
+  }
+  // all arrays of the matrix and bounds must be there
+  if (bytes[startsSection] != (numberColumns + 1) * header.bigIndexSize ||
+      bytes[indicesSection] !=
+      numberElements * static_cast<CoinInt64>(sizeof(int)) ||
+      bytes[elementsSection] !=
+      numberElements * static_cast<CoinInt64>(sizeof(double)) ||
+      bytes[columnLowerSection] != numberColumns * 8 ||
+      bytes[columnUpperSection] != numberColumns * 8 ||
+      bytes[objectiveSection] != numberColumns * 8 ||
+      bytes[rowLowerSection] != numberRows * 8 ||
+      bytes[rowUpperSection] != numberRows * 8 ||
+      (bytes[integerSection] && bytes[integerSection] != numberColumns) ||
+      (bytes[rowNameStartsSection] &&
+       bytes[rowNameStartsSection] != (numberRows + 1) * 8) ||
+      (bytes[columnNameStartsSection] &&
+       bytes[columnNameStartsSection] != (numberColumns + 1) * 8)) {
+    clear ();
+    return -2;
+  }
+  if (header.bigIndexSize == static_cast<CoinInt64>(sizeof(CoinBigIndex))) {
+    starts_ = reinterpret_cast<const CoinBigIndex *>(data[startsSection]);
+  } else {
+    // written with another CoinBigIndex
+    convertedStarts_.resize (static_cast<size_t>(numberColumns + 1));
+    if (header.bigIndexSize == 4) {
+      const int *starts = reinterpret_cast<const int *>(data[startsSection]);
+      std::copy (starts, starts + numberColumns + 1, convertedStarts_.begin ());
+    } else {
+      const CoinInt64 *starts =
+        reinterpret_cast<const CoinInt64 *>(data[startsSection]);
+      for (CoinInt64 i = 0; i <= numberColumns; i++)
+        convertedStarts_[i] = static_cast<CoinBigIndex>(starts[i]);
+    }
+    starts_ = &convertedStarts_[0];
+  }
+  if (starts_[0] != 0 || starts_[numberColumns_] != numberElements_) {
+    clear ();
+    return -2;
+  }
+  // one pass over the matrix, so no column or row lies outside it
+  for (int i = 0; i < numberColumns_; i++) {
+    if (starts_[i+1] < starts_[i]) {
+      clear ();
+      return -2;
+    }
+  }
+  indices_ = reinterpret_cast<const int *>(data[indicesSection]);
+  for (CoinBigIndex j = 0; j < numberElements_; j++) {
+    if (indices_[j] < 0 || indices_[j] >= numberRows_) {
+      clear ();
+      return -2;
+    }
+  }
+  elements_ = reinterpret_cast<const double *>(data[elementsSection]);
+  columnLower_ = reinterpret_cast<const double *>(data[columnLowerSection]);
+  columnUpper_ = reinterpret_cast<const double *>(data[columnUpperSection]);
+  objective_ = reinterpret_cast<const double *>(data[objectiveSection]);
+  rowLower_ = reinterpret_cast<const double *>(data[rowLowerSection]);
+  rowUpper_ = reinterpret_cast<const double *>(data[rowUpperSection]);
+  if (bytes[integerSection])
+    integerType_ = data[integerSection];
+  // names must start and end inside their section
+  if (bytes[rowNameStartsSection]) {
+    rowNameStarts_ =
+      reinterpret_cast<const CoinInt64 *>(data[rowNameStartsSection]);
+    rowNames_ = data[rowNamesSection];
+    CoinInt64 last = rowNameStarts_[numberRows];
+    bool inside = last == bytes[rowNamesSection] &&
+      (!last || !rowNames_[last-1]);
+    for (int i = 0; i < numberRows_ && inside; i++)
+      inside = rowNameStarts_[i] >= 0 && rowNameStarts_[i] < last;
+    if (!inside) {
+      clear ();
+      return -2;
+    }
+  }
+  if (bytes[columnNameStartsSection]) {
+    columnNameStarts_ =
+      reinterpret_cast<const CoinInt64 *>(data[columnNameStartsSection]);
+    columnNames_ = data[columnNamesSection];
+    CoinInt64 last = columnNameStarts_[numberColumns];
+    bool inside = last == bytes[columnNamesSection] &&
+      (!last || !columnNames_[last-1]);
+    for (int i = 0; i < numberColumns_ && inside; i++)
+      inside = columnNameStarts_[i] >= 0 && columnNameStarts_[i] < last;
+    if (!inside) {
+      clear ();
+      return -2;
+    }
+  }
+  if (bytes[problemNameSection] &&
+      !data[problemNameSection][bytes[problemNameSection]-1])
+    problemName_ = data[problemNameSection];
+  if (bytes[objectiveNameSection] &&
+      !data[objectiveNameSection][bytes[objectiveNameSection]-1])
+    objectiveName_ = data[objectiveNameSection];
+  return 0;
+}
+
+bool CoinBinaryModel::isBinary (const char *filename)
+{
+  std::string name = filename;
+  if (name == "stdin" || !fileCoinReadable (name))
+    return false;
+  char start[sizeof(magic)];
+  int n = 0;
+  try {
+    CoinFileInput *input = CoinFileInput::create (name);
+    n = input->read (start, sizeof(magic));
+    delete input;
+  }
+  catch (CoinError &) {
+    return false;
+  }
+  return n == static_cast<int>(sizeof(magic)) &&
+    !memcmp (start, magic, sizeof(magic));
+}
+
+const char *CoinBinaryModel::rowName (int index) const
+{
+  if (!rowNameStarts_ || index < 0 || index >= numberRows_)
+    return 0;
+  return rowNames_ + rowNameStarts_[index];
+}
+
+const char *CoinBinaryModel::columnName (int index) const
+{
+  if (!columnNameStarts_ || index < 0 || index >= numberColumns_)
+    return 0;
+  return columnNames_ + columnNameStarts_[index];
+}
+
+CoinPackedMatrix *CoinBinaryModel::createMatrix () const
+{
+  return new CoinPackedMatrix (true, numberRows_, numberColumns_,
+                               numberElements_, elements_, indices_,
+                               starts_, 0);
+}
@@ -0,0 +1,150 @@
+/* $Id$ */
+// Copyright (C) 2012, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinBinaryModel_H
+#define CoinBinaryModel_H
+
+#include <vector>
+
+#include "CoinUtilsConfig.h"
+#include "CoinTypes.hpp"
+
+class CoinFileInput;
+class CoinPackedMatrix;
+
+/** Binary image of a linear or integer model.
+
+    The file holds the arrays of a column ordered CoinPackedMatrix without
+    gaps (starts, indices, elements), the bounds, the objective, the
+    integrality and, optionally, the names, as they are in memory.  Each
+    array starts on a multiple of 64 bytes, so when the file can be mapped
+    (see CoinMappedFileInput) the accessors return pointers into the
+    mapping and loading a model does not copy or convert anything.  Files
+    written by a CoinUtils with another size of CoinBigIndex are read too,
+    the starts are then converted.  Files of another byte order are not.
+    Only the linear part of a model is kept (no quadratic objective, sets
+    or string elements).
+
+    The format is versioned: a reader knows the sections of its version and
+    ignores sections added later.  Integrality and names are optional.
+
+    Write with CoinMpsIO::writeBinary or CoinModel::writeBinary, read with
+    CoinMpsIO::readBinary, the CoinModel file constructor or
+    OsiSolverInterface::readBinary.
+*/
+class CoinBinaryModel {
+
+public:
+  /**@name Constructor and destructor */
+  //@{
+  /// Default constructor, no model
+  CoinBinaryModel ();
+  /// Destructor, unmaps the file
+  ~CoinBinaryModel ();
+  //@}
+
+  /**@name Reading and writing */
+  //@{
+  /** Writes a model.  The matrix may be row ordered or have gaps.  If
+      bounds or objective are NULL the defaults of loadProblem are written
+      (columns in [0,infinity], rows free, zero objective), integerType and
+      names may be NULL.  Bounds at or beyond infinity are written as
+      COIN_DBL_MAX.  Returns 0 or -1 if the file could not be written.
+  */
+  static int write (const char *filename, const CoinPackedMatrix &matrix,
+                    double infinity,
+                    const double *collb, const double *colub,
+                    const double *obj,
+                    const double *rowlb, const double *rowub,
+                    const char *integerType,
+                    const char *const *rowNames,
+                    const char *const *columnNames,
+                    const char *problemName, const char *objectiveName,
+                    double objectiveOffset);
+  /** Reads a file written by write.  Returns 0, -1 if the file could not
+      be opened or read, -2 if it is not a binary model (or of another byte
+      order) or its matrix or names point outside their sections, and -3
+      if it has more elements than a CoinBigIndex can count.
+  */
+  int read (const char *filename);
+  /// Whether file starts as a binary model
+  static bool isBinary (const char *filename);
+  //@}
+
+  /**@name Model (valid while object exists) */
+  //@{
+  inline int getNumRows () const
+  { return numberRows_; }
+  inline int getNumCols () const
+  { return numberColumns_; }
+  inline CoinBigIndex getNumElements () const
+  { return numberElements_; }
+  /// Column starts (getNumCols()+1 of them)
+  inline const CoinBigIndex *getVectorStarts () const
+  { return starts_; }
+  /// Row indices
+  inline const int *getIndices () const
+  { return indices_; }
+  inline const double *getElements () const
+  { return elements_; }
+  inline const double *getColLower () const
+  { return columnLower_; }
+  inline const double *getColUpper () const
+  { return columnUpper_; }
+  inline const double *getObjCoefficients () const
+  { return objective_; }
+  inline const double *getRowLower () const
+  { return rowLower_; }
+  inline const double *getRowUpper () const
+  { return rowUpper_; }
+  /// Nonzero for integer columns, NULL if there are none
+  inline const char *integerColumns () const
+  { return integerType_; }
+  /// Name of row, NULL if file has no names
+  const char *rowName (int index) const;
+  /// Name of column, NULL if file has no names
+  const char *columnName (int index) const;
+  inline const char *getProblemName () const
+  { return problemName_; }
+  inline const char *getObjectiveName () const
+  { return objectiveName_; }
+  inline double objectiveOffset () const
+  { return objectiveOffset_; }
+  /// Copy of matrix
+  CoinPackedMatrix *createMatrix () const;
+  //@}
+
+private:
+  CoinBinaryModel (const CoinBinaryModel &);
+  CoinBinaryModel &operator= (const CoinBinaryModel &);
+  void clear ();
+
+  /// Input holding (mapped) file
+  CoinFileInput *input_;
+  /// File contents if not mapped
+  std::vector<double> buffer_;
+  /// Starts if converted
+  std::vector<CoinBigIndex> convertedStarts_;
+  int numberRows_;
+  int numberColumns_;
+  CoinBigIndex numberElements_;
+  const CoinBigIndex *starts_;
+  const int *indices_;
+  const double *elements_;
+  const double *columnLower_;
+  const double *columnUpper_;
+  const double *objective_;
+  const double *rowLower_;
+  const double *rowUpper_;
+  const char *integerType_;
+  const CoinInt64 *rowNameStarts_;
+  const char *rowNames_;
+  const CoinInt64 *columnNameStarts_;
+  const char *columnNames_;
+  const char *problemName_;
+  const char *objectiveName_;
+  double objectiveOffset_;
+};
+
+#endif
@@ -2559,7 +2559,7 @@ void CoinFactorization::gutsOfCopy(const CoinFactorization &other)
   const CoinBigIndex * startColumnU = startColumnU_.array();
   const int * numberInColumn = numberInColumn_.array();
 #ifndef NDEBUG
-  int maxU=0;
+  CoinBigIndex maxU=0;
   for (int iRow = 0; iRow < numberRowsExtra_; iRow++ ) {
     CoinBigIndex start = startColumnU[iRow];
     int numberIn = numberInColumn[iRow];
@@ -299,6 +299,93 @@ private:
 
 #endif // COIN_HAS_BZLIB
 
+// ------ Input for memory mapped plain text ------
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#define COIN_HAS_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
+
+CoinMappedFileInput *CoinMappedFileInput::map (const std::string &fileName)
+{
+#ifdef COIN_HAS_MMAP
+  if (fileName=="stdin")
+    return 0;
+  int fd = open (fileName.c_str (), O_RDONLY);
+  if (fd < 0)
+    return 0;
+  struct stat status;
+  void *begin = MAP_FAILED;
+  if (fstat (fd, &status) == 0 && status.st_size > 0)
+    begin = mmap (0, static_cast<size_t>(status.st_size), PROT_READ,
+                  MAP_PRIVATE, fd, 0);
+  // the mapping stays valid after the file is closed
+  close (fd);
+  if (begin == MAP_FAILED)
+    return 0;
+#ifdef MADV_SEQUENTIAL
+  madvise (begin, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+#endif
+  const char *start = static_cast<const char *>(begin);
+  CoinMappedFileInput *input =
+    new CoinMappedFileInput (fileName, start, start + status.st_size);
+  input->length_ = static_cast<size_t>(status.st_size);
+  return input;
+#else
+  return 0;
+#endif
+}
+
+CoinMappedFileInput::CoinMappedFileInput (const std::string &fileName,
+                                          const char *begin, const char *end):
+  CoinFileInput (fileName), begin_ (begin), position_ (begin), end_ (end),
+  length_ (0)
+{
+  readType_="plain";
+}
+
+CoinMappedFileInput::~CoinMappedFileInput ()
+{
+#ifdef COIN_HAS_MMAP
+  if (length_)
+    munmap (const_cast<char *>(begin_), length_);
+#endif
+}
+
+int CoinMappedFileInput::read (void *buffer, int size)
+{
+  if (size <= 0)
+    return 0;
+  if (size > end_ - position_)
+    size = static_cast<int>(end_ - position_);
+  CoinMemcpyN (position_, size, static_cast<char *>(buffer));
+  position_ += size;
+  return size;
+}
+
+char *CoinMappedFileInput::gets (char *buffer, int size)
+{
+  // as fgets, at most size-1 characters up to and including a newline
+  if (size <= 1 || position_ == end_)
+    return 0;
+  int n = size - 1;
+  if (n > end_ - position_)
+    n = static_cast<int>(end_ - position_);
+  const char *newline =
+    static_cast<const char *>(memchr (position_, '\n', n));
+  if (newline)
+    n = static_cast<int>(newline + 1 - position_);
+  CoinMemcpyN (position_, n, buffer);
+  buffer[n] = '\0';
+  position_ += n;
+  return buffer;
+}
+
 
 // ----- implementation of CoinFileInput's methods
 
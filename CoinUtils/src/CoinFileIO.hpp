@@ -76,6 +76,53 @@ public:
   virtual char *gets (char *buffer, int size) = 0;
 };
 
+/// Input class for a plain file mapped into memory, or for a range of
+/// characters of such a file.  Besides read and gets it gives access to
+/// the characters not read yet, so that a reader may split them into
+/// pieces and parse these independently (see CoinMpsIO::setNumberReadThreads).
+class CoinMappedFileInput: public CoinFileInput
+{
+public:
+  /// Maps the file specified, which should not be compressed.
+  /// @return NULL if the file can not be mapped (e.g. stdin, an empty file
+  /// or no mmap on this platform).
+  static CoinMappedFileInput *map (const std::string &fileName);
+
+  /// Constructor for the characters in [begin,end), which must stay valid.
+  CoinMappedFileInput (const std::string &fileName,
+                       const char *begin, const char *end);
+
+  /// Destructor, unmaps the file if mapped by map.
+  virtual ~CoinMappedFileInput ();
+
+  virtual int read (void *buffer, int size);
+
+  virtual char *gets (char *buffer, int size);
+
+  /// Whether the file was mapped by this object (rather than being a range)
+  inline bool mapped () const
+  { return length_ != 0; }
+  /// First character not read yet
+  inline const char *position () const
+  { return position_; }
+  /// Sets first character not read yet
+  inline void setPosition (const char *position)
+  { position_ = position; }
+  /// End of the characters
+  inline const char *end () const
+  { return end_; }
+
+private:
+  CoinMappedFileInput (const CoinMappedFileInput &);
+  CoinMappedFileInput &operator= (const CoinMappedFileInput &);
+
+  const char *begin_;
+  const char *position_;
+  const char *end_;
+  /// Length of the mapping, 0 if not mapped by this object
+  size_t length_;
+};
+
 /// Abstract base class for file output classes.
 class CoinFileOutput: public CoinFileIOBase
 {
@@ -1407,12 +1407,12 @@ CoinLpIO::realloc_coeff(double **coeff, char ***colNames,
 
 /*************************************************************************/
 void
-CoinLpIO::realloc_row(char ***rowNames, int **start, double **rhs, 
+CoinLpIO::realloc_row(char ***rowNames, CoinBigIndex **start, double **rhs, 
 		      double **rowlow, double **rowup, int *maxrow) const {
 
   *maxrow *= 5;
   *rowNames = reinterpret_cast<char **> (realloc ((*rowNames), (*maxrow+1) * sizeof(char *)));
-  *start = reinterpret_cast<int *> (realloc ((*start), (*maxrow+1) * sizeof(int)));
+  *start = reinterpret_cast<CoinBigIndex *> (realloc ((*start), (*maxrow+1) * sizeof(CoinBigIndex)));
   *rhs = reinterpret_cast<double *> (realloc ((*rhs), (*maxrow+1) * sizeof(double)));
   *rowlow = reinterpret_cast<double *> (realloc ((*rowlow), (*maxrow+1) * sizeof(double)));
   *rowup = reinterpret_cast<double *> (realloc ((*rowup), (*maxrow+1) * sizeof(double)));
@@ -1565,7 +1565,7 @@ CoinLpIO::readLp(FILE* fp)
   double *coeff = reinterpret_cast<double *> (malloc ((maxcoeff+1) * sizeof(double)));
 
   char **rowNames = reinterpret_cast<char **> (malloc ((maxrow+1) * sizeof(char *)));
-  int *start = reinterpret_cast<int *> (malloc ((maxrow+1) * sizeof(int)));
+  CoinBigIndex *start = reinterpret_cast<CoinBigIndex *> (malloc ((maxrow+1) * sizeof(CoinBigIndex)));
   double *rhs = reinterpret_cast<double *> (malloc ((maxrow+1) * sizeof(double)));
   double *rowlow = reinterpret_cast<double *> (malloc ((maxrow+1) * sizeof(double)));
   double *rowup = reinterpret_cast<double *> (malloc ((maxrow+1) * sizeof(double)));
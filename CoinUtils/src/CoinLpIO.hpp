@@ -686,7 +686,7 @@ protected:
   void realloc_coeff(double **coeff, char ***colNames, int *maxcoeff) const;
 
   /// Reallocate vectors related to rows.
-  void realloc_row(char ***rowNames, int **start, double **rhs, 
+  void realloc_row(char ***rowNames, CoinBigIndex **start, double **rhs, 
 		   double **rowlow, double **rowup, int *maxrow) const;
     
   /// Reallocate vectors related to columns.
@@ -8,6 +8,7 @@
 #include "CoinModel.hpp"
 #include "CoinSort.hpp"
 #include "CoinMpsIO.hpp"
+#include "CoinBinaryModel.hpp"
 #include "CoinFloatEqual.hpp"
 
 //#############################################################################
@@ -128,7 +129,8 @@ CoinModel::CoinModel ()
      links_(0)
 {
 }
-/* Read a problem in MPS or GAMS format from the given filename.
+/* Read a problem in MPS or GAMS format, or a binary model, from the given
+   filename.
  */
 CoinModel::CoinModel(const char *fileName, int allowStrings)
   : CoinBaseModel(),
@@ -186,7 +188,10 @@ CoinModel::CoinModel(const char *fileName, int allowStrings)
   m.setConvertObjective(true);
   if (!status) {
     try {
-      status=m.readMps(fileName,"");
+      if (CoinBinaryModel::isBinary(fileName))
+	status=m.readBinary(fileName);
+      else
+	status=m.readMps(fileName,"");
     }
     catch (CoinError e) {
       e.print();
@@ -227,7 +232,9 @@ CoinModel::CoinModel(const char *fileName, int allowStrings)
 	numberIntegers++;
       }
     }
-    bool quadraticInteger = (numberIntegers!=0)&&m.reader()->whichSection (  ) == COIN_QUAD_SECTION ;
+    // no card reader if binary
+    bool quadratic = m.reader()&&m.reader()->whichSection (  ) == COIN_QUAD_SECTION ;
+    bool quadraticInteger = (numberIntegers!=0)&&quadratic;
     // do names
     int iRow;
     for (iRow=0;iRow<numberRows_;iRow++) {
@@ -294,8 +301,8 @@ CoinModel::CoinModel(const char *fileName, int allowStrings)
       }
     }
     // get quadratic part
-    if (m.reader()->whichSection (  ) == COIN_QUAD_SECTION ) {
-      int * start=NULL;
+    if (quadratic) {
+      CoinBigIndex * start=NULL;
       int * column = NULL;
       double * element = NULL;
       status=m.readQuadraticMps(NULL,start,column,element,2);
@@ -1770,7 +1777,7 @@ CoinModel::createPackedMatrix(CoinPackedMatrix & matrix,
     }
   }
   int numberErrors=0;
-  CoinBigIndex * start = new int[numberColumns_+1];
+  CoinBigIndex * start = new CoinBigIndex[numberColumns_+1];
   int * row = new int[numberElements];
   double * element = new double[numberElements];
   start[0]=0;
@@ -1824,8 +1831,8 @@ CoinModel::countPlusMinusOne(CoinBigIndex * startPositive, CoinBigIndex * startN
 {
   if (type_==3) 
     badType();
-  memset(startPositive,0,numberColumns_*sizeof(int));
-  memset(startNegative,0,numberColumns_*sizeof(int));
+  memset(startPositive,0,numberColumns_*sizeof(CoinBigIndex));
+  memset(startNegative,0,numberColumns_*sizeof(CoinBigIndex));
   // Set to say all parts
   type_=2;
   resize(numberRows_,numberColumns_,numberElements_);
@@ -2084,6 +2091,68 @@ CoinModel::writeMps(const char *filename, int compression,
   }
   return writer.writeMps(filename, compression, formatType, numberAcross);
 }
+/* Write the problem as a binary model (see CoinBinaryModel).
+ */
+int 
+CoinModel::writeBinary(const char *filename) 
+{
+  int numberErrors = 0;
+  // Set arrays for normal use
+  double * rowLower = rowLower_;
+  double * rowUpper = rowUpper_;
+  double * columnLower = columnLower_;
+  double * columnUpper = columnUpper_;
+  double * objective = objective_;
+  int * integerType = integerType_;
+  double * associated = associated_;
+  // If strings then do copies
+  if (string_.numberItems()) {
+    numberErrors = createArrays(rowLower, rowUpper, columnLower, columnUpper,
+                                 objective, integerType,associated);
+  }
+  CoinPackedMatrix matrix;
+  if (type_!=3) {
+    createPackedMatrix(matrix,associated);
+  } else {
+    matrix = *packedMatrix_;
+  }
+  char* integrality = new char[numberColumns_];
+  bool hasInteger = false;
+  for (int i = 0; i < numberColumns_; i++) {
+    if (integerType[i]) {
+      integrality[i] = 1;
+      hasInteger = true;
+    } else {
+      integrality[i] = 0;
+    }
+  }
+  const char *const * rowNames=NULL;
+  if (rowName_.numberItems())
+    rowNames=rowName_.names();
+  const char * const * columnNames=NULL;
+  if (columnName_.numberItems())
+    columnNames=columnName_.names();
+  int returnCode =
+    CoinBinaryModel::write(filename, matrix, COIN_DBL_MAX,
+                           columnLower, columnUpper, objective,
+                           rowLower, rowUpper,
+                           hasInteger ? integrality : 0,
+                           rowNames, columnNames,
+                           problemName_.c_str(), "", objectiveOffset_);
+  delete[] integrality;
+  if (rowLower!=rowLower_) {
+    delete [] rowLower;
+    delete [] rowUpper;
+    delete [] columnLower;
+    delete [] columnUpper;
+    delete [] objective;
+    delete [] integerType;
+    delete [] associated;
+    if (numberErrors&&logLevel_>0)
+      printf("%d string elements had no values associated with them\n",numberErrors);
+  }
+  return returnCode;
+}
 /* Check two models against each other.  Return nonzero if different.
    Ignore names if that set.
    May modify both models by cleaning up
@@ -3441,7 +3510,7 @@ CoinModel::replaceQuadraticRow(int rowNumber,const double * linearRow, const Coi
           /* temp is at most 10000 long, so static_cast is safe */
 	  put = static_cast<int>(strlen(temp));
 	}
-	for (int j=columnStart[i];j<columnStart[i]+columnLength[i];j++) {
+	for (CoinBigIndex j=columnStart[i];j<columnStart[i]+columnLength[i];j++) {
 	  int jColumn = column[j];
 	  double value = element[j];
 	  if (value<0.0||first) 
@@ -3489,7 +3558,7 @@ CoinModel::replaceQuadraticRow(int rowNumber,const double * linearRow, const Coi
           /* temp is at most 10000 long, so static_cast is safe */
 	  put = static_cast<int>(strlen(temp));
 	}
-	for (int j=columnStart[i];j<columnStart[i]+columnLength[i];j++) {
+	for (CoinBigIndex j=columnStart[i];j<columnStart[i]+columnLength[i];j++) {
 	  int jColumn = column[j];
 	  double value = element[j];
 	  if (value<0.0||first) 
@@ -3539,7 +3608,7 @@ CoinModel::reorder(const char * mark) const
 	  highPriority[i]=2;
 	else
 	  highPriority[i]=1;
-	for (int j=columnStart[i];j<columnStart[i]+columnLength[i];j++) {
+	for (CoinBigIndex j=columnStart[i];j<columnStart[i]+columnLength[i];j++) {
 	  int iColumn = column[j];
 	  if (mark[iColumn])
 	    highPriority[iColumn]=2;
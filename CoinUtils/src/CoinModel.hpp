@@ -403,6 +403,12 @@ public:
   */
   int writeMps(const char *filename, int compression = 0,
                int formatType = 0, int numberAcross = 2, bool keepStrings=false) ;
+  /** Write the problem as a binary model (see CoinBinaryModel), which the
+      file constructor reads back much faster than MPS.  String elements
+      are written with their values.  Returns 0 or -1 if the file could
+      not be written.
+  */
+  int writeBinary(const char *filename) ;
   
   /** Check two models against each other.  Return nonzero if different.
       Ignore names if that set.
@@ -810,7 +816,8 @@ public:
    //@{
    /** Default constructor. */
    CoinModel();
-    /** Read a problem in MPS or GAMS format from the given filename.
+    /** Read a problem in MPS or GAMS format, or a binary model written by
+	writeBinary, from the given filename.
     */
     CoinModel(const char *fileName, int allowStrings=0);
     /** Read a problem from AMPL nl file
@@ -17,8 +17,13 @@
 #include <string>
 #include <cstdio>
 #include <iostream>
+#include <cstring>
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
 
 #include "CoinMpsIO.hpp"
+#include "CoinBinaryModel.hpp"
 #include "CoinMessage.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinModel.hpp"
@@ -443,6 +448,242 @@ CoinMpsCardReader::readToNextSection (  )
   return section_;
 }
 
+/* Parses the cards of the COLUMNS, RHS, RANGES and BOUNDS sections of a
+   memory mapped file ahead of readMps (see CoinMpsIO::setNumberReadThreads).
+   The cards up to the next section card (at most a batch of them) are split
+   into chunks at line boundaries, each chunk is parsed by a card reader of
+   its own - in a thread of its own if COINUTILS_PTHREADS is defined - and
+   nextField then hands out the fields in file order.  Only the parsing and
+   the lookup of row (in BOUNDS column) names are done ahead; readMps gets
+   the same fields in the same order as from a serial read, so the names,
+   hash tables and matrix are the same too.
+*/
+class CoinMpsReadAhead {
+public:
+  CoinMpsReadAhead ( CoinMappedFileInput *input )
+    : input_(input), chunk_(0), field_(0), firstCard_(0) {}
+  /// Sets the next field parsed ahead in reader, false if there is none
+  bool nextField ( CoinMpsCardReader &reader );
+private:
+  /// Cards parsed ahead at most, in bytes per thread
+  enum { batchBytes = 4 << 20 };
+  /// Field as returned by nextField, names and card are offsets into text
+  struct Field {
+    COINMpsType mpsType;
+    double value;
+    /// card number within chunk
+    CoinBigIndex cardNumber;
+    /// image of card, -1 if same as for previous field
+    int card;
+    /// -1 if same as for previous field
+    int columnName;
+    int rowName;
+    /// findHash for row name
+    int index;
+  };
+  /// Range of cards parsed by one reader
+  struct Chunk {
+    const char *begin;
+    const char *end;
+    /// Reader which the parsing state is taken from
+    const CoinMpsCardReader *model;
+    /// Value of eightChar_ before and after parsing
+    bool eightCharIn;
+    bool eightCharOut;
+    /// Number of cards (including comments) in chunk
+    CoinBigIndex numberCards;
+    std::vector<Field> fields;
+    std::vector<char> text;
+  };
+  /// Parses cards up to the next section card, false if there are none
+  bool prepare ( CoinMpsCardReader &reader );
+  static void parse ( Chunk &chunk );
+  static void * parseThread ( void *chunk );
+  static int addText ( std::vector<char> &text, const char *string );
+
+  CoinMappedFileInput *input_;
+  std::vector<Chunk> chunks_;
+  /// Next field to return
+  size_t chunk_;
+  size_t field_;
+  /// Number of cards before current chunk
+  CoinBigIndex firstCard_;
+};
+
+bool
+CoinMpsReadAhead::nextField ( CoinMpsCardReader &reader )
+{
+  while ( true ) {
+    if ( chunk_ < chunks_.size (  ) ) {
+      const Chunk &chunk = chunks_[chunk_];
+      if ( field_ < chunk.fields.size (  ) ) {
+	const Field &field = chunk.fields[field_++];
+	const char *text = &chunk.text[0];
+	reader.mpsType_ = field.mpsType;
+	reader.value_ = field.value;
+	reader.cardNumber_ = firstCard_ + field.cardNumber;
+	if ( field.card >= 0 )
+	  strcpy ( reader.card_, text + field.card );
+	if ( field.columnName >= 0 )
+	  strcpy ( reader.columnName_, text + field.columnName );
+	strcpy ( reader.rowName_, text + field.rowName );
+	reader.hashIndex_ = field.index;
+	return true;
+      }
+      firstCard_ += chunk.numberCards;
+      reader.cardNumber_ = firstCard_;
+      chunk_++;
+      field_ = 0;
+    } else if ( !prepare ( reader ) ) {
+      return false;
+    }
+  }
+}
+
+bool
+CoinMpsReadAhead::prepare ( CoinMpsCardReader &reader )
+{
+  chunks_.clear (  );
+  chunk_ = 0;
+  field_ = 0;
+  COINSectionType section = reader.section_;
+  if ( ( section != COIN_COLUMN_SECTION && section != COIN_RHS_SECTION &&
+	 section != COIN_RANGES_SECTION && section != COIN_BOUNDS_SECTION ) ||
+       reader.stringsAllowed_ )
+    return false;
+  int numberThreads = CoinMax ( 1, reader.reader_->numberReadThreads (  ) );
+  const char *first = input_->position (  );
+  const char *end = input_->end (  );
+  const char *last = first;
+  size_t batch = static_cast<size_t> ( numberThreads ) * batchBytes;
+  // find cards up to next section card (also stop before lines which
+  // gets would split as they do not fit into a card image)
+  while ( last != end && static_cast<size_t> ( last - first ) < batch ) {
+    unsigned char look = *last;
+    if ( look == '\t' || ( look > ' ' && look != '*' ) )
+      break;
+    const char *newline =
+      static_cast<const char *> ( memchr ( last, '\n', end - last ) );
+    const char *next = newline ? newline + 1 : end;
+    if ( next - last > MAX_CARD_LENGTH - 1 )
+      break;
+    last = next;
+  }
+  if ( last == first )
+    return false;
+  // split at line boundaries
+  size_t size = ( last - first ) / numberThreads + 1;
+  const char *begin = first;
+  while ( begin != last ) {
+    const char *split = last;
+    if ( static_cast<size_t> ( last - begin ) > size ) {
+      split = static_cast<const char *>
+	( memchr ( begin + size, '\n', last - begin - size ) );
+      split = split ? split + 1 : last;
+    }
+    Chunk chunk;
+    chunk.begin = begin;
+    chunk.end = split;
+    chunk.model = &reader;
+    chunk.eightCharIn = reader.eightChar_;
+    chunks_.push_back ( chunk );
+    begin = split;
+  }
+  int numberChunks = static_cast<int> ( chunks_.size (  ) );
+#ifdef COINUTILS_PTHREADS
+  std::vector<pthread_t> threads ( numberChunks );
+  std::vector<bool> started ( numberChunks, false );
+  for ( int i = 1; i < numberChunks; i++ )
+    started[i] = !pthread_create ( &threads[i], NULL, parseThread,
+				   &chunks_[i] );
+  parse ( chunks_[0] );
+  for ( int i = 1; i < numberChunks; i++ ) {
+    if ( started[i] )
+      pthread_join ( threads[i], NULL );
+    else
+      parse ( chunks_[i] );
+  }
+#else
+  for ( int i = 0; i < numberChunks; i++ )
+    parse ( chunks_[i] );
+#endif
+  // In fixed format names longer than eight characters switch off
+  // eightChar_ for good, so chunks after one which did are parsed again
+  bool eightChar = reader.eightChar_;
+  for ( int i = 0; i < numberChunks; i++ ) {
+    if ( chunks_[i].eightCharIn != eightChar ) {
+      chunks_[i].eightCharIn = eightChar;
+      parse ( chunks_[i] );
+    }
+    eightChar = chunks_[i].eightCharOut;
+  }
+  reader.eightChar_ = eightChar;
+  input_->setPosition ( last );
+  reader.position_ = reader.card_;
+  reader.eol_ = reader.card_;
+  firstCard_ = reader.cardNumber_;
+  return true;
+}
+
+void
+CoinMpsReadAhead::parse ( Chunk &chunk )
+{
+  const CoinMpsCardReader &model = *chunk.model;
+  CoinMpsCardReader reader ( new CoinMappedFileInput
+			     ( model.input_->getFileName (  ),
+			       chunk.begin, chunk.end ), model.reader_ );
+  reader.section_ = model.section_;
+  reader.freeFormat_ = model.freeFormat_;
+  reader.ieeeFormat_ = model.ieeeFormat_;
+  reader.eightChar_ = chunk.eightCharIn;
+  chunk.fields.clear (  );
+  chunk.text.clear (  );
+  chunk.text.reserve ( 2 * ( chunk.end - chunk.begin ) );
+  CoinBigIndex lastCard = -1;
+  int lastColumn = -1;
+  // the hash tables stay as they are while the section is read
+  int section = model.section_ == COIN_BOUNDS_SECTION ? 1 : 0;
+  while ( reader.nextField (  ) == model.section_ ) {
+    Field field;
+    field.mpsType = reader.mpsType_;
+    field.value = reader.value_;
+    field.cardNumber = reader.cardNumber_;
+    field.card = -1;
+    // errors may leave image changed
+    if ( reader.cardNumber_ != lastCard ||
+	 reader.mpsType_ == COIN_UNKNOWN_MPS_TYPE ) {
+      field.card = addText ( chunk.text, reader.card_ );
+      lastCard = reader.cardNumber_;
+    }
+    field.columnName = -1;
+    if ( lastColumn < 0 ||
+	 strcmp ( &chunk.text[lastColumn], reader.columnName_ ) ) {
+      field.columnName = addText ( chunk.text, reader.columnName_ );
+      lastColumn = field.columnName;
+    }
+    field.rowName = addText ( chunk.text, reader.rowName_ );
+    field.index = model.reader_->findHash ( reader.rowName_, section );
+    chunk.fields.push_back ( field );
+  }
+  chunk.numberCards = reader.cardNumber_;
+  chunk.eightCharOut = reader.eightChar_;
+}
+
+void *
+CoinMpsReadAhead::parseThread ( void *chunk )
+{
+  parse ( *static_cast<Chunk *> ( chunk ) );
+  return NULL;
+}
+
+int
+CoinMpsReadAhead::addText ( std::vector<char> &text, const char *string )
+{
+  int offset = static_cast<int> ( text.size (  ) );
+  text.insert ( text.end (  ), string, string + strlen ( string ) + 1 );
+  return offset;
+}
+
 CoinMpsCardReader::CoinMpsCardReader (  CoinFileInput *input, 
 					CoinMpsIO * reader)
 {
@@ -464,10 +705,17 @@ CoinMpsCardReader::CoinMpsCardReader (  CoinFileInput *input,
   messages_ = reader_->messages();
   memset ( valueString_, 0, COIN_MAX_FIELD_LENGTH );
   stringsAllowed_=false;
+  readAhead_ = NULL;
+  hashIndex_ = -2;
+  // only a whole file is parsed ahead, not the chunks of one
+  CoinMappedFileInput * mapped = dynamic_cast<CoinMappedFileInput *> (input);
+  if (mapped&&mapped->mapped())
+    readAhead_ = new CoinMpsReadAhead(mapped);
 }
 //  ~CoinMpsCardReader.  Destructor
 CoinMpsCardReader::~CoinMpsCardReader (  )
 {
+  delete readAhead_;
   delete input_;
 }
 
@@ -493,6 +741,7 @@ COINSectionType
 CoinMpsCardReader::nextField (  )
 {
   mpsType_ = COIN_BLANK_COLUMN;
+  hashIndex_ = -2;
   // find next non blank character
   char *next = position_;
 
@@ -507,6 +756,8 @@ CoinMpsCardReader::nextField (  )
 
   if ( next == eol_ ) {
     gotCard = false;
+    if ( readAhead_ && readAhead_->nextField ( *this ) )
+      return section_;
   } else {
     gotCard = true;
   }
@@ -1389,6 +1640,15 @@ CoinMpsIO::findHash ( const char *name , int section ) const
   return found;
 }
 #endif
+// findHash for name in current field
+int
+CoinMpsIO::findFieldHash ( int section ) const
+{
+  int index = cardReader_->hashIndex (  );
+  if ( index >= -1 )
+    return index;
+  return findHash ( cardReader_->rowName (  ) , section );
+}
 //------------------------------------------------------------------
 // Get value for infinity
 //------------------------------------------------------------------
@@ -1486,6 +1746,14 @@ CoinMpsIO::dealWithFileName(const char * filename,  const char * extension,
 	else
 	  {
 	    input = CoinFileInput::create (fname);
+	    if (numberReadThreads_>1&&input->getReadType()=="plain") {
+	      // map so that cards can be parsed ahead in parallel
+	      CoinFileInput * mapped = CoinMappedFileInput::map (fname);
+	      if (mapped) {
+		delete input;
+		input = mapped;
+	      }
+	    }
 	    goodFile = 1;
 	  }
       } else {
@@ -1850,7 +2118,7 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 	      (realloc ( element, maxElements * sizeof ( double )));
 	  }
 	  // get row number
-	  COINRowIndex irow = findHash ( cardReader_->rowName (  ) , 0 );
+	  COINRowIndex irow = findFieldHash ( 0 );
 
 	  if ( irow >= 0 ) {
 	    double value = cardReader_->value (  );
@@ -1914,7 +2182,7 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 	  const char * s = cardReader_->valueString();
 	  assert (*s=='=');
 	  // get row number
-	  COINRowIndex irow = findHash ( cardReader_->rowName (  ) , 0 );
+	  COINRowIndex irow = findFieldHash ( 0 );
 
 	  if ( irow >= 0 ) {
 	    addString(irow,column,s+1);
@@ -2034,7 +2302,7 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 	  }
 	}
 	// get row number
-	irow = findHash ( cardReader_->rowName (  ) , 0 );
+	irow = findFieldHash ( 0 );
 	if ( irow >= 0 ) {
 	  double value = cardReader_->value (  );
 
@@ -2133,7 +2401,7 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 	    }
 	  }
 	  // get row number
-	  irow = findHash ( cardReader_->rowName (  ) , 0 );
+	  irow = findFieldHash ( 0 );
 	  if ( irow >= 0 ) {
 	    double value = cardReader_->value (  );
 
@@ -2291,7 +2559,7 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 	  }
 	}
 	// get column number
-	COINColumnIndex icolumn = findHash ( cardReader_->rowName (  ) , 1 );
+	COINColumnIndex icolumn = findFieldHash ( 1 );
 
 	if ( icolumn >= 0 ) {
 	  double value = cardReader_->value (  );
@@ -4643,6 +4911,73 @@ CoinMpsIO::writeMps(const char *filename, int compression,
    delete output;
    return 0;
 }
+
+int
+CoinMpsIO::writeBinary(const char *filename, bool names) const
+{
+  const CoinPackedMatrix * matrix = getMatrixByCol();
+  if (!matrix)
+    return -1;
+  const char * const * rowNames = NULL;
+  const char * const * columnNames = NULL;
+  if (names) {
+    rowNames = names_[0];
+    columnNames = names_[1];
+  }
+  return CoinBinaryModel::write(filename, *matrix, infinity_,
+				collower_, colupper_, objective_,
+				rowlower_, rowupper_, integerType_,
+				rowNames, columnNames,
+				problemName_, objectiveName_,
+				objectiveOffset_);
+}
+
+int
+CoinMpsIO::readBinary(const char *filename)
+{
+  CoinBinaryModel model;
+  int returnCode = model.read(filename);
+  if (returnCode) {
+    if (returnCode == -1)
+      handler_->message(COIN_MPS_FILE,messages_)<<filename
+						<<CoinMessageEol;
+    return returnCode;
+  }
+  // names are pointers into the file
+  std::vector<const char *> rowNames;
+  std::vector<const char *> columnNames;
+  if (model.rowName(0)) {
+    rowNames.resize(model.getNumRows());
+    for (int i = 0; i < model.getNumRows(); i++)
+      rowNames[i] = model.rowName(i);
+  }
+  if (model.columnName(0)) {
+    columnNames.resize(model.getNumCols());
+    for (int i = 0; i < model.getNumCols(); i++)
+      columnNames[i] = model.columnName(i);
+  }
+  CoinPackedMatrix * matrix = model.createMatrix();
+  setMpsData(*matrix, infinity_,
+	     model.getColLower(), model.getColUpper(),
+	     model.getObjCoefficients(), model.integerColumns(),
+	     model.getRowLower(), model.getRowUpper(),
+	     columnNames.size() ? &columnNames[0] : NULL,
+	     rowNames.size() ? &rowNames[0] : NULL);
+  delete matrix;
+  free(problemName_);
+  problemName_ = CoinStrdup(model.getProblemName());
+  free(objectiveName_);
+  objectiveName_ = CoinStrdup(model.getObjectiveName());
+  objectiveOffset_ = model.objectiveOffset();
+  free(fileName_);
+  fileName_ = CoinStrdup(filename);
+  handler_->message(COIN_MPS_STATS,messages_)<<problemName_
+					     <<numberRows_
+					     <<numberColumns_
+					     <<numberElements_
+					     <<CoinMessageEol;
+  return 0;
+}
    
 //------------------------------------------------------------------
 // Problem name
@@ -5259,7 +5594,8 @@ convertObjective_(false),
 allowStringElements_(0),
 maximumStringElements_(0),
 numberStringElements_(0),
-stringElements_(NULL)
+stringElements_(NULL),
+numberReadThreads_(1)
 {
   numberHash_[0]=0;
   hash_[0]=NULL;
@@ -5305,7 +5641,8 @@ cardReader_(NULL),
 allowStringElements_(rhs.allowStringElements_),
 maximumStringElements_(rhs.maximumStringElements_),
 numberStringElements_(rhs.numberStringElements_),
-stringElements_(NULL)
+stringElements_(NULL),
+numberReadThreads_(rhs.numberReadThreads_)
 {
   numberHash_[0]=0;
   hash_[0]=NULL;
@@ -5388,6 +5725,7 @@ void CoinMpsIO::gutsOfCopy(const CoinMpsIO & rhs)
   allowStringElements_ = rhs.allowStringElements_;
   maximumStringElements_ = rhs.maximumStringElements_;
   numberStringElements_ = rhs.numberStringElements_;
+  numberReadThreads_ = rhs.numberReadThreads_;
   if (numberStringElements_) {
     stringElements_ = new char * [maximumStringElements_];
     for (int i=0;i<numberStringElements_;i++)
@@ -5521,7 +5859,7 @@ CoinMpsIO::newLanguage(CoinMessages::Language language)
 */
 int 
 CoinMpsIO::readQuadraticMps(const char * filename,
-			    int * &columnStart, int * &column2, double * &elements,
+			    CoinBigIndex * &columnStart, int * &column2, double * &elements,
 			    int checkSymmetry)
 {
   // Deal with filename - +1 if new, 0 if same as before, -1 if error
@@ -5632,9 +5970,9 @@ CoinMpsIO::readQuadraticMps(const char * filename,
   }
   stopHash(1);
   // Do arrays as new [] and make column ordered
-  columnStart = new int [numberColumns_+1];
+  columnStart = new CoinBigIndex [numberColumns_+1];
   // for counts
-  int * count = new int[numberColumns_];
+  CoinBigIndex * count = new CoinBigIndex[numberColumns_];
   memset(count,0,numberColumns_*sizeof(int));
   CoinBigIndex i;
   // See about lower triangular
@@ -5669,7 +6007,7 @@ CoinMpsIO::readQuadraticMps(const char * filename,
     count[iColumn]++;
   }
   // Do starts
-  int number = 0;
+  CoinBigIndex number = 0;
   columnStart[0]=0;
   for (i=0;i<numberColumns_;i++) {
     number += count[i];
@@ -5683,7 +6021,7 @@ CoinMpsIO::readQuadraticMps(const char * filename,
   for ( i = 0; i < numberElements; i++ ) {
     int iColumn = column[i];
     int iColumn2 = column2Temp[i];
-    int put = count[iColumn];
+    CoinBigIndex put = count[iColumn];
     elements[put]=elementTemp[i];
     column2[put++]=iColumn2;
     count[iColumn]=put;
@@ -5696,17 +6034,17 @@ CoinMpsIO::readQuadraticMps(const char * filename,
   for (i=0;i<numberColumns_;i++) 
     count[i] = -1;
 
-  int start = 0;
+  CoinBigIndex start = 0;
   number=0;
   for (i=0;i<numberColumns_;i++) {
-    int j;
+    CoinBigIndex j;
     for (j=start;j<columnStart[i+1];j++) {
       int iColumn2 = column2[j];
       if (count[iColumn2]<0) {
 	count[iColumn2]=j;
       } else {
 	// duplicate
-	int iOther = count[iColumn2];
+	CoinBigIndex iOther = count[iColumn2];
 	double value = elements[iOther]+elements[j];
 	elements[iOther]=value;
 	elements[j]=0.0;
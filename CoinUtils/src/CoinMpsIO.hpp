@@ -54,8 +54,10 @@ enum COINMpsType { COIN_N_ROW, COIN_E_ROW, COIN_L_ROW, COIN_G_ROW,
 		   COIN_LL_BASIS, COIN_UL_BASIS, COIN_UNKNOWN_MPS_TYPE
 };
 class CoinMpsIO;
+class CoinMpsReadAhead;
 /// Very simple code for reading MPS data
 class CoinMpsCardReader {
+  friend class CoinMpsReadAhead;
 
 public:
 
@@ -141,6 +143,10 @@ public:
   /// get position (again so gms reader will work)
   inline char * getPosition() const
   { return position_;}
+  /// Index found for row name by readMps hash if parsed ahead, else -2
+  inline int hashIndex (  ) const {
+    return hashIndex_;
+  }
   /// Returns card number
   inline CoinBigIndex cardNumber (  ) const {
     return cardNumber_;
@@ -195,6 +201,10 @@ protected:
   char valueString_[COIN_MAX_FIELD_LENGTH];
   /// Whether strings allowed
   bool stringsAllowed_;
+  /// Fields parsed ahead (only for a mapped file), NULL if none
+  CoinMpsReadAhead * readAhead_;
+  /// Index of row name if parsed ahead, else -2
+  int hashIndex_;
   //@}
 public:
   /**@name methods */
@@ -327,6 +337,7 @@ protected:
 
 class CoinMpsIO {
    friend void CoinMpsIOUnitTest(const std::string & mpsDir);
+   friend class CoinMpsReadAhead;
 
 public:
 
@@ -563,6 +574,16 @@ public:
     { return smallElement_;}
     inline void setSmallElementValue(double value)
     { smallElement_=value;} 
+    /** Number of threads used to read MPS files (default 1).
+        With more than one, a plain file is mapped into memory and the
+        cards of the COLUMNS, RHS, RANGES and BOUNDS sections are parsed
+        ahead in chunks, one chunk per thread when CoinUtils is configured
+        with --enable-coinutils-threads.  The problem read is the same as
+        with one thread.  Takes effect when the next file is opened. */
+    inline int numberReadThreads() const
+    { return numberReadThreads_;}
+    inline void setNumberReadThreads(int value)
+    { numberReadThreads_ = value;}
 //@}
 
 
@@ -658,6 +679,11 @@ public:
     /** Read a problem in GMPL (subset of AMPL)  format from the given filenames.
     */
     int readGMPL(const char *modelName, const char * dataName=NULL, bool keepNames=false);
+    /** Read a problem written by writeBinary (see CoinBinaryModel).
+	Returns 0, -1 if the file could not be opened, -2 if it is not a
+	binary model and -3 if it is too large for this CoinBigIndex.
+    */
+    int readBinary(const char *filename);
 
     /** Write the problem in MPS format to a file with the given filename.
 
@@ -689,6 +715,12 @@ public:
 		 CoinPackedMatrix * quadratic = NULL,
 		 int numberSOS=0,const CoinSet * setInfo=NULL) const;
 
+    /** Write the problem as a binary model (see CoinBinaryModel), which
+	is read back much faster than an MPS file.  If names is false no
+	names are written.  Returns 0 or -1 if the file could not be written.
+    */
+    int writeBinary(const char *filename, bool names = true) const;
+
     /// Return card reader object so can see what last card was e.g. QUADOBJ
     inline const CoinMpsCardReader * reader() const
     { return cardReader_;}
@@ -721,7 +753,7 @@ public:
       columnStart is numberColumns+1 long, others numberNonZeros
     */
     int readQuadraticMps(const char * filename,
-			 int * &columnStart, int * &column, double * &elements,
+			 CoinBigIndex * &columnStart, int * &column, double * &elements,
 			 int checkSymmetry);
 
     /** Read in a list of cones from the given filename.  
@@ -905,6 +937,9 @@ protected:
   void stopHash ( int section );
   /// Finds match using hash,  -1 not found
   int findHash ( const char *name , int section ) const;
+  /** findHash for row name of current field (column name in BOUNDS),
+      found already if card was parsed ahead */
+  int findFieldHash ( int section ) const;
   //@}
 
     /**@name Cached problem information */
@@ -1024,6 +1059,8 @@ protected:
       int numberStringElements_;
       /// String elements
       char ** stringElements_;
+      /// Number of threads used to read MPS files
+      int numberReadThreads_;
     //@}
 
 };
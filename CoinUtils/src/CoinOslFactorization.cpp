@@ -159,7 +159,7 @@ CoinOslFactorization::getAreas ( int numberOfRows,
   // If we are going to increase then be on safe side
   if (size>oldnnetas) 
     size = static_cast<int>(1.1*size);
-  factInfo_.eta_size=CoinMax(size,oldnnetas);
+  factInfo_.eta_size=static_cast<int>(CoinMax(size,static_cast<CoinBigIndex>(oldnnetas)));
   //printf("clp size %d, old %d now %d - iteration %d - last count %d - rows %d,%d,%d\n",
   // size,oldnnetas,factInfo_.eta_size,factInfo_.iterno,factInfo_.lastEtaCount,
   //numberRows_,factInfo_.nrowmx,factInfo_.nrow);
@@ -221,7 +221,7 @@ CoinOslFactorization::preProcess ()
   // Go to Fortran  
   int * hcoli=factInfo_.xecadr+1;
   int * indexRowU = factInfo_.xeradr+1;
-  CoinBigIndex * startColumnU=factInfo_.xcsadr+1;
+  int * startColumnU=factInfo_.xcsadr+1;
   for (int i=0;i<numberRows_;i++) {
     int start = startColumnU[i];
     startColumnU[i]++; // to Fortran
@@ -638,7 +638,14 @@ CoinOslFactorization::numberInColumn() const
 // Returns array to put basis starts in
 CoinBigIndex * 
 CoinOslFactorization::starts() const
-{ return reinterpret_cast<CoinBigIndex *> (factInfo_.xcsadr+1);}
+{
+#if COIN_BIG_INDEX==0
+  return reinterpret_cast<CoinBigIndex *> (factInfo_.xcsadr+1);
+#else
+  // starts are kept as int, so there is no such array
+  return NULL;
+#endif
+}
 // Returns array to put basis elements in
 CoinFactorizationDouble * 
 CoinOslFactorization::elements() const
@@ -1427,7 +1434,7 @@ int CoinOslFactorization::factorize (
   // Fill in counts so we can skip part of preProcess
   double * elementU=elements();
   int * indexRowU=indices();
-  int * startColumnU=starts();
+  int * startColumnU=factInfo_.xcsadr+1;
   int * numberInRow=this->numberInRow();
   int * numberInColumn=this->numberInColumn();
   CoinZeroN ( numberInRow, numberRows  );
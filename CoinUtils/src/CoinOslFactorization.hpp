@@ -173,7 +173,7 @@ public:
   virtual int * numberInRow() const;
   /// Number of entries in each column
   virtual int * numberInColumn() const;
-  /// Returns array to put basis starts in
+  /// Returns array to put basis starts in (NULL with a 64 bit CoinBigIndex)
   virtual CoinBigIndex * starts() const;
   /// Returns permute back
   virtual int * permuteBack() const;
@@ -11,6 +11,10 @@
 #include <cstdio>
 #include <cmath>
 #include <iostream>
+#include <vector>
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
 
 #include "CoinPragma.hpp"
 #include "CoinSort.hpp"
@@ -21,6 +25,23 @@
 #include "CoinFloatEqual.hpp"
 #include "CoinPackedMatrix.hpp"
 
+// Vector kernels are picked at run time from what the processor has.
+// _mm512_reduce_add_pd came with GCC 7 and clang 4 (Apple clang 9), clang
+// says it is GCC 4.2
+#if defined(__clang__)
+#if defined(__apple_build_version__) ? __clang_major__ >= 9 : __clang_major__ >= 4
+#define COIN_PACKED_SIMD
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 7
+#define COIN_PACKED_SIMD
+#endif
+#if defined(COIN_PACKED_SIMD) && !defined(__x86_64__) && !defined(__i386__)
+#undef COIN_PACKED_SIMD
+#endif
+#ifdef COIN_PACKED_SIMD
+#include <immintrin.h>
+#endif
+
 #if !defined(COIN_COINUTILS_CHECKLEVEL)
 #define COIN_COINUTILS_CHECKLEVEL 0
 #endif
@@ -68,6 +89,314 @@ CoinTestIndexSet(const int numDel, const int * indDel, const int maxEntry,
    return 0;
 }
 
+//#############################################################################
+// Splitting work between threads (matrix times vector methods and
+// reverse ordering)
+
+namespace {
+
+  int numberThreads_ = 1;
+  // Each thread should have at least this many elements
+  const CoinBigIndex minimumThreadElements = 100000;
+  // Reverse ordering in blocks from this many elements (0 always)
+  CoinBigIndex blockedTransposeSize_ = 1000000;
+  /* On one thread blocks only pay when write positions of the serial code
+     do not fit in cache; on a 2MB cache it was even at 400000 vectors */
+  const int minimumBlockedMajorDim = 500000;
+
+  // Number of blocks to do size elements in
+  int numberBlocks(CoinBigIndex size)
+  {
+#ifdef COINUTILS_PTHREADS
+    if (numberThreads_ > 1 && size >= 2 * minimumThreadElements)
+      return static_cast<int>(CoinMin(static_cast<CoinBigIndex>(numberThreads_),
+				      size / minimumThreadElements));
+#endif
+    return 1;
+  }
+
+  /* Splits [0,number) into numberBlocks ranges of about the same weight,
+     range i is [first[i],first[i+1]) */
+  template <class T>
+  void splitByWeight(const T *weight, int number, CoinBigIndex total,
+		     int numberBlocks, std::vector<int> &first)
+  {
+    first.assign(numberBlocks + 1, number);
+    first[0] = 0;
+    CoinBigIndex perBlock = total / numberBlocks + 1;
+    CoinBigIndex count = 0;
+    int iBlock = 1;
+    for (int i = 0; i < number && iBlock < numberBlocks; i++) {
+      count += weight[i];
+      if (count >= perBlock) {
+	first[iBlock++] = i + 1;
+	count = 0;
+      }
+    }
+  }
+
+#ifdef COINUTILS_PTHREADS
+  template <class Task>
+  void *runTask(void *task)
+  {
+    static_cast<Task *>(task)->run();
+    return NULL;
+  }
+#endif
+
+  // Runs tasks, all but the first in threads of their own if allowed
+  template <class Task>
+  void runTasks(std::vector<Task> &tasks)
+  {
+    int number = static_cast<int>(tasks.size());
+#ifdef COINUTILS_PTHREADS
+    if (number > 1) {
+      std::vector<pthread_t> threads(number);
+      std::vector<bool> started(number, false);
+      for (int i = 1; i < number; i++)
+	started[i] = !pthread_create(&threads[i], NULL, runTask<Task>,
+				     &tasks[i]);
+      tasks[0].run();
+      for (int i = 1; i < number; i++) {
+	if (started[i])
+	  pthread_join(threads[i], NULL);
+	else
+	  tasks[i].run();
+      }
+      return;
+    }
+#endif
+    for (int i = 0; i < number; i++)
+      tasks[i].run();
+  }
+
+  // Whether size elements going into newMajorDim vectors should be blocked
+  bool useBlockedTranspose(CoinBigIndex size, int newMajorDim)
+  {
+    if (size <= 0)
+      return false;
+    if (!blockedTransposeSize_)
+      return true;
+    return size >= blockedTransposeSize_ &&
+      (numberBlocks(size) > 1 || newMajorDim >= minimumBlockedMajorDim);
+  }
+
+  /* Reverse ordering by two stable counting sorts.  The elements are first
+     sorted into buckets by bands of new major vectors, in parallel over
+     blocks of old major vectors.  Then each band is counted and filled on
+     its own, in parallel over bands.  A band has a few ten thousand
+     elements, so its write positions stay in cache, which they do not
+     when a large matrix is scattered in one pass.  Each new vector gets
+     its elements in old major order, as it does in the serial code.
+     Needs 16 bytes of work space per element. */
+  class BlockedTranspose {
+  public:
+    BlockedTranspose(const CoinBigIndex *start, const int *length,
+		     const int *index, const double *element,
+		     int majorDim, CoinBigIndex size, int newMajorDim);
+    ~BlockedTranspose();
+    /// Fills in lengths of new major vectors
+    void countLengths(int *newLength);
+    /// Fills in new major vectors at newStart
+    void fill(const CoinBigIndex *newStart, int *newIndex,
+	      double *newElement);
+
+  private:
+    BlockedTranspose(const BlockedTranspose &);
+    BlockedTranspose &operator=(const BlockedTranspose &);
+
+    // 0 count buckets, 1 sort into buckets, 2 count lengths, 3 fill
+    struct Task {
+      BlockedTranspose *transpose;
+      int phase;
+      // old major vectors (phases 0 and 1) or bands
+      int first;
+      int last;
+      // count or next position for each band
+      CoinBigIndex *bucket;
+      void run();
+    };
+    void runPhase(int phase);
+
+    const CoinBigIndex *start_;
+    const int *length_;
+    const int *index_;
+    const double *element_;
+    int majorDim_;
+    CoinBigIndex size_;
+    int newMajorDim_;
+    // band is new major index >> shift_
+    int shift_;
+    int numberBands_;
+    // old major vectors or bands of each task
+    std::vector<int> majorFirst_;
+    std::vector<int> bandFirst_;
+    // numberBands_ for each block of old major vectors
+    std::vector<CoinBigIndex> bucket_;
+    // where each band starts in work arrays
+    std::vector<CoinBigIndex> bandStart_;
+    // elements sorted by band
+    int *workMajor_;
+    int *workMinor_;
+    double *workElement_;
+    // new matrix
+    const CoinBigIndex *newStart_;
+    int *newLength_;
+    int *newIndex_;
+    double *newElement_;
+  };
+
+  BlockedTranspose::BlockedTranspose(const CoinBigIndex *start,
+				     const int *length,
+				     const int *index, const double *element,
+				     int majorDim, CoinBigIndex size,
+				     int newMajorDim)
+    : start_(start), length_(length), index_(index), element_(element),
+      majorDim_(majorDim), size_(size), newMajorDim_(newMajorDim),
+      shift_(0), numberBands_(0),
+      workMajor_(NULL), workMinor_(NULL), workElement_(NULL),
+      newStart_(NULL), newLength_(NULL), newIndex_(NULL), newElement_(NULL)
+  {
+    int numberTasks = numberBlocks(size);
+    // bands of a power of two new major vectors
+    CoinBigIndex wanted = CoinMax(static_cast<CoinBigIndex>(4 * numberTasks),
+				  size / 32768);
+    while (((newMajorDim_ - 1) >> shift_) + 1 > wanted)
+      shift_++;
+    numberBands_ = ((newMajorDim_ - 1) >> shift_) + 1;
+    splitByWeight(length_, majorDim_, size_, numberTasks, majorFirst_);
+    bucket_.assign(static_cast<size_t>(numberTasks) * numberBands_, 0);
+    runPhase(0);
+    // positions of each block in each bucket
+    bandStart_.resize(numberBands_ + 1);
+    CoinBigIndex position = 0;
+    for (int iBand = 0; iBand < numberBands_; iBand++) {
+      bandStart_[iBand] = position;
+      for (int iTask = 0; iTask < numberTasks; iTask++) {
+	CoinBigIndex &bucket =
+	  bucket_[static_cast<size_t>(iTask) * numberBands_ + iBand];
+	CoinBigIndex count = bucket;
+	bucket = position;
+	position += count;
+      }
+    }
+    bandStart_[numberBands_] = position;
+    assert(position == size_);
+    workMajor_ = new int[size_];
+    workMinor_ = new int[size_];
+    workElement_ = new double[size_];
+    runPhase(1);
+    // bands of about the same number of elements for each task
+    std::vector<CoinBigIndex> bandSize(numberBands_);
+    for (int iBand = 0; iBand < numberBands_; iBand++)
+      bandSize[iBand] = bandStart_[iBand + 1] - bandStart_[iBand];
+    splitByWeight(&bandSize[0], numberBands_, size_, numberTasks, bandFirst_);
+  }
+
+  BlockedTranspose::~BlockedTranspose()
+  {
+    delete[] workMajor_;
+    delete[] workMinor_;
+    delete[] workElement_;
+  }
+
+  void BlockedTranspose::countLengths(int *newLength)
+  {
+    newLength_ = newLength;
+    runPhase(2);
+  }
+
+  void BlockedTranspose::fill(const CoinBigIndex *newStart, int *newIndex,
+			      double *newElement)
+  {
+    newStart_ = newStart;
+    newIndex_ = newIndex;
+    newElement_ = newElement;
+    runPhase(3);
+  }
+
+  void BlockedTranspose::runPhase(int phase)
+  {
+    const std::vector<int> &first = phase < 2 ? majorFirst_ : bandFirst_;
+    int numberTasks = static_cast<int>(first.size()) - 1;
+    std::vector<Task> tasks(numberTasks);
+    for (int iTask = 0; iTask < numberTasks; iTask++) {
+      Task &task = tasks[iTask];
+      task.transpose = this;
+      task.phase = phase;
+      task.first = first[iTask];
+      task.last = first[iTask + 1];
+      task.bucket = &bucket_[static_cast<size_t>(iTask) * numberBands_];
+    }
+    runTasks(tasks);
+  }
+
+  void BlockedTranspose::Task::run()
+  {
+    const BlockedTranspose &t = *transpose;
+    const int shift = t.shift_;
+    if (phase < 2) {
+      const CoinBigIndex *start = t.start_;
+      const int *length = t.length_;
+      const int *index = t.index_;
+      if (phase == 0) {
+	for (int i = first; i < last; i++) {
+	  const CoinBigIndex end = start[i] + length[i];
+	  for (CoinBigIndex j = start[i]; j < end; j++) {
+	    assert(index[j] >= 0 && index[j] < t.newMajorDim_);
+	    bucket[index[j] >> shift]++;
+	  }
+	}
+      } else {
+	const double *element = t.element_;
+	int *workMajor = t.workMajor_;
+	int *workMinor = t.workMinor_;
+	double *workElement = t.workElement_;
+	for (int i = first; i < last; i++) {
+	  const CoinBigIndex end = start[i] + length[i];
+	  for (CoinBigIndex j = start[i]; j < end; j++) {
+	    const int ind = index[j];
+	    const CoinBigIndex put = bucket[ind >> shift]++;
+	    workMajor[put] = ind;
+	    workMinor[put] = i;
+	    workElement[put] = element[j];
+	  }
+	}
+      }
+    } else {
+      const int *workMajor = t.workMajor_;
+      int *newLength = t.newLength_;
+      std::vector<CoinBigIndex> next;
+      if (phase == 3)
+	next.resize(CoinMin(1 << shift, t.newMajorDim_));
+      for (int iBand = first; iBand < last; iBand++) {
+	const int firstMajor = iBand << shift;
+	const int lastMajor = CoinMin(t.newMajorDim_, (iBand + 1) << shift);
+	const CoinBigIndex end = t.bandStart_[iBand + 1];
+	if (phase == 2) {
+	  for (int i = firstMajor; i < lastMajor; i++)
+	    newLength[i] = 0;
+	  for (CoinBigIndex k = t.bandStart_[iBand]; k < end; k++)
+	    newLength[workMajor[k]]++;
+	} else {
+	  const int *workMinor = t.workMinor_;
+	  const double *workElement = t.workElement_;
+	  int *newIndex = t.newIndex_;
+	  double *newElement = t.newElement_;
+	  for (int i = firstMajor; i < lastMajor; i++)
+	    next[i - firstMajor] = t.newStart_[i];
+	  for (CoinBigIndex k = t.bandStart_[iBand]; k < end; k++) {
+	    const CoinBigIndex put = next[workMajor[k] - firstMajor]++;
+	    newIndex[put] = workMinor[k];
+	    newElement[put] = workElement[k];
+	  }
+	}
+      }
+    }
+  }
+
+}
+
 //#############################################################################
 
 void
@@ -88,7 +417,7 @@ CoinPackedMatrix::reserve(const int newMaxMajorDim, const CoinBigIndex newMaxSiz
       if (create) {
 	// create empty vectors
 	CoinFillN(length_+majorDim_,maxMajorDim_-majorDim_,0);
-	CoinFillN(start_+majorDim_+1,maxMajorDim_-majorDim_,0);
+	CoinFillN(start_+majorDim_+1,maxMajorDim_-majorDim_,static_cast<CoinBigIndex>(0));
 	majorDim_=maxMajorDim_;
       }
       delete[] oldlength;
@@ -956,7 +1285,15 @@ CoinPackedMatrix::reverseOrderedCopyOf(const CoinPackedMatrix& rhs)
    }
    // first compute how long each major-dimension vector will be
    int * COIN_RESTRICT orthoLength = length_;
-   rhs.countOrthoLength(orthoLength);
+   BlockedTranspose * blocked = NULL;
+   if (useBlockedTranspose(size_, majorDim_)) {
+      blocked = new BlockedTranspose(rhs.start_, rhs.length_, rhs.index_,
+				     rhs.element_, rhs.majorDim_, size_,
+				     majorDim_);
+      blocked->countLengths(orthoLength);
+   } else {
+      rhs.countOrthoLength(orthoLength);
+   }
 
    start_[0] = 0;
    if (extraGap_ == 0) {
@@ -986,6 +1323,11 @@ CoinPackedMatrix::reverseOrderedCopyOf(const CoinPackedMatrix& rhs)
    // now insert the entries of matrix
    
    minorDim_ = rhs.majorDim_;
+   if (blocked) {
+      blocked->fill(start_, index_, element_);
+      delete blocked;
+      return;
+   }
    const CoinBigIndex * COIN_RESTRICT start = rhs.start_;
    const int * COIN_RESTRICT index = rhs.index_;
    const int * COIN_RESTRICT length = rhs.length_;
@@ -1815,18 +2157,281 @@ CoinPackedMatrix::deleteMinorVectors(const int numDel,
 //#############################################################################
 //#############################################################################
 
+// Kernels for the matrix times vector methods
+
+namespace {
+
+  /* Level of kernels: 0 scalar, 1 AVX2, 2 AVX-512.  Only dot products
+     (gathers) are vectorized, a gather/scatter version of y += x_i*a_i was
+     slower than the scalar loop */
+  int simdSupported()
+  {
+    int level = 0;
+#ifdef COIN_PACKED_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+      level = 1;
+      if (__builtin_cpu_supports("avx512f"))
+	level = 2;
+    }
+#endif
+    return level;
+  }
+
+  int maximumSimdLevel()
+  {
+    static const int level = simdSupported();
+    return level;
+  }
+
+  // -1 until set, then best supported
+  int simdLevel_ = -1;
+
+  /* Returns sum of element[j]*x[index[j]] for j in [first,last) */
+  typedef double (*DotKernel)(const int *index, const double *element,
+			      CoinBigIndex first, CoinBigIndex last,
+			      const double *x);
+
+  double dotScalar(const int *index, const double *element,
+		   CoinBigIndex first, CoinBigIndex last, const double *x)
+  {
+    double value = 0.0;
+    for (CoinBigIndex j = first; j < last; ++j)
+      value += x[index[j]] * element[j];
+    return value;
+  }
+
+#ifdef COIN_PACKED_SIMD
+  __attribute__((target("avx2,fma")))
+  double dotAvx2(const int *index, const double *element,
+		 CoinBigIndex first, CoinBigIndex last, const double *x)
+  {
+    // short vectors are not worth it
+    if (last - first < 8)
+      return dotScalar(index, element, first, last, x);
+    __m256d sum0 = _mm256_setzero_pd();
+    __m256d sum1 = _mm256_setzero_pd();
+    CoinBigIndex j = first;
+    for (; j + 8 <= last; j += 8) {
+      __m128i index0 =
+	_mm_loadu_si128(reinterpret_cast<const __m128i *>(index + j));
+      __m128i index1 =
+	_mm_loadu_si128(reinterpret_cast<const __m128i *>(index + j + 4));
+      sum0 = _mm256_fmadd_pd(_mm256_i32gather_pd(x, index0, 8),
+			     _mm256_loadu_pd(element + j), sum0);
+      sum1 = _mm256_fmadd_pd(_mm256_i32gather_pd(x, index1, 8),
+			     _mm256_loadu_pd(element + j + 4), sum1);
+    }
+    if (j + 4 <= last) {
+      __m128i index0 =
+	_mm_loadu_si128(reinterpret_cast<const __m128i *>(index + j));
+      sum0 = _mm256_fmadd_pd(_mm256_i32gather_pd(x, index0, 8),
+			     _mm256_loadu_pd(element + j), sum0);
+      j += 4;
+    }
+    sum0 = _mm256_add_pd(sum0, sum1);
+    __m128d half = _mm_add_pd(_mm256_castpd256_pd128(sum0),
+			      _mm256_extractf128_pd(sum0, 1));
+    double value = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    for (; j < last; ++j)
+      value += x[index[j]] * element[j];
+    return value;
+  }
+
+  __attribute__((target("avx512f")))
+  double dotAvx512(const int *index, const double *element,
+		   CoinBigIndex first, CoinBigIndex last, const double *x)
+  {
+    if (last - first < 8)
+      return dotScalar(index, element, first, last, x);
+    __m512d sum0 = _mm512_setzero_pd();
+    __m512d sum1 = _mm512_setzero_pd();
+    CoinBigIndex j = first;
+    for (; j + 16 <= last; j += 16) {
+      __m512i index01 =
+	_mm512_loadu_si512(reinterpret_cast<const void *>(index + j));
+      sum0 = _mm512_fmadd_pd(_mm512_i32gather_pd(
+			       _mm512_castsi512_si256(index01), x, 8),
+			     _mm512_loadu_pd(element + j), sum0);
+      sum1 = _mm512_fmadd_pd(_mm512_i32gather_pd(
+			       _mm512_extracti64x4_epi64(index01, 1), x, 8),
+			     _mm512_loadu_pd(element + j + 8), sum1);
+    }
+    if (j < last) {
+      // rest with masks
+      int n = static_cast<int>(last - j);
+      if (n > 8) {
+	__m256i index0 =
+	  _mm256_loadu_si256(reinterpret_cast<const __m256i *>(index + j));
+	sum0 = _mm512_fmadd_pd(_mm512_i32gather_pd(index0, x, 8),
+			       _mm512_loadu_pd(element + j), sum0);
+	j += 8;
+	n -= 8;
+      }
+      __mmask8 mask = static_cast<__mmask8>((1u << n) - 1);
+      __m256i index0 = _mm512_castsi512_si256(
+	_mm512_maskz_loadu_epi32(static_cast<__mmask16>(mask), index + j));
+      __m512d value = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), mask,
+					       index0, x, 8);
+      sum1 = _mm512_fmadd_pd(value, _mm512_maskz_loadu_pd(mask, element + j),
+			     sum1);
+    }
+    return _mm512_reduce_add_pd(_mm512_add_pd(sum0, sum1));
+  }
+#endif
+
+  DotKernel dotKernel(int level)
+  {
+#ifdef COIN_PACKED_SIMD
+    if (level == 2)
+      return dotAvx512;
+    else if (level == 1)
+      return dotAvx2;
+#endif
+    return dotScalar;
+  }
+
+  int currentSimdLevel()
+  {
+    return simdLevel_ < 0 ? maximumSimdLevel() : simdLevel_;
+  }
+
+  /* A range of major vectors times a dense vector.  If scatter the result
+     is A*x (y has minorDim entries), otherwise y[i] is the dot product
+     of major vector i with x */
+  struct TimesBlock {
+    const CoinBigIndex *start;
+    const int *length;
+    const int *index;
+    const double *element;
+    int firstMajor;
+    int lastMajor;
+    int minorDim;
+    bool scatter;
+    int level;
+    const double *x;
+    double *y;
+    void run();
+  };
+
+  void TimesBlock::run()
+  {
+    if (scatter) {
+      memset(y, 0, minorDim * sizeof(double));
+      for (int i = lastMajor - 1; i >= firstMajor; --i) {
+	const double x_i = x[i];
+	if (x_i != 0.0) {
+	  const CoinBigIndex last = start[i] + length[i];
+	  for (CoinBigIndex j = start[i]; j < last; ++j)
+	    y[index[j]] += x_i * element[j];
+	}
+      }
+    } else {
+      DotKernel kernel = dotKernel(level);
+      for (int i = lastMajor - 1; i >= firstMajor; --i) {
+	const CoinBigIndex last = start[i] + length[i];
+	if (length[i] >= 8) {
+	  y[i] = kernel(index, element, start[i], last, x);
+	} else {
+	  double y_i = 0.0;
+	  for (CoinBigIndex j = start[i]; j < last; ++j)
+	    y_i += x[index[j]] * element[j];
+	  y[i] = y_i;
+	}
+      }
+    }
+  }
+
+  /* Does whole matrix in blocks with about the same number of elements,
+     in parallel if allowed.  With scatter every block but the first has
+     its own result which is then added in */
+  void timesBlocks(TimesBlock block, int majorDim, CoinBigIndex size)
+  {
+    int number = numberBlocks(size);
+    if (number == 1) {
+      block.firstMajor = 0;
+      block.lastMajor = majorDim;
+      block.run();
+      return;
+    }
+    std::vector<int> first;
+    splitByWeight(block.length, majorDim, size, number, first);
+    std::vector<TimesBlock> blocks(number, block);
+    std::vector<double> work;
+    if (block.scatter)
+      work.resize(static_cast<size_t>(number - 1) * block.minorDim);
+    for (int i = 0; i < number; i++) {
+      blocks[i].firstMajor = first[i];
+      blocks[i].lastMajor = first[i + 1];
+      if (i && block.scatter)
+	blocks[i].y = &work[static_cast<size_t>(i - 1) * block.minorDim];
+    }
+    runTasks(blocks);
+    if (block.scatter) {
+      double *y = block.y;
+      for (int i = 1; i < number; i++) {
+	const double *other = blocks[i].y;
+	for (int k = 0; k < block.minorDim; k++)
+	  y[k] += other[k];
+      }
+    }
+  }
+
+}
+
+int
+CoinPackedMatrix::setSimdLevel(int level)
+{
+  simdLevel_ = CoinMax(0, CoinMin(level, maximumSimdLevel()));
+  return simdLevel_;
+}
+
+int
+CoinPackedMatrix::simdLevel()
+{
+  return currentSimdLevel();
+}
+
+void
+CoinPackedMatrix::setNumberThreads(int number)
+{
+  numberThreads_ = CoinMax(1, number);
+}
+
+int
+CoinPackedMatrix::numberThreads()
+{
+  return numberThreads_;
+}
+
+void
+CoinPackedMatrix::setBlockedTransposeSize(CoinBigIndex size)
+{
+  blockedTransposeSize_ = CoinMax(static_cast<CoinBigIndex>(0), size);
+}
+
+CoinBigIndex
+CoinPackedMatrix::blockedTransposeSize()
+{
+  return blockedTransposeSize_;
+}
+
+//-----------------------------------------------------------------------------
+
 void
 CoinPackedMatrix::timesMajor(const double * x, double * y) const 
 {
-   memset(y, 0, minorDim_ * sizeof(double));
-   for (int i = majorDim_ - 1; i >= 0; --i) {
-      const double x_i = x[i];
-      if (x_i != 0.0) {
-	 const CoinBigIndex last = getVectorLast(i);
-	 for (CoinBigIndex j = getVectorFirst(i); j < last; ++j)
-	    y[index_[j]] += x_i * element_[j];
-      }
-   }
+   TimesBlock block;
+   block.start = start_;
+   block.length = length_;
+   block.index = index_;
+   block.element = element_;
+   block.minorDim = minorDim_;
+   block.scatter = true;
+   block.level = currentSimdLevel();
+   block.x = x;
+   block.y = y;
+   timesBlocks(block, majorDim_, size_);
 }
 
 //-----------------------------------------------------------------------------
@@ -1851,14 +2456,17 @@ CoinPackedMatrix::timesMajor(const CoinPackedVectorBase& x, double * y) const
 void
 CoinPackedMatrix::timesMinor(const double * x, double * y) const 
 {
-   memset(y, 0, majorDim_ * sizeof(double));
-   for (int i = majorDim_ - 1; i >= 0; --i) {
-      double y_i = 0;
-      const CoinBigIndex last = getVectorLast(i);
-      for (CoinBigIndex j = getVectorFirst(i); j < last; ++j)
-	 y_i += x[index_[j]] * element_[j];
-      y[i] = y_i;
-   }
+   TimesBlock block;
+   block.start = start_;
+   block.length = length_;
+   block.index = index_;
+   block.element = element_;
+   block.minorDim = minorDim_;
+   block.scatter = false;
+   block.level = currentSimdLevel();
+   block.x = x;
+   block.y = y;
+   timesBlocks(block, majorDim_, size_);
 }
 
 //-----------------------------------------------------------------------------
@@ -1866,14 +2474,21 @@ CoinPackedMatrix::timesMinor(const double * x, double * y) const
 void
 CoinPackedMatrix::timesMinor(const CoinPackedVectorBase& x, double * y) const 
 {
-   memset(y, 0, majorDim_ * sizeof(double));
-   for (int i = majorDim_ - 1; i >= 0; --i) {
-      double y_i = 0;
-      const CoinBigIndex last = getVectorLast(i);
-      for (CoinBigIndex j = getVectorFirst(i); j < last; ++j)
-	 y_i += x[index_[j]] * element_[j];
-      y[i] = y_i;
+   // same checks as x[]
+   x.duplicateIndex("timesMinor", "CoinPackedMatrix");
+   // expand x, entries outside matrix are never used
+   std::vector<double> dense(minorDim_, 0.0);
+   const int * xIndex = x.getIndices();
+   const double * xElement = x.getElements();
+   for (CoinBigIndex i = x.getNumElements() - 1; i >= 0; --i) {
+      const int ind = xIndex[i];
+      if (ind >= 0 && ind < minorDim_)
+	 dense[ind] = xElement[i];
    }
+   if (minorDim_)
+      timesMinor(&dense[0], y);
+   else
+      memset(y, 0, majorDim_ * sizeof(double));
 }
 #endif
 //#############################################################################
@@ -2292,16 +2907,25 @@ CoinPackedMatrix::CoinPackedMatrix(const CoinPackedMatrix& rhs, int extraForMajo
     minorDim_ = rhs.majorDim_;
     majorDim_ = rhs.minorDim_;
     maxMajorDim_ = majorDim_ + extraForMajor;
-    maxSize_ = CoinMax(size_ + extraElements,1);
+    maxSize_ = CoinMax(size_ + extraElements,static_cast<CoinBigIndex>(1));
     assert (maxMajorDim_>0);
     length_ = new int[maxMajorDim_];
     start_ = new CoinBigIndex[maxMajorDim_+1];
     element_ = new double[maxSize_];
     index_ = new int[maxSize_];
+    BlockedTranspose * blocked = NULL;
+    if (useBlockedTranspose(size_, majorDim_)) {
+      blocked = new BlockedTranspose(rhs.start_, rhs.length_, rhs.index_,
+				     rhs.element_, rhs.majorDim_, size_,
+				     majorDim_);
+      blocked->countLengths(length_);
+    }
     bool hasGaps = rhs.size_<rhs.start_[rhs.majorDim_];
-    CoinZeroN(length_, majorDim_);
     int i;
-    if (hasGaps) {
+    if (blocked) {
+      // already counted
+    } else if (hasGaps) {
+      CoinZeroN(length_, majorDim_);
       // has gaps
       for (i = 0; i <rhs.majorDim_ ; ++i) {
 	const CoinBigIndex first = rhs.start_[i];
@@ -2313,6 +2937,7 @@ CoinPackedMatrix::CoinPackedMatrix(const CoinPackedMatrix& rhs, int extraForMajo
       }
     } else {
       // no gaps 
+      CoinZeroN(length_, majorDim_);
       const CoinBigIndex last = rhs.start_[rhs.majorDim_];
       for (CoinBigIndex j = 0; j < last; ++j) {
        assert( rhs.index_[j] < rhs.minorDim_ && rhs.index_[j]>=0);
@@ -2327,6 +2952,11 @@ CoinPackedMatrix::CoinPackedMatrix(const CoinPackedMatrix& rhs, int extraForMajo
     }
     start_[majorDim_]=size;
     assert (size==size_);
+    if (blocked) {
+      blocked->fill(start_, index_, element_);
+      delete blocked;
+      return;
+    }
     for (i = 0; i <rhs.majorDim_ ; ++i) {
       const CoinBigIndex first = rhs.start_[i];
       const CoinBigIndex last = first + rhs.length_[i];
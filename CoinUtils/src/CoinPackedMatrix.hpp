@@ -434,6 +434,18 @@ public:
     */
     void reverseOrdering();
 
+    /** Sets the number of elements from which #reverseOrdering,
+        #reverseOrderedCopyOf and the reverse ordering copy constructor
+        use a blocked counting sort, for all matrices.  It keeps write
+        positions in cache and runs in parallel with #setNumberThreads,
+        but needs 16 bytes of work space per element.  On one thread it
+        is only used for at least 500000 new major vectors, with fewer
+        the serial code is faster.  0 always uses it.  The result is the
+        same as that of the serial code.  The default is 1000000. */
+    static void setBlockedTransposeSize(CoinBigIndex size);
+    /// Number of elements from which reverse ordering is blocked
+    static CoinBigIndex blockedTransposeSize();
+
     /*! \brief Transpose the matrix.
 
         \note
@@ -471,6 +483,24 @@ public:
         method, just <code>x</code> is given in the form of a packed vector. */
     void transposeTimes(const CoinPackedVectorBase& x, double * y) const;
 #endif
+    /** Sets the kernels used by the matrix times vector methods, for all
+        matrices: 0 scalar, 1 AVX2, 2 AVX-512.  A level the processor does
+        not support is lowered.  The default is the best supported level.
+        Only products made of dot products with major vectors are
+        vectorized (transposeTimes of a column ordered matrix, times of a
+        row ordered one).  They add up in another order, so results may
+        differ from scalar ones in the last bits.  Returns the level set. */
+    static int setSimdLevel(int level);
+    /// Level of kernels used by the matrix times vector methods
+    static int simdLevel();
+    /** Sets the number of threads the matrix times vector methods and
+        reverse ordering (see #setBlockedTransposeSize) may use, for all
+        matrices.  Only products with a dense <code>x</code> on matrices
+        with at least 200000 elements are split, and only if CoinUtils was
+        configured with --enable-coinutils-threads.  The default is 1. */
+    static void setNumberThreads(int number);
+    /// Number of threads the matrix methods may use
+    static int numberThreads();
   //@}
 
   //---------------------------------------------------------------------------
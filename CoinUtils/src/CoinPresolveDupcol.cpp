@@ -69,7 +69,7 @@ namespace {	// begin unnamed file-local namespace
 
 
 void create_col (int col, int n, double *els,
-		 CoinBigIndex *mcstrt, double *colels, int *hrow, int *link,
+		 CoinBigIndex *mcstrt, double *colels, int *hrow, CoinBigIndex *link,
 		 CoinBigIndex *free_listp)
 {
   int *rows = reinterpret_cast<int *>(els+n) ;
@@ -787,7 +787,7 @@ void dupcol_action::postsolve(CoinPostsolveMatrix *prob) const
   int *hrow		= prob->hrow_;
   CoinBigIndex *mcstrt		= prob->mcstrt_;
   int *hincol		= prob->hincol_;
-  int *link		= prob->link_;
+  CoinBigIndex *link	= prob->link_;
 
   double *rcosts	= prob->rcosts_;
   double tolerance = prob->ztolzb_;
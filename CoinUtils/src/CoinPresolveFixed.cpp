@@ -97,7 +97,7 @@ const remove_fixed_action*
   int actsize=0;
   // faster to do all deletes in row copy at once
   int nrows		= prob->nrows_;
-  CoinBigIndex * rstrt = new int[nrows+1];
+  CoinBigIndex * rstrt = new CoinBigIndex[nrows+1];
   CoinZeroN(rstrt,nrows);
 /*
   Open a loop to excise each column a<j>. The first thing to do is load the
@@ -305,7 +305,7 @@ void remove_fixed_action::postsolve(CoinPostsolveMatrix *prob) const
   int *hrow		= prob->hrow_;
   CoinBigIndex *mcstrt	= prob->mcstrt_;
   int *hincol		= prob->hincol_;
-  int *link		= prob->link_;
+  CoinBigIndex *link	= prob->link_;
   CoinBigIndex &free_list = prob->free_list_;
 
   double *clo	= prob->clo_;
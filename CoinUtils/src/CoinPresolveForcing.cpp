@@ -489,7 +489,7 @@ void forcing_constraint_action::postsolve(CoinPostsolveMatrix *prob) const
   const int *hrow		= prob->hrow_;
   const CoinBigIndex *mcstrt		= prob->mcstrt_;
   const int *hincol		= prob->hincol_;
-  const int *link		= prob->link_;
+  const CoinBigIndex *link	= prob->link_;
 
   //  CoinBigIndex free_list = prob->free_list_;
 
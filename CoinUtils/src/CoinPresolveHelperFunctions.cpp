@@ -403,7 +403,7 @@ void presolve_delete_many_from_major (int majndx, char * marked,
 */
 void presolve_delete_from_major2 (int majndx, int minndx,
 				  CoinBigIndex *majstrts, int *majlens,
-				  int *minndxs, /*double *els,*/ int *majlinks, 
+				  int *minndxs, /*double *els,*/ CoinBigIndex *majlinks, 
 				  CoinBigIndex *free_listp)
 
 { CoinBigIndex k = majstrts[majndx] ;
@@ -1575,7 +1575,7 @@ void implied_free_action::postsolve(CoinPostsolveMatrix *prob) const
   int *hrow		= prob->hrow_;
   CoinBigIndex *columnStart		= prob->mcstrt_;
   int *numberInColumn		= prob->hincol_;
-  int *link		= prob->link_;
+  CoinBigIndex *link	= prob->link_;
 
   double *clo	= prob->clo_;
   double *cup	= prob->cup_;
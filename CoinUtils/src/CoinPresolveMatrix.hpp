@@ -1413,7 +1413,7 @@ class CoinPostsolveMatrix : public CoinPrePostsolveMatrix
   /*! \brief First entry in free entries thread */
   CoinBigIndex free_list_;
   /// Allocated size of #link_
-  int maxlink_;
+  CoinBigIndex maxlink_;
   /*! \brief Thread array
 
     Within a thread, link_[k] points to the next entry in the thread.
@@ -1699,7 +1699,7 @@ inline void presolve_delete_from_row(int row, int col,
 */
 void presolve_delete_from_major2 (int majndx, int minndx,
 				  CoinBigIndex *majstrts, int *majlens,
-				  int *minndxs, /*double *els,*/ int *majlinks,
+				  int *minndxs, /*double *els,*/ CoinBigIndex *majlinks,
 				   CoinBigIndex *free_listp) ;
 
 /*! \relates CoinPostsolveMatrix
@@ -1714,7 +1714,7 @@ void presolve_delete_from_major2 (int majndx, int minndx,
 */
 inline void presolve_delete_from_col2(int row, int col, CoinBigIndex *mcstrt,
 				      int *hincol, int *hrow,
-				      /*double *colels,*/ int *clinks,
+				      /*double *colels,*/ CoinBigIndex *clinks,
 				      CoinBigIndex *free_listp)
 { presolve_delete_from_major2(col,row,mcstrt,hincol,hrow,/*colels,*/clinks,
 			      free_listp) ; }
@@ -807,7 +807,7 @@ void presolve_check_sol (const CoinPostsolveMatrix *postObj,
   int *hrow = postObj->hrow_ ;
   int *mcstrt = postObj->mcstrt_ ;
   int *hincol = postObj->hincol_ ;
-  int *link = postObj->link_ ;
+  CoinBigIndex *link = postObj->link_ ;
 
   int n	= postObj->ncols_ ;
   int m = postObj->nrows_ ;
@@ -323,7 +323,7 @@ void slack_doubleton_action::postsolve(CoinPostsolveMatrix *prob) const
   int *hrow		= prob->hrow_;
   CoinBigIndex *mcstrt		= prob->mcstrt_;
   int *hincol		= prob->hincol_;
-  int *link		= prob->link_;
+  CoinBigIndex *link	= prob->link_;
   //  int ncols		= prob->ncols_;
 
   double *clo		= prob->clo_;
@@ -748,7 +748,7 @@ void slack_singleton_action::postsolve(CoinPostsolveMatrix *prob) const
   int *hrow		= prob->hrow_;
   CoinBigIndex *mcstrt		= prob->mcstrt_;
   int *hincol		= prob->hincol_;
-  int *link		= prob->link_;
+  CoinBigIndex *link	= prob->link_;
   //  int ncols		= prob->ncols_;
 
   //double *rowels	= prob->rowels_;
@@ -28,7 +28,7 @@ inline void prepend_elem(int jcol, double coeff, int irow,
 		    CoinBigIndex *mcstrt,
 		    double *colels,
 		    int *hrow,
-		    int *link, CoinBigIndex *free_listp)
+		    CoinBigIndex *link, CoinBigIndex *free_listp)
 {
   CoinBigIndex kk = *free_listp;
   assert(kk >= 0) ;
@@ -899,7 +899,7 @@ void subst_constraint_action::postsolve(CoinPostsolveMatrix *prob) const
   int *hrow		= prob->hrow_;
   CoinBigIndex *mcstrt		= prob->mcstrt_;
   int *hincol		= prob->hincol_;
-  int *link		= prob->link_;
+  CoinBigIndex *link	= prob->link_;
   //  int ncols		= prob->ncols_;
 
   double *rlo	= prob->rlo_;
@@ -317,7 +317,7 @@ void do_tighten_action::postsolve(CoinPostsolveMatrix *prob) const
   int *hrow		= prob->hrow_;
   CoinBigIndex *mcstrt		= prob->mcstrt_;
   int *hincol		= prob->hincol_;
-  int *link		= prob->link_;
+  CoinBigIndex *link	= prob->link_;
   //  int ncols		= prob->ncols_;
 
   double *clo	= prob->clo_;
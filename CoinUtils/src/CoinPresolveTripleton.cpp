@@ -660,7 +660,7 @@ void tripleton_action::postsolve(CoinPostsolveMatrix *prob) const
   int *hrow		= prob->hrow_;
   CoinBigIndex *mcstrt		= prob->mcstrt_;
   int *hincol		= prob->hincol_;
-  int *link		= prob->link_;
+  CoinBigIndex *link	= prob->link_;
 
   double *clo	= prob->clo_;
   double *cup	= prob->cup_;
@@ -12,6 +12,9 @@
     If COIN_EXTERN_C defined then an extra extern C
 */
 
+/* for COIN_BIG_INDEX */
+#include "CoinUtilsConfig.h"
+
 #if defined (CLP_EXTERN_C)
 #define COIN_EXTERN_C
 #define COIN_NO_SBB
@@ -37,3 +37,6 @@
 # define COIN_UINT64_T unsigned long long
 # define COIN_INTPTR_T int*
 #endif
+
+/* Define to 1 (long) or 2 (long long) for a 64 bit CoinBigIndex */
+/* #define COIN_BIG_INDEX 2 */
@@ -12,8 +12,12 @@
 #endif
 
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <vector>
 
 #include "CoinMpsIO.hpp"
+#include "CoinBinaryModel.hpp"
 #include "CoinFloatEqual.hpp"
 
 //#############################################################################
@@ -158,7 +162,118 @@ CoinMpsIOUnitTest(const std::string & mpsDir)
       assert( eq( dumSi.getObjCoefficients()[6],  0.0) );
       assert( eq( dumSi.getObjCoefficients()[7], -1.0) );
     }
-    
+
+    // Read both files again, parsing ahead in chunks, and compare
+    {
+      std::string files[2] = {fn, "CoinMpsIoTest"};
+      for (int k=0; k<2; k++) {
+        CoinMpsIO serial;
+        numErr = serial.readMps(files[k].c_str(),"mps");
+        assert( numErr == 0 );
+        CoinMpsIO parallel;
+        parallel.setNumberReadThreads(3);
+        numErr = parallel.readMps(files[k].c_str(),"mps");
+        assert( numErr == 0 );
+        int nc = serial.getNumCols();
+        int nr = serial.getNumRows();
+        assert( parallel.getNumCols() == nc );
+        assert( parallel.getNumRows() == nr );
+        assert( parallel.getNumElements() == serial.getNumElements() );
+        assert( !memcmp(parallel.getColLower(),serial.getColLower(),
+                        nc*sizeof(double)) );
+        assert( !memcmp(parallel.getColUpper(),serial.getColUpper(),
+                        nc*sizeof(double)) );
+        assert( !memcmp(parallel.getObjCoefficients(),
+                        serial.getObjCoefficients(),nc*sizeof(double)) );
+        assert( !memcmp(parallel.getRowLower(),serial.getRowLower(),
+                        nr*sizeof(double)) );
+        assert( !memcmp(parallel.getRowUpper(),serial.getRowUpper(),
+                        nr*sizeof(double)) );
+        for (int i=0; i<nc; i++) {
+          assert( parallel.isInteger(i) == serial.isInteger(i) );
+          assert( !strcmp(parallel.columnName(i),serial.columnName(i)) );
+        }
+        for (int i=0; i<nr; i++)
+          assert( !strcmp(parallel.rowName(i),serial.rowName(i)) );
+        const CoinPackedMatrix * pm = parallel.getMatrixByCol();
+        const CoinPackedMatrix * sm = serial.getMatrixByCol();
+        int ne = sm->getNumElements();
+        assert( pm->getNumElements() == ne );
+        assert( !memcmp(pm->getVectorStarts(),sm->getVectorStarts(),
+                        (nc+1)*sizeof(CoinBigIndex)) );
+        assert( !memcmp(pm->getIndices(),sm->getIndices(),ne*sizeof(int)) );
+        assert( !memcmp(pm->getElements(),sm->getElements(),
+                        ne*sizeof(double)) );
+      }
+    }
+
+    // Write a binary model, read it back and compare
+    {
+      numErr = m.writeBinary("CoinMpsIoTest.bin");
+      assert( numErr == 0 );
+      assert( CoinBinaryModel::isBinary("CoinMpsIoTest.bin") );
+      assert( !CoinBinaryModel::isBinary("CoinMpsIoTest.mps") );
+      CoinMpsIO binary;
+      numErr = binary.readBinary("CoinMpsIoTest.bin");
+      assert( numErr == 0 );
+      int nc = m.getNumCols();
+      int nr = m.getNumRows();
+      assert( binary.getNumCols() == nc );
+      assert( binary.getNumRows() == nr );
+      assert( !strcmp(binary.getProblemName(),m.getProblemName()) );
+      assert( !memcmp(binary.getColLower(),m.getColLower(),
+                      nc*sizeof(double)) );
+      assert( !memcmp(binary.getColUpper(),m.getColUpper(),
+                      nc*sizeof(double)) );
+      assert( !memcmp(binary.getObjCoefficients(),m.getObjCoefficients(),
+                      nc*sizeof(double)) );
+      assert( !memcmp(binary.getRowLower(),m.getRowLower(),
+                      nr*sizeof(double)) );
+      assert( !memcmp(binary.getRowUpper(),m.getRowUpper(),
+                      nr*sizeof(double)) );
+      for (int i=0; i<nc; i++) {
+        assert( binary.isInteger(i) == m.isInteger(i) );
+        assert( !strcmp(binary.columnName(i),m.columnName(i)) );
+      }
+      for (int i=0; i<nr; i++)
+        assert( !strcmp(binary.rowName(i),m.rowName(i)) );
+      assert( binary.getMatrixByCol()->isEquivalent(*m.getMatrixByCol()) );
+
+      // A row index or a name start outside its section is rejected
+      std::vector<char> file;
+      FILE *fp = fopen("CoinMpsIoTest.bin","rb");
+      assert( fp );
+      char block[4096];
+      size_t n;
+      while ((n = fread(block,1,sizeof(block),fp)) > 0)
+        file.insert(file.end(),block,block+n);
+      fclose(fp);
+      // the sections follow the 9 fields of the header
+      const CoinInt64 *sections =
+        reinterpret_cast<const CoinInt64 *>(&file[9*8]);
+      const CoinInt64 patches[2][2] = {
+        {sections[2*1], nr},                   // first row index
+        {sections[2*11], sections[2*12+1]}     // first column name start
+      };
+      for (int k=0; k<2; k++) {
+        std::vector<char> bad(file);
+        if (k == 0) {
+          int value = static_cast<int>(patches[k][1]);
+          memcpy(&bad[patches[k][0]],&value,sizeof(int));
+        } else {
+          memcpy(&bad[patches[k][0]],&patches[k][1],sizeof(CoinInt64));
+        }
+        fp = fopen("CoinMpsIoTestBad.bin","wb");
+        assert( fp );
+        fwrite(&bad[0],1,bad.size(),fp);
+        fclose(fp);
+        CoinBinaryModel corrupt;
+        numErr = corrupt.read("CoinMpsIoTestBad.bin");
+        assert( numErr == -2 );
+      }
+      remove("CoinMpsIoTestBad.bin");
+    }
+
     // Test matrixByRow method
     { 
       const CoinMpsIO si(m);
@@ -0,0 +1,331 @@
+// $Id$
+// Copyright (C) 2012, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+// Benchmark for the matrix times vector methods and the reverse ordering
+// of CoinPackedMatrix, on synthetic matrices of a few typical shapes and
+// on any MPS files given.
+//
+// times: each matrix is multiplied by a dense x and by a sparse x (1%
+// nonzero) with times and transposeTimes, on the column ordered and on
+// the row ordered copy.  Every product is timed with scalar kernels, with
+// each vector level the processor has and, if more than one thread is
+// asked for, with the best level on that many threads.  The largest
+// difference from the scalar result (relative to the largest entry) is
+// printed too.
+//
+// transpose: the row ordered copy is made with reverseOrderedCopyOf and
+// with the reverse ordering copy constructor, by the serial code, blocked
+// and, if more than one thread is asked for, blocked on that many
+// threads.  Results are checked to be the same as the serial ones.
+//
+// Usage: packedMatrixBenchmark [times|transpose|all] [threads] [scale]
+//                              [file.mps ...]
+// scale 1 gives synthetic matrices of one to two million elements.
+
+#include "CoinUtilsConfig.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "CoinFinite.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinMpsIO.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinPackedVector.hpp"
+#include "CoinTime.hpp"
+
+namespace {
+
+  // Matrix with about perColumn random entries in each column
+  CoinPackedMatrix *synthetic(int numberRows, int numberColumns,
+			      int perColumn, CoinThreadRandom &random)
+  {
+    std::vector<CoinBigIndex> start(numberColumns + 1);
+    std::vector<int> row;
+    std::vector<double> element;
+    std::vector<char> used(numberRows, 0);
+    start[0] = 0;
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+      int length = 1 + static_cast<int>(random.randomDouble() * 2 * perColumn);
+      length = CoinMin(length, numberRows);
+      CoinBigIndex first = static_cast<CoinBigIndex>(row.size());
+      while (static_cast<int>(row.size() - first) < length) {
+	int iRow = static_cast<int>(random.randomDouble() * numberRows);
+	iRow = CoinMin(iRow, numberRows - 1);
+	if (!used[iRow]) {
+	  used[iRow] = 1;
+	  row.push_back(iRow);
+	  element.push_back(random.randomDouble() * 2.0 - 1.0);
+	}
+      }
+      for (CoinBigIndex j = first; j < static_cast<CoinBigIndex>(row.size()); j++)
+	used[row[j]] = 0;
+      start[iColumn + 1] = static_cast<CoinBigIndex>(row.size());
+    }
+    CoinPackedMatrix *matrix = new CoinPackedMatrix();
+    std::vector<int> length(numberColumns);
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+      length[iColumn] = static_cast<int>(start[iColumn + 1] - start[iColumn]);
+    matrix->copyOf(true, numberRows, numberColumns, start[numberColumns],
+		   &element[0], &row[0], &start[0], &length[0]);
+    return matrix;
+  }
+
+  enum Product { timesDense, transposeDense, timesSparse, transposeSparse };
+
+  void product(const CoinPackedMatrix &matrix, Product which,
+	       const std::vector<double> &x, const CoinPackedVector &xSparse,
+	       double *y)
+  {
+    switch (which) {
+    case timesDense:
+      matrix.times(&x[0], y);
+      break;
+    case transposeDense:
+      matrix.transposeTimes(&x[0], y);
+      break;
+    case timesSparse:
+      matrix.times(xSparse, y);
+      break;
+    case transposeSparse:
+      matrix.transposeTimes(xSparse, y);
+      break;
+    }
+  }
+
+  // Milliseconds per product, repeated for about a fifth of a second
+  double timeProduct(const CoinPackedMatrix &matrix, Product which,
+		     const std::vector<double> &x,
+		     const CoinPackedVector &xSparse, std::vector<double> &y)
+  {
+    product(matrix, which, x, xSparse, &y[0]);
+    int number = 0;
+    double start = CoinGetTimeOfDay();
+    double elapsed = 0.0;
+    while (elapsed < 0.2) {
+      product(matrix, which, x, xSparse, &y[0]);
+      number++;
+      elapsed = CoinGetTimeOfDay() - start;
+    }
+    return 1000.0 * elapsed / number;
+  }
+
+  void benchmark(const char *name, const CoinPackedMatrix &byColumn,
+		 int numberThreads, CoinThreadRandom &random)
+  {
+    const char *productName[] = { "times", "transposeTimes",
+				  "times(sparse)", "transposeTimes(sparse)" };
+    const char *levelName[] = { "scalar", "avx2", "avx512" };
+    CoinPackedMatrix byRow(byColumn, 0, 0, true);
+    const int maximumLevel = CoinPackedMatrix::setSimdLevel(2);
+    printf("%s: %d rows, %d columns, %ld elements\n", name,
+	   byColumn.getNumRows(), byColumn.getNumCols(),
+	   static_cast<long>(byColumn.getNumElements()));
+    for (int iCopy = 0; iCopy < 2; iCopy++) {
+      const CoinPackedMatrix &matrix = iCopy ? byRow : byColumn;
+      for (int iProduct = 0; iProduct < 4; iProduct++) {
+	Product which = static_cast<Product>(iProduct);
+	bool transpose = which == transposeDense || which == transposeSparse;
+	int xSize = transpose ? matrix.getNumRows() : matrix.getNumCols();
+	int ySize = transpose ? matrix.getNumCols() : matrix.getNumRows();
+	std::vector<double> x(xSize);
+	for (int i = 0; i < xSize; i++)
+	  x[i] = random.randomDouble();
+	CoinPackedVector xSparse;
+	for (int i = 0; i < xSize; i++) {
+	  if (random.randomDouble() < 0.01)
+	    xSparse.insert(i, x[i]);
+	}
+	std::vector<double> reference(ySize + 1);
+	std::vector<double> y(ySize + 1);
+	printf("  %-6s %-23s", iCopy ? "row" : "column", productName[iProduct]);
+	double scalarTime = 0.0;
+	for (int level = 0; level <= maximumLevel + 1; level++) {
+	  int threads = 1;
+	  if (level > maximumLevel) {
+	    if (numberThreads < 2)
+	      break;
+	    threads = numberThreads;
+	  }
+	  CoinPackedMatrix::setSimdLevel(CoinMin(level, maximumLevel));
+	  CoinPackedMatrix::setNumberThreads(threads);
+	  double time = timeProduct(matrix, which, x, xSparse,
+				    level ? y : reference);
+	  double difference = 0.0;
+	  double largest = 0.0;
+	  for (int i = 0; i < ySize; i++) {
+	    largest = CoinMax(largest, fabs(reference[i]));
+	    if (level)
+	      difference = CoinMax(difference, fabs(y[i] - reference[i]));
+	  }
+	  if (!level)
+	    scalarTime = time;
+	  if (threads > 1)
+	    printf(" %s*%d", levelName[maximumLevel], threads);
+	  else
+	    printf(" %s", levelName[level]);
+	  printf(" %.3fms", time);
+	  if (level)
+	    printf(" (x%.2f, diff %.1e)", scalarTime / time,
+		   largest ? difference / largest : difference);
+	}
+	printf("\n");
+      }
+    }
+    CoinPackedMatrix::setSimdLevel(maximumLevel);
+    CoinPackedMatrix::setNumberThreads(1);
+    fflush(stdout);
+  }
+
+  bool sameMatrix(const CoinPackedMatrix &a, const CoinPackedMatrix &b)
+  {
+    if (a.isColOrdered() != b.isColOrdered() ||
+	a.getMajorDim() != b.getMajorDim() ||
+	a.getMinorDim() != b.getMinorDim() ||
+	a.getNumElements() != b.getNumElements())
+      return false;
+    for (int i = 0; i < a.getMajorDim(); i++) {
+      if (a.getVectorSize(i) != b.getVectorSize(i))
+	return false;
+      CoinBigIndex ja = a.getVectorFirst(i);
+      CoinBigIndex jb = b.getVectorFirst(i);
+      for (int k = 0; k < a.getVectorSize(i); k++) {
+	if (a.getIndices()[ja + k] != b.getIndices()[jb + k] ||
+	    a.getElements()[ja + k] != b.getElements()[jb + k])
+	  return false;
+      }
+    }
+    return true;
+  }
+
+  // Milliseconds per reverse ordering, repeated for about half a second
+  double timeTranspose(const CoinPackedMatrix &byColumn, bool constructor,
+		       CoinPackedMatrix &byRow)
+  {
+    int number = 0;
+    double start = CoinGetTimeOfDay();
+    double elapsed = 0.0;
+    while (elapsed < 0.5 || !number) {
+      if (constructor) {
+	CoinPackedMatrix copy(byColumn, 0, 0, true);
+	byRow.swap(copy);
+      } else {
+	byRow.reverseOrderedCopyOf(byColumn);
+      }
+      number++;
+      elapsed = CoinGetTimeOfDay() - start;
+    }
+    return 1000.0 * elapsed / number;
+  }
+
+  void benchmarkTranspose(const char *name, const CoinPackedMatrix &byColumn,
+			  int numberThreads)
+  {
+    const CoinBigIndex blockedSize = CoinPackedMatrix::blockedTransposeSize();
+    printf("%s: %d rows, %d columns, %ld elements\n", name,
+	   byColumn.getNumRows(), byColumn.getNumCols(),
+	   static_cast<long>(byColumn.getNumElements()));
+    for (int iWay = 0; iWay < 2; iWay++) {
+      printf("  %-21s", iWay ? "copy constructor" : "reverseOrderedCopyOf");
+      CoinPackedMatrix serial;
+      double serialTime = 0.0;
+      for (int iCase = 0; iCase < 3; iCase++) {
+	int threads = iCase == 2 ? numberThreads : 1;
+	if (iCase == 2 && numberThreads < 2)
+	  break;
+	CoinPackedMatrix::setBlockedTransposeSize(iCase ? 0 : COIN_INT_MAX);
+	CoinPackedMatrix::setNumberThreads(threads);
+	CoinPackedMatrix byRow;
+	double time = timeTranspose(byColumn, iWay != 0,
+				    iCase ? byRow : serial);
+	if (!iCase) {
+	  serialTime = time;
+	  printf(" serial %.2fms", time);
+	} else {
+	  if (threads > 1)
+	    printf(" blocked*%d", threads);
+	  else
+	    printf(" blocked");
+	  printf(" %.2fms (x%.2f%s)", time, serialTime / time,
+		 sameMatrix(serial, byRow) ? "" : ", DIFFERENT");
+	}
+      }
+      printf("\n");
+    }
+    CoinPackedMatrix::setBlockedTransposeSize(blockedSize);
+    CoinPackedMatrix::setNumberThreads(1);
+    fflush(stdout);
+  }
+
+}
+
+int main(int argc, const char *argv[])
+{
+  std::string what = argc > 1 ? argv[1] : "all";
+  bool doTimes = what == "times" || what == "all";
+  bool doTranspose = what == "transpose" || what == "all";
+  if (!doTimes && !doTranspose) {
+    printf("Usage: packedMatrixBenchmark [times|transpose|all] [threads] "
+	   "[scale] [file.mps ...]\n");
+    return 1;
+  }
+  int numberThreads = argc > 2 ? atoi(argv[2]) : 1;
+  double scale = argc > 3 ? atof(argv[3]) : 1.0;
+  CoinThreadRandom random(12345);
+  printf("vector level %d, threads %d%s\n", CoinPackedMatrix::simdLevel(),
+	 numberThreads,
+#ifdef COINUTILS_PTHREADS
+	 ""
+#else
+	 " (CoinUtils built without threads)"
+#endif
+	 );
+  struct Shape {
+    const char *name;
+    int numberRows;
+    int numberColumns;
+    int perColumn;
+  };
+  // lp like, long columns, long rows and nearly dense
+  const Shape shapes[] = {
+    { "sparse", 200000, 200000, 5 },
+    { "tall", 200000, 20000, 50 },
+    { "wide", 2000, 200000, 8 },
+    { "dense", 1500, 1500, 500 }
+  };
+  for (int i = 0; i < 4; i++) {
+    int numberRows = CoinMax(1, static_cast<int>(shapes[i].numberRows * scale));
+    int numberColumns =
+      CoinMax(1, static_cast<int>(shapes[i].numberColumns * scale));
+    CoinPackedMatrix *matrix = synthetic(numberRows, numberColumns,
+					 shapes[i].perColumn, random);
+    if (doTimes)
+      benchmark(shapes[i].name, *matrix, numberThreads, random);
+    if (doTranspose)
+      benchmarkTranspose(shapes[i].name, *matrix, numberThreads);
+    delete matrix;
+  }
+  for (int i = 4; i < argc; i++) {
+    CoinMpsIO reader;
+    reader.messageHandler()->setLogLevel(0);
+    if (reader.readMps(argv[i], "") < 0) {
+      printf("%s could not be read\n", argv[i]);
+      return 1;
+    }
+    std::string name = argv[i];
+    size_t slash = name.find_last_of('/');
+    if (slash != std::string::npos)
+      name = name.substr(slash + 1);
+    if (doTimes)
+      benchmark(name.c_str(), *reader.getMatrixByCol(), numberThreads,
+		random);
+    if (doTranspose)
+      benchmarkTranspose(name.c_str(), *reader.getMatrixByCol(),
+			 numberThreads);
+  }
+  return 0;
+}
@@ -12,7 +12,9 @@
 #endif
 
 #include <cassert>
+#include <vector>
 
+#include "CoinFinite.hpp"
 #include "CoinFloatEqual.hpp"
 #include "CoinPackedVector.hpp"
 #include "CoinPackedMatrix.hpp"
@@ -628,6 +630,141 @@ CoinPackedMatrixUnitTest()
     
     delete globalP;
   }
+
+  {
+    // times and transposeTimes with every kernel level, also with
+    // threads (matrix has enough elements to be split)
+    const int numberRows = 300;
+    const int numberColumns = 2000;
+    std::vector<CoinBigIndex> start(numberColumns+1);
+    std::vector<int> row;
+    std::vector<double> element;
+    start[0] = 0;
+    for (int i = 0; i < numberColumns; i++) {
+      int length = 1 + (i*37)%(numberRows-1);
+      for (int k = 0; k < length; k++) {
+        row.push_back((i+k*7)%numberRows);
+        element.push_back(1.0+((i+k)%11)*0.125);
+      }
+      start[i+1] = static_cast<CoinBigIndex>(row.size());
+    }
+    CoinPackedMatrix byColumn(true, numberRows, numberColumns,
+                              start[numberColumns], &element[0], &row[0],
+                              &start[0], NULL);
+    CoinPackedMatrix byRow(byColumn, 0, 0, true);
+    std::vector<double> x(numberColumns), u(numberRows);
+    for (int i = 0; i < numberColumns; i++)
+      x[i] = (i%5) ? 0.5*(i%13) : 0.0;
+    for (int i = 0; i < numberRows; i++)
+      u[i] = 0.25*(i%7)-0.5;
+    CoinPackedVector xPacked, uPacked;
+    for (int i = 0; i < numberColumns; i += 3)
+      xPacked.insert(i, x[i]);
+    for (int i = 0; i < numberRows; i += 3)
+      uPacked.insert(i, u[i]);
+    // reference results
+    std::vector<double> ax(numberRows, 0.0), ua(numberColumns, 0.0);
+    std::vector<double> axPacked(numberRows, 0.0), uaPacked(numberColumns, 0.0);
+    for (int i = 0; i < numberColumns; i++) {
+      for (CoinBigIndex j = start[i]; j < start[i+1]; j++) {
+        ax[row[j]] += x[i]*element[j];
+        if (i%3 == 0)
+          axPacked[row[j]] += x[i]*element[j];
+        ua[i] += u[row[j]]*element[j];
+        if (row[j]%3 == 0)
+          uaPacked[i] += u[row[j]]*element[j];
+      }
+    }
+    CoinAbsFltEq near(1.0e-10);
+    const int maximumLevel = CoinPackedMatrix::setSimdLevel(2);
+    for (int level = 0; level <= maximumLevel; level++) {
+      for (int threads = 1; threads <= 4; threads += 3) {
+        assert( CoinPackedMatrix::setSimdLevel(level) == level );
+        CoinPackedMatrix::setNumberThreads(threads);
+        for (int iCopy = 0; iCopy < 2; iCopy++) {
+          const CoinPackedMatrix & m = iCopy ? byRow : byColumn;
+          std::vector<double> y(numberRows), z(numberColumns);
+          m.times(&x[0], &y[0]);
+          m.transposeTimes(&u[0], &z[0]);
+          for (int i = 0; i < numberRows; i++)
+            assert( near(y[i], ax[i]) );
+          for (int i = 0; i < numberColumns; i++)
+            assert( near(z[i], ua[i]) );
+          m.times(xPacked, &y[0]);
+          m.transposeTimes(uPacked, &z[0]);
+          for (int i = 0; i < numberRows; i++)
+            assert( near(y[i], axPacked[i]) );
+          for (int i = 0; i < numberColumns; i++)
+            assert( near(z[i], uaPacked[i]) );
+        }
+      }
+    }
+    CoinPackedMatrix::setSimdLevel(maximumLevel);
+    CoinPackedMatrix::setNumberThreads(1);
+  }
+
+  {
+    // blocked reverse ordering (forced), also with threads and gaps,
+    // must give the same as the serial code
+    const int numberRows = 700;
+    const int numberColumns = 1500;
+    std::vector<CoinBigIndex> start(numberColumns+1);
+    std::vector<int> length(numberColumns);
+    std::vector<int> row;
+    std::vector<double> element;
+    CoinBigIndex numberElements = 0;
+    start[0] = 0;
+    for (int i = 0; i < numberColumns; i++) {
+      int fullLength = 1 + (i*53)%(numberRows-1);
+      for (int k = 0; k < fullLength; k++) {
+        row.push_back((i+k*3)%numberRows);
+        element.push_back(i+0.001*k);
+      }
+      // every third column has a gap
+      length[i] = (i%3) ? fullLength : fullLength/2;
+      numberElements += length[i];
+      start[i+1] = static_cast<CoinBigIndex>(row.size());
+    }
+    CoinPackedMatrix byColumn(true, numberRows, numberColumns,
+                              numberElements, &element[0], &row[0],
+                              &start[0], &length[0]);
+    const CoinBigIndex blockedSize = CoinPackedMatrix::blockedTransposeSize();
+    CoinPackedMatrix::setBlockedTransposeSize(COIN_INT_MAX);
+    CoinPackedMatrix serial(byColumn, 0, 0, true);
+    for (int threads = 1; threads <= 4; threads += 3) {
+      CoinPackedMatrix::setBlockedTransposeSize(0);
+      CoinPackedMatrix::setNumberThreads(threads);
+      CoinPackedMatrix blocked(byColumn, 0, 0, true);
+      CoinPackedMatrix blocked2;
+      blocked2.setExtraGap(0.5);
+      blocked2.reverseOrderedCopyOf(byColumn);
+      CoinPackedMatrix blocked3(byColumn);
+      blocked3.reverseOrdering();
+      assert( !blocked.isColOrdered() );
+      assert( blocked.getNumElements() == serial.getNumElements() );
+      assert( blocked2.getNumElements() == serial.getNumElements() );
+      assert( blocked3.getNumElements() == serial.getNumElements() );
+      for (int i = 0; i < numberRows; i++) {
+        const CoinShallowPackedVector a = serial.getVector(i);
+        const CoinShallowPackedVector b = blocked.getVector(i);
+        const CoinShallowPackedVector c = blocked2.getVector(i);
+        const CoinShallowPackedVector d = blocked3.getVector(i);
+        assert( a.getNumElements() == b.getNumElements() );
+        assert( a.getNumElements() == c.getNumElements() );
+        assert( a.getNumElements() == d.getNumElements() );
+        for (int k = 0; k < a.getNumElements(); k++) {
+          assert( a.getIndices()[k] == b.getIndices()[k] );
+          assert( a.getIndices()[k] == c.getIndices()[k] );
+          assert( a.getIndices()[k] == d.getIndices()[k] );
+          assert( a.getElements()[k] == b.getElements()[k] );
+          assert( a.getElements()[k] == c.getElements()[k] );
+          assert( a.getElements()[k] == d.getElements()[k] );
+        }
+      }
+    }
+    CoinPackedMatrix::setBlockedTransposeSize(blockedSize);
+    CoinPackedMatrix::setNumberThreads(1);
+  }
   
 #if 0
   {
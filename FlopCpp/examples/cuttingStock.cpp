@@ -3,7 +3,6 @@
 using namespace flopc;
 using namespace std;
 #include <OsiCbcSolverInterface.hpp>
-#include <CoinPackedVector.hpp>
 
 class Paper : public MP_model {
 public:
@@ -94,10 +93,11 @@ int main() {
     do {
 	ob = knapsack(numWidths, tabWidth, &Paper.rowPrice[demC.offset], maxWidth, pat);
 
-	CoinPackedVector Pat;	
-	Pat.setFull(numWidths, pat);
-	
-	Paper->addCol(Pat,0,100,1);
+	MP_column column(1, 0, 100);
+	for (int i=0; i<numWidths; i++) {
+	    column.add(demC, pat[i], i);
+	}
+	Paper.addColumn(use, column);
 	Paper->resolve();
     } while(ob>1.0001);
 
@@ -0,0 +1,117 @@
+// $Id$
+#include "flopc.hpp"
+using namespace flopc;
+using namespace std;
+#include "OsiClpSolverInterface.hpp"
+
+/* The stochastic transportation problem of stochbenders.cpp, solved by
+MP_benders instead of a hand-written Benders loop.  The received
+quantities of the first stage appear in the second stage model, whose
+demands are set for each scenario before it is added.
+*/
+
+
+int main() {
+    const int numScenarios = 3;
+    const int numFactories = 3;
+    const int numDistributionCenters = 5;
+    MP_set i(numFactories), j(numDistributionCenters);
+
+    MP_data
+	capacity(i),
+	transcost(i,j),
+	demand(j);
+
+    transcost(0,0) = 2.49; transcost(1,0) = 1.46; transcost(2,0) = 3.26;
+    transcost(0,1) = 5.21; transcost(1,1) = 2.54; transcost(2,1) = 3.08;
+    transcost(0,2) = 3.76; transcost(1,2) = 1.84; transcost(2,2) = 2.60;
+    transcost(0,3) = 4.85; transcost(1,3) = 1.86; transcost(2,3) = 3.76;
+    transcost(0,4) = 2.07; transcost(1,4) = 4.76; transcost(2,4) = 4.45;
+
+    capacity(0) = 500;
+    capacity(1) = 450;
+    capacity(2) = 650;
+
+    const double prodcost = 14;
+    const double price = 24;
+    const double wastecost = 4;
+
+    const double Demand[numScenarios][numDistributionCenters] =
+	{{150,100,250,300,600},
+	 {160,120,270,325,700},
+	 {170,135,300,350,800}};
+
+    const double prob[numScenarios] = {0.25,0.5,0.25};
+
+    ///// Master problem /////////////////////////////////////////////
+
+    MP_model masterproblem(new OsiClpSolverInterface);
+
+    MP_variable
+	theta,
+	ship(i,j),
+	product(i),
+	slackproduct(i),
+	received(j);
+
+    MP_constraint
+	production(i),
+	receive(j),
+	prodcap(i);
+
+    production(i) = product(i) == sum(j,ship(i,j));
+    receive(j) =    received(j) == sum(i,ship(i,j));
+    prodcap(i) =    product(i) + slackproduct(i) == capacity(i);
+
+    masterproblem.setObjective( sum(i*j,transcost(i,j)*ship(i,j)) +
+				sum(i, prodcost*product(i)) + theta() );
+
+    ///// Sub problem ///////////////////////////////////////////////
+
+    MP_model subproblem(new OsiClpSolverInterface);
+
+    MP_variable
+	sales(j),
+	waste(j),
+	slacksales(j);
+
+    MP_constraint
+	selling(j),
+	selmax(j);
+
+    selling(j) = sales(j) + waste(j) == received(j);
+    selmax(j) =  sales(j) + slacksales(j) == demand(j);
+
+    subproblem.setObjective( sum(j, wastecost*waste(j)) - sum(j, price*sales(j)) );
+
+    ///// Benders algorithm //////////////////////////////////////////
+
+    MP_benders benders(masterproblem, theta, subproblem);
+    benders.link(received);
+    for (int s=0; s<numScenarios; s++) {
+	for (int jj=0; jj<numDistributionCenters; jj++) {
+	    demand(jj) = Demand[s][jj];
+	}
+	benders.addScenario(prob[s]);
+    }
+    benders.setNumberThreads(numScenarios);
+
+    MP_model::MP_status status = benders.solve(25);
+    assert(status == MP_model::OPTIMAL);
+    cout<<"Lower and upper bounds: "<<benders.getLowerBound()<<"   "
+	<<benders.getUpperBound()<<" after "<<benders.getIterations()
+	<<" iterations"<<endl;
+    ship.display("ship");
+
+    const double expected[numFactories][numDistributionCenters] =
+	{{0,   0,   0,   0, 500},
+	 {150, 0,   0, 300,   0},
+	 {0,   100, 270, 0, 100}};
+    for (int ii=0; ii<numFactories; ii++) {
+	for (int jj=0; jj<numDistributionCenters; jj++) {
+	    assert(fabs(ship.level(ii,jj)-expected[ii][jj]) < 1e-6);
+	}
+    }
+
+    cout<<"Test stochbenders2 passed."<<endl;
+}
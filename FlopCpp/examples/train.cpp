@@ -4,6 +4,7 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <cmath>
 #include <OsiCbcSolverInterface.hpp>
 
 #include "flopc.hpp"
@@ -162,7 +163,8 @@ int main() {
     assert(MP_model::getDefaultModel()->getNumRows()==192);
     assert(MP_model::getDefaultModel()->getNumCols()==411);
     assert(MP_model::getDefaultModel()->getNumElements()==822);
-    assert(MP_model::getDefaultModel()->getObjValue()==163882);
+    // The second solve is warm started, so allow for round-off.
+    assert(fabs(MP_model::getDefaultModel()->getObjValue()-163882)<1e-6);
     //cout<<cars.level()<<"  -----  "<<miles.level()<<endl;
 
     cout<<"Test train passed."<<endl;
@@ -0,0 +1,252 @@
+// ******************** FlopCpp **********************************************
+// File: MP_benders.cpp
+// $Id$
+//****************************************************************************
+
+#include <string>
+#include <cmath>
+#include <cassert>
+
+#include <CoinError.hpp>
+#include <OsiSolverInterface.hpp>
+#include "MP_benders.hpp"
+#include "MP_variable.hpp"
+#ifdef FLOPCPP_THREAD
+#include <pthread.h>
+#endif
+
+using namespace flopc;
+using namespace std;
+
+MP_benders::MP_benders(MP_model& m, MP_variable& t, MP_model& s) :
+    master(m), theta(t), sub(s), next(0), numberThreads(1), iterations(0),
+    lowerBound(-m.getInfinity()), upperBound(m.getInfinity()) {}
+
+MP_benders::~MP_benders() {
+    for (size_t s=0; s<scenarios.size(); s++) {
+	delete scenarios[s];
+    }
+}
+
+void MP_benders::link(MP_variable& x) {
+    assert(scenarios.empty());
+    linked.push_back(&x);
+}
+
+int MP_benders::addScenario(double p) {
+    assert(sub.Solver);
+    sub.attach();
+    // The layout of sub is the same for every scenario
+    vector<int> columns;
+    for (size_t v=0; v<linked.size(); v++) {
+	for (int k=0; k<linked[v]->size(); k++) {
+	    columns.push_back(linked[v]->offset+k);
+	}
+    }
+    assert(scenarios.empty() || columns==subColumns);
+    subColumns.swap(columns);
+
+    OsiSolverInterface* scenario = sub.Solver->clone();
+    scenario->setObjSense(MP_model::MINIMIZE);
+    scenarios.push_back(scenario);
+    probability.push_back(p);
+    return static_cast<int>(scenarios.size())-1;
+}
+
+void MP_benders::setNumberThreads(int number) {
+#ifdef FLOPCPP_THREAD
+    numberThreads = std::max(1,number);
+#endif
+}
+
+void MP_benders::solveScenario(int s) {
+    OsiSolverInterface* scenario = scenarios[s];
+    const int n = static_cast<int>(subColumns.size());
+    for (int j=0; j<n; j++) {
+	scenario->setColBounds(subColumns[j],levels[j],levels[j]);
+    }
+    try {
+	if (solved[s]==0) {
+	    scenario->initialSolve();
+	    solved[s] = 1;
+	} else {
+	    scenario->resolve();
+	}
+    } catch (const CoinError& e) {
+	// Kept for the caller, the scenario may be solved on a worker thread
+	errors[s] = e.message();
+	status[s] = MP_model::ABANDONED;
+	return;
+    }
+    if (scenario->isProvenOptimal() == true) {
+	status[s] = MP_model::OPTIMAL;
+	objective[s] = scenario->getObjValue();
+	// The reduced cost of a fixed column is the rate at which the
+	// objective changes with its level.
+	const double* rc = scenario->getReducedCost();
+	for (int j=0; j<n; j++) {
+	    reducedCosts[s*n+j] = rc[subColumns[j]];
+	}
+    } else if (scenario->isProvenPrimalInfeasible() == true) {
+	status[s] = MP_model::PRIMAL_INFEASIBLE;
+    } else if (scenario->isProvenDualInfeasible() == true) {
+	status[s] = MP_model::DUAL_INFEASIBLE;
+    } else {
+	status[s] = MP_model::ABANDONED;
+    }
+}
+
+void* MP_benders::scenarioThread(void* info) {
+    MP_benders* benders = static_cast<MP_benders*>(info);
+    const int number = benders->getNumberScenarios();
+    for (;;) {
+#ifdef FLOPCPP_THREAD
+	const int s = __sync_fetch_and_add(&benders->next,1);
+#else
+	const int s = benders->next++;
+#endif
+	if (s>=number) {
+	    break;
+	}
+	benders->solveScenario(s);
+    }
+    return 0;
+}
+
+void MP_benders::solveScenarios() {
+    next = 0;
+#ifdef FLOPCPP_THREAD
+    // The subproblems only touch their own solvers, the calling thread
+    // takes part in solving them.
+    const int number = std::min(numberThreads,getNumberScenarios());
+    vector<pthread_t> threads(std::max(number,1));
+    vector<bool> started(threads.size(),false);
+    for (int t=1; t<number; t++) {
+	started[t] = pthread_create(&threads[t],NULL,scenarioThread,this)==0;
+    }
+    scenarioThread(this);
+    for (int t=1; t<number; t++) {
+	if (started[t]==true) {
+	    pthread_join(threads[t],NULL);
+	}
+    }
+#else
+    scenarioThread(this);
+#endif
+}
+
+MP_model::MP_status MP_benders::solve(int maxIterations, double tolerance) {
+    assert(master.Solver);
+    assert(theta.rank==1);
+    master.attach();
+    OsiSolverInterface* solver = master.Solver;
+    masterColumns.clear();
+    for (size_t v=0; v<linked.size(); v++) {
+	for (int k=0; k<linked[v]->size(); k++) {
+	    masterColumns.push_back(linked[v]->offset+k);
+	}
+    }
+    assert(masterColumns.size()==subColumns.size());
+    const int n = static_cast<int>(masterColumns.size());
+    const int groups = theta.size();
+    const int number = getNumberScenarios();
+    levels.resize(n);
+    solved.assign(number,0);
+    objective.assign(number,0.0);
+    reducedCosts.assign(number*n,0.0);
+    status.assign(number,MP_model::OPTIMAL);
+    errors.assign(number,string());
+    lowerBound = -solver->getInfinity();
+    upperBound = solver->getInfinity();
+
+    // Without cuts theta is left out of the first master problem
+    for (int g=0; g<groups; g++) {
+	solver->setColBounds(theta.offset+g,0.0,0.0);
+    }
+    MP_model::MP_status result = MP_model::ABANDONED;
+    for (iterations=0; iterations<maxIterations; iterations++) {
+	const MP_model::MP_status masterStatus =
+	    master.solve(MP_model::MINIMIZE);
+	if (masterStatus!=MP_model::OPTIMAL) {
+	    result = masterStatus;
+	    break;
+	}
+	const double* x = solver->getColSolution();
+	const double* c = solver->getObjCoefficients();
+	for (int j=0; j<n; j++) {
+	    levels[j] = x[masterColumns[j]];
+	}
+	double firstStage = solver->getObjValue();
+	for (int g=0; g<groups; g++) {
+	    firstStage -= c[theta.offset+g]*x[theta.offset+g];
+	}
+	if (iterations>0) {
+	    lowerBound = solver->getObjValue();
+	}
+
+	solveScenarios();
+	bool failed = false;
+	for (int s=0; s<number && failed==false; s++) {
+	    if (status[s]!=MP_model::OPTIMAL) {
+		result = status[s];
+		failed = true;
+	    }
+	}
+	if (failed==true) {
+	    break;
+	}
+
+	// Aggregate the cuts theta(g) >= sum p*(objective + d*(x - levels))
+	vector<double> value(groups,0.0);
+	vector<double> gradient(groups*n,0.0);
+	double expected = 0.0;
+	for (int s=0; s<number; s++) {
+	    const int g = s%groups;
+	    expected += probability[s]*objective[s];
+	    value[g] += probability[s]*objective[s];
+	    for (int j=0; j<n; j++) {
+		gradient[g*n+j] += probability[s]*reducedCosts[s*n+j];
+	    }
+	}
+	upperBound = std::min(upperBound,firstStage+expected);
+	if (iterations>0 &&
+	    upperBound-lowerBound <= tolerance*(1.0+fabs(lowerBound))) {
+	    result = MP_model::OPTIMAL;
+	    break;
+	}
+
+	vector<Coef> coefs;
+	vector<Sense_enum> senses;
+	for (int g=0; g<groups; g++) {
+	    // Only cuts the current solution violates
+	    if (iterations>0 && x[theta.offset+g] >=
+		value[g]-tolerance*(1.0+fabs(value[g]))) {
+		continue;
+	    }
+	    const int row = static_cast<int>(senses.size());
+	    double rhs = value[g];
+	    coefs.push_back(Coef(theta.offset+g,row,1.0));
+	    for (int j=0; j<n; j++) {
+		const double d = gradient[g*n+j];
+		if (d!=0.0) {
+		    coefs.push_back(Coef(masterColumns[j],row,-d));
+		    rhs -= d*levels[j];
+		}
+	    }
+	    coefs.push_back(Coef(-1,row,-rhs));
+	    senses.push_back(GE);
+	}
+	if (senses.empty()) {
+	    result = MP_model::OPTIMAL;
+	    break;
+	}
+	master.addRows(coefs,senses);
+	if (iterations==0) {
+	    for (int g=0; g<groups; g++) {
+		solver->setColBounds(theta.offset+g,-solver->getInfinity(),
+				     solver->getInfinity());
+	    }
+	}
+    }
+    return result;
+}
@@ -0,0 +1,124 @@
+// ******************** FlopCpp **********************************************
+// File: MP_benders.hpp
+// $Id$
+// ****************************************************************************
+
+#ifndef _MP_benders_hpp_
+#define _MP_benders_hpp_
+
+#include <vector>
+#include <string>
+#include "MP_model.hpp"
+
+class OsiSolverInterface;
+
+namespace flopc {
+
+    /** @brief L-shaped (Benders) decomposition of a two stage stochastic
+        linear program over a number of scenarios.
+        @ingroup PublicInterface
+        The first stage is the master model, in which theta stands for
+        the expected cost of the second stage.  The second stage is a model
+        of its own, sub, in which the first stage variables passed to
+        link() appear as well.  The subproblem of a scenario is sub as it
+        is when addScenario() is called, so the data of the scenario are
+        set before; it is kept in a clone of the solver of sub.
+        <br>
+        solve() alternates between the master and the subproblems.  With
+        the first stage levels of the master fixed in the subproblems,
+        their objective values and the reduced costs of the fixed columns
+        give a cut on theta, which is aggregated over the scenarios: a
+        scalar theta gets one cut per iteration, the elements of a one
+        dimensional theta one cut each for the scenarios s with
+        s % theta.size() equal to their index.  The cuts of an iteration
+        are added to the master in one batch.
+        <br>
+        The subproblems are solved on the threads set by
+        setNumberThreads(), each warm started from its previous solution.
+        @note Both models are minimized.  The subproblems are solved as
+        linear programs and must be feasible for any first stage decision
+        (relatively complete recourse), there are no feasibility cuts.
+        The bounds of theta are replaced by the cuts.
+        @see examples/stochbenders2.cpp
+    */
+    class MP_benders {
+    public:
+        MP_benders(MP_model& master, MP_variable& theta, MP_model& sub);
+        ~MP_benders();
+        /// declares a first stage variable which appears in sub.
+        void link(MP_variable& x);
+        /** Attaches sub and adds its problem as a scenario of the given
+            probability.
+            @return the number of the scenario
+        */
+        int addScenario(double probability);
+        /** Sets the number of threads solving subproblems.
+            @note This only has an effect if FlopCpp is configured with
+            --enable-flopcpp-parallel (FLOPCPP_THREAD).
+        */
+        void setNumberThreads(int number);
+        /** Attaches the master and iterates until the bounds on the
+            optimal value are within tolerance*(1+|lower bound|) of each
+            other.
+            @return OPTIMAL, the status of the master or of a subproblem
+            which could not be solved, or ABANDONED after maxIterations.
+            @see getScenarioStatus(), getScenarioError()
+        */
+        MP_model::MP_status solve(int maxIterations = 100,
+                                  double tolerance = 1.0e-6);
+        /// lower bound on the optimal value, the objective of the master.
+        double getLowerBound() const { return lowerBound; }
+        /// upper bound on the optimal value, the best solution evaluated.
+        double getUpperBound() const { return upperBound; }
+        /// number of iterations of the last solve().
+        int getIterations() const { return iterations; }
+        int getNumberScenarios() const {
+            return static_cast<int>(scenarios.size());
+        }
+        /// status of scenario s in the last iteration.
+        MP_model::MP_status getScenarioStatus(int s) const {
+            return status[s];
+        }
+        /** message of the CoinError thrown solving scenario s in the last
+            iteration, empty if there was none.
+        */
+        const std::string& getScenarioError(int s) const {
+            return errors[s];
+        }
+        /// the subproblem of scenario s, as of the last iteration.
+        OsiSolverInterface* getScenarioSolver(int s) const {
+            return scenarios[s];
+        }
+    private:
+        MP_benders(const MP_benders&);
+        MP_benders& operator=(const MP_benders&);
+        void solveScenarios();
+        static void* scenarioThread(void* info);
+        void solveScenario(int s);
+
+        MP_model& master;
+        MP_variable& theta;
+        MP_model& sub;
+        std::vector<MP_variable*> linked;
+        /// columns of the linked variables in the master and in sub
+        std::vector<int> masterColumns;
+        std::vector<int> subColumns;
+        std::vector<OsiSolverInterface*> scenarios;
+        std::vector<double> probability;
+        /// first stage levels of the current iteration
+        std::vector<double> levels;
+        /// per scenario: solved before, objective value, reduced costs
+        std::vector<int> solved;
+        std::vector<double> objective;
+        std::vector<double> reducedCosts;
+        std::vector<MP_model::MP_status> status;
+        std::vector<std::string> errors;
+        int next;
+        int numberThreads;
+        int iterations;
+        double lowerBound;
+        double upperBound;
+    };
+
+} // End of namespace flopc
+#endif
@@ -46,6 +46,9 @@ namespace flopc {
 		return true;
 	    }
 	}
+	const SUBSETREF* membership() const {
+	    return C;
+	}
 	SUBSETREF* C;
     };
 
@@ -66,6 +69,10 @@ namespace flopc {
 	bool evaluate() const {
 	    return left->evaluate() && right->evaluate();
 	}
+	void conjuncts(std::vector<const Boolean_base*>& c) const {
+	    left->conjuncts(c);
+	    right->conjuncts(c);
+	}
 	MP_boolean left, right;
     };
 
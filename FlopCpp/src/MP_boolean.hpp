@@ -9,22 +9,35 @@
 #ifndef _MP_boolean_hpp_
 #define _MP_boolean_hpp_
 
+#include <vector>
 #include "MP_index.hpp"
 #include "MP_constant.hpp"
 #include "MP_utilities.hpp"
 
 namespace flopc {
 
+    class SUBSETREF;
+
     /** @brief Base class for all "boolean" types of data.
     @ingroup INTERNAL_USE
     @note FOR INTERNAL USE: This is not normally used directly by the
     calling code.
     */
-    class Boolean_base {
+    class Boolean_base : public ArenaNode {
 	friend class Handle<Boolean_base*>;
 	friend class MP_boolean;
     public:
 	virtual bool evaluate() const = 0;
+	/** Appends the booleans which must all be true for this one to be
+	    true.  Evaluating them in turn is the same as evaluating this.
+	*/
+	virtual void conjuncts(std::vector<const Boolean_base*>& c) const {
+	    c.push_back(this);
+	}
+	/// the subset reference this tests membership of, if any.
+	virtual const SUBSETREF* membership() const {
+	    return 0;
+	}
     protected:
 	Boolean_base() : count(0) {}
 	virtual ~Boolean_base() {}
@@ -32,8 +45,6 @@ namespace flopc {
 	int count;
     };
 
-    class SUBSETREF;
-
     /** @brief Reference counted class for all "boolean" types of data.
     @ingroup PublicInterface
     This contains counters to ConstantBase pointers.
@@ -25,6 +25,10 @@ namespace flopc {
 	double evaluate() const {
 	    return I->evaluate(); 
 	}
+	bool factorize(double& factor, vector<DataEntry>& entries) const {
+	    factor *= evaluate();
+	    return true;
+	}
 	const MP_index_exp I;
     };
 
@@ -35,6 +39,10 @@ namespace flopc {
 	double evaluate() const { 
 	    return D; 
 	} 
+	bool factorize(double& factor, vector<DataEntry>& entries) const {
+	    factor *= D;
+	    return true;
+	}
 	double D;
     };
 
@@ -98,6 +106,14 @@ namespace flopc {
     class Constant_exp : public Constant_base {
     protected:
 	Constant_exp(const Constant& i, const Constant& j) : left(i),right(j) {}
+	/// the numbers the operands factorize into if they read no data
+	bool numbers(double& a, double& b) const {
+	    vector<DataEntry> entries;
+	    a = 1.0;
+	    b = 1.0;
+	    return left->factorize(a,entries) && right->factorize(b,entries) &&
+		entries.empty();
+	}
 	Constant left, right;
     };
 
@@ -135,6 +151,14 @@ namespace flopc {
 	double evaluate() const {
 	    return left->evaluate()+right->evaluate();
 	}
+	bool factorize(double& factor, vector<DataEntry>& entries) const {
+	    double a, b;
+	    if (numbers(a,b) == false) {
+		return false;
+	    }
+	    factor *= a+b;
+	    return true;
+	}
     };
 
     Constant operator+(const Constant& a, const Constant& b) {
@@ -152,6 +176,14 @@ namespace flopc {
 	double evaluate() const {
 	    return left->evaluate()-right->evaluate(); 
 	}
+	bool factorize(double& factor, vector<DataEntry>& entries) const {
+	    double a, b;
+	    if (numbers(a,b) == false) {
+		return false;
+	    }
+	    factor *= a-b;
+	    return true;
+	}
     };
 
     Constant operator-(const Constant& a, const Constant& b) {
@@ -169,6 +201,10 @@ namespace flopc {
 	double evaluate() const {
 	    return left->evaluate()*right->evaluate(); 
 	}
+	bool factorize(double& factor, vector<DataEntry>& entries) const {
+	    return left->factorize(factor,entries) &&
+		right->factorize(factor,entries);
+	}
     };
 
     Constant operator*(const Constant& a, const Constant& b) {
@@ -182,6 +218,15 @@ namespace flopc {
 	double evaluate() const {
 	    return left->evaluate()/right->evaluate(); 
 	}
+	bool factorize(double& factor, vector<DataEntry>& entries) const {
+	    vector<DataEntry> divisor;
+	    double b = 1.0;
+	    if (right->factorize(b,divisor) == false || !divisor.empty()) {
+		return false;
+	    }
+	    factor /= b;
+	    return left->factorize(factor,entries);
+	}
     };
 
     Constant operator/(const Constant& a, const Constant& b) {
@@ -194,19 +239,19 @@ namespace flopc {
 	Constant_max(const MP_domain& i, const Constant& e) : d(i), exp(e) {}
 	void operator()() const {
 	    double temp = exp->evaluate();
-	    if (temp > the_max) {
-		the_max = temp;
+	    if (temp > the_max()) {
+		the_max() = temp;
 	    }
 	}
 	double evaluate() const {    
-	    the_max = DBL_MIN;
+	    the_max() = DBL_MIN;
 	    d.Forall(this);
-	    return the_max;
+	    return the_max();
 	}
     
 	MP_domain d;
 	Constant exp;
-	mutable double the_max;
+	PerThread<double> the_max;
     };
 
     class Constant_min : public Constant_base, public Functor {
@@ -215,19 +260,19 @@ namespace flopc {
 	Constant_min(const MP_domain& i, const Constant& e) : d(i), exp(e) {}
 	void operator()() const {
 	    double temp = exp->evaluate();
-	    if (temp < the_min) {
-		the_min = temp;
+	    if (temp < the_min()) {
+		the_min() = temp;
 	    }
 	}
 	double evaluate() const {    
-	    the_min = DBL_MAX;
+	    the_min() = DBL_MAX;
 	    d.Forall(this);
-	    return the_min;
+	    return the_min();
 	}
 
 	MP_domain d;
 	Constant exp;
-	mutable double the_min;
+	PerThread<double> the_min;
     };
 
     class Constant_sum : public Constant_base, public Functor {
@@ -235,17 +280,17 @@ namespace flopc {
     private:
 	Constant_sum(const MP_domain& i, const Constant& e) : d(i), exp(e) {}
 	void operator()() const {
-	    the_sum += exp->evaluate();
+	    the_sum() += exp->evaluate();
 	}
 	double evaluate() const {  
-	    the_sum = 0;
+	    the_sum() = 0;
 	    d.Forall(this);
-	    return the_sum;
+	    return the_sum();
 	}
 
 	MP_domain d;
 	Constant exp;
-	mutable double the_sum;
+	PerThread<double> the_sum;
     };
 
     class Constant_product : public Constant_base, public Functor {
@@ -253,17 +298,17 @@ namespace flopc {
     private:
 	Constant_product(const MP_domain& i, const Constant& e) : d(i), exp(e) {}
 	void operator()() const {
-	    the_product *= exp->evaluate();
+	    the_product() *= exp->evaluate();
 	}
 	double evaluate() const {  
-	    the_product = 1;
+	    the_product() = 1;
 	    d.Forall(this);
-	    return the_product;
+	    return the_product();
 	}
 
 	MP_domain d;
 	Constant exp;
-	mutable double the_product;
+	PerThread<double> the_product;
     };
 
     Constant maximum(const MP_domain& i, const Constant& e) {
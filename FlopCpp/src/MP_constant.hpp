@@ -11,13 +11,28 @@
 
 #include "MP_utilities.hpp"
 
+#include <vector>
+
 namespace flopc {
+    /** @brief An element of the values of an MP_data, located through the
+        values array of the data (which may be bound to another array
+        later) and its position in it.
+        @ingroup INTERNAL_USE
+    */
+    struct DataEntry {
+	double* const* values;
+	int position;
+	double value() const {
+	    return (*values)[position];
+	}
+    };
+
     /** @brief Base class for all "constant" types of data.
     @ingroup INTERNAL_USE
     @note FOR INTERNAL USE: This is not normally used directly by the
     calling code.
     */
-    class Constant_base {
+    class Constant_base : public ArenaNode {
 	friend class Constant;
 	friend class Handle<Constant_base*>;
     public:
@@ -28,6 +43,15 @@ namespace flopc {
 	virtual int stage() const {
 	    return 0;
 	}
+	/** If the constant is a product of MP_data values and of numbers
+	    which do not depend on data, multiplies factor by the numbers,
+	    appends the data values to entries and returns true.  Used for
+	    model templates, see MP_model::useTemplate().
+	*/
+	virtual bool factorize(double& factor,
+			       std::vector<DataEntry>& entries) const {
+	    return false;
+	}
     protected:
 	Constant_base() : count(0) {}
 	virtual ~Constant_base() {}
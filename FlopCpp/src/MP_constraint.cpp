@@ -8,6 +8,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <OsiSolverInterface.hpp>
 
 #include "MP_constraint.hpp"
 #include "MP_expression.hpp"
@@ -23,26 +24,25 @@ void MP_constraint::operator=(const Constraint &v) {
    left = v.left;
    right = v.right;
    sense = v.sense;
+   touch();
 }
 
 int MP_constraint::row_number() const {
-    int i1 = S1.check(I1->evaluate());
-    int i2 = S2.check(I2->evaluate());
-    int i3 = S3.check(I3->evaluate());
-    int i4 = S4.check(I4->evaluate());
-    int i5 = S5.check(I5->evaluate());
-    
-    if (i1==outOfBound || i2==outOfBound || i3==outOfBound ||
-	i4==outOfBound || i5==outOfBound) {
+    const MP_set_base* S[maxDimension] =
+	{&S1, &S2, &S3, &S4, &S5, &S6, &S7};
+    const MP_index_exp* I[maxDimension] =
+	{&I1, &I2, &I3, &I4, &I5, &I6, &I7};
+    int element[maxDimension];
+    if (evaluateSlots(slots,S,I,element) == false) {
 	return outOfBound;
     } else {
-	return offset + f(I1->evaluate(),I2->evaluate(),I3->evaluate(),
-			  I4->evaluate(),I5->evaluate()); 
+	return offset + f(element);
     }
 }
 
-double MP_constraint::price(int i1, int i2, int i3, int i4, int i5) const {
-    return  M->rowPrice[offset + f(i1,i2,i3,i4,i5)];
+double MP_constraint::price(int i1, int i2, int i3, int i4, int i5,
+			    int i6, int i7) const {
+    return  M->rowPrice[offset + f(i1,i2,i3,i4,i5,i6,i7)];
 }
  
 MP_constraint::MP_constraint(
@@ -50,26 +50,52 @@ MP_constraint::MP_constraint(
     const MP_set_base &s2, 
     const MP_set_base &s3,
     const MP_set_base &s4, 
-    const MP_set_base &s5) :
-    RowMajor(s1.size(),s2.size(),s3.size(),s4.size(),s5.size()),
+    const MP_set_base &s5, 
+    const MP_set_base &s6, 
+    const MP_set_base &s7) :
+    RowMajor(s1.size(),s2.size(),s3.size(),s4.size(),s5.size(),s6.size(),
+	     s7.size()),
 //     pprice(MP_data(d1->getSet(),d2->getSet(),d3->getSet(),
 // 		   d4->getSet(),d5->getSet())),
-    M(MP_model::current_model),
+    M(MP_model::getCurrentModel()),
     offset(-1),
-    S1(s1),S2(s2),S3(s3),S4(s4),S5(s5),
-    I1(0),I2(0),I3(0),I4(0),I5(0)
+    S1(s1),S2(s2),S3(s3),S4(s4),S5(s5),S6(s6),S7(s7),
+    I1(0),I2(0),I3(0),I4(0),I5(0),I6(0),I7(0),slots(maxDimension),
+    programStamp(0)
 {
-    MP_model::current_model->add(*this);
+    M->add(*this);
+}
+
+void MP_constraint::compile() {
+    vector<const MP_index_base*> indices(maxDimension);
+    indices[0] = I1.operator->();
+    indices[1] = I2.operator->();
+    indices[2] = I3.operator->();
+    indices[3] = I4.operator->();
+    indices[4] = I5.operator->();
+    indices[5] = I6.operator->();
+    indices[6] = I7.operator->();
+    // The indices are not part of the stamp, as operator() sets them
+    // without changing the constraint.
+    if (programStamp != getStamp() || programIndices != indices) {
+	program.clear();
+	MP_domain domain =
+	    S1(I1)*S2(I2)*S3(I3)*S4(I4)*S5(I5)*S6(I6)*S7(I7).such_that(B);
+	program.compile(left.operator->(),domain,1.0);
+	program.compile(right.operator->(),domain,-1.0);
+	programStamp = getStamp();
+	programIndices = indices;
+    }
+    // Subsets may have grown since the program was compiled.
+    program.prepare();
 }
 
 void MP_constraint::coefficients(GenerateFunctor& f) {
     f.setConstraint(this);
 
-    vector<Constant> v;
-
         if (I1.operator->()!=0) {
-	left->generate(S1(I1)*S2(I2)*S3(I3)*S4(I4)*S5(I5).such_that(B),v,f,1.0);
- 	right->generate(S1(I1)*S2(I2)*S3(I3)*S4(I4)*S5(I5).such_that(B),v,f,-1.0);
+	compile();
+	program.run(f);
 	 } else {
 		cout<<"FlopCpp Warning: Constraint declared but not defined."<<endl;
 	}
@@ -88,7 +114,7 @@ void MP_constraint::display(string s) const {
     cout<<s<<endl;
     if (offset >=0) {
       for (int i=offset; i<offset+size(); i++) {
-	cout<<i<<"  "<<M->bl[i]<<"  "<<M->rowActivity[i]<<"  "<<M->bu[i]<<"  "<<M->rowPrice[i]<<endl;
+	cout<<i<<"  "<<M->Solver->getRowLower()[i]<<"  "<<M->rowActivity[i]<<"  "<<M->Solver->getRowUpper()[i]<<"  "<<M->rowPrice[i]<<endl;
       }
     } else {
       cout<<"No solution available!"<<endl;
@@ -191,7 +191,9 @@ namespace flopc {
     @todo more work on MP_constraint.
     
     */
-    class MP_constraint : public RowMajor, public Named {
+    class MP_constraint : public RowMajor, public Named, public Stamped {
+	friend class MP_model;
+	friend class MP_smps;
     public: 
         /// construct the MP_constraint with appropriate sets for indexing.
 	MP_constraint(
@@ -199,7 +201,9 @@ namespace flopc {
 	    const MP_set_base &s2 = MP_set::getEmpty(), 
 	    const MP_set_base &s3 = MP_set::getEmpty(),
 	    const MP_set_base &s4 = MP_set::getEmpty(), 
-	    const MP_set_base &s5 = MP_set::getEmpty()
+	    const MP_set_base &s5 = MP_set::getEmpty(), 
+	    const MP_set_base &s6 = MP_set::getEmpty(), 
+	    const MP_set_base &s7 = MP_set::getEmpty()
 	    );
 
 	MP_constraint& operator()(
@@ -207,20 +211,29 @@ namespace flopc {
 	    const MP_index_exp& i2 = MP_index_exp::getEmpty(), 
 	    const MP_index_exp& i3 = MP_index_exp::getEmpty(), 
 	    const MP_index_exp& i4 = MP_index_exp::getEmpty(), 
-	    const MP_index_exp& i5 = MP_index_exp::getEmpty()
+	    const MP_index_exp& i5 = MP_index_exp::getEmpty(), 
+	    const MP_index_exp& i6 = MP_index_exp::getEmpty(), 
+	    const MP_index_exp& i7 = MP_index_exp::getEmpty()
 	    )  {
-	    I1 = i1; I2 = i2; I3 = i3; I4 = i4; I5 = i5;
+	    I1 = i1; I2 = i2; I3 = i3; I4 = i4; I5 = i5; I6 = i6; I7 = i7;
+	    const MP_set_base* S[maxDimension] =
+		{&S1, &S2, &S3, &S4, &S5, &S6, &S7};
+	    const MP_index_exp* I[maxDimension] =
+		{&I1, &I2, &I3, &I4, &I5, &I6, &I7};
+	    slots = usedSlots(S,I);
 	    return *this;
 	}
 
 	operator int() {
 	    return offset + f(I1->evaluate(),I2->evaluate(),I3->evaluate(),
-			      I4->evaluate(),I5->evaluate());
+			      I4->evaluate(),I5->evaluate(),I6->evaluate(),
+			      I7->evaluate());
 	}
 
 	virtual ~MP_constraint() {}
 
-	double price(int i1=0, int i2=0, int i3=0, int i4=0, int i5=0) const;
+	double price(int i1=0, int i2=0, int i3=0, int i4=0, int i5=0,
+		     int i6=0, int i7=0) const;
 
 	void coefficients(GenerateFunctor& f);
 
@@ -228,6 +241,7 @@ namespace flopc {
 
 	MP_constraint& such_that(const MP_boolean& b) {
 	    B = b; 
+	    touch();
 	    return *this; 
 	}
 
@@ -242,9 +256,24 @@ namespace flopc {
 	MP_expression left,right;
 	Sense_enum sense;
     private:
+	/** Compiles the constraint for coefficients(), unless it has been
+	    compiled since it was last changed.
+	*/
+	void compile();
+
 	MP_boolean B;
-	const MP_set_base &S1, &S2, &S3, &S4, &S5; 
-	MP_index_exp I1, I2, I3, I4, I5;
+	const MP_set_base &S1, &S2, &S3, &S4, &S5, &S6, &S7; 
+	MP_index_exp I1, I2, I3, I4, I5, I6, I7;
+	/// number of the indices above which row_number() evaluates.
+	int slots;
+	/// data read during the last generation of the coefficients.
+	std::vector<const MP_data*> dataUsed;
+	/// subsets read during the last generation of the coefficients.
+	std::vector<const MP_subset_base*> subsetsUsed;
+	/// the constraint compiled by compile(), and what it was compiled from.
+	GenerationProgram program;
+	unsigned long programStamp;
+	std::vector<const MP_index_base*> programIndices;
     };
 
 }  // End of namespace flopc
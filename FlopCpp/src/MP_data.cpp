@@ -7,6 +7,15 @@
 //****************************************************************************
 
 #include <iostream>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include "MP_data.hpp"
 #include "MP_domain.hpp" 
@@ -14,15 +23,356 @@
 #include "MP_set.hpp" 
 #include "MP_constant.hpp" 
 #include "MP_expression.hpp" 
+#include "MP_model.hpp"
 
 using namespace flopc;
 using namespace std;
 
 double MP_data::outOfBoundData = 0;
+PerThread<std::vector<const MP_data*>*> MP_data::recorded(0);
+PerThread<unsigned long> MP_data::recording(0);
+
+MP_stochastic_data::MP_stochastic_data(const MP_set_base &s1,
+				       const MP_set_base &s2,
+				       const MP_set_base &s3,
+				       const MP_set_base &s4,
+				       const MP_set_base &s5,
+				       const MP_set_base &s6,
+				       const MP_set_base &s7) :
+    MP_data(s1,s2,s3,s4,s5,s6,s7) {
+    MP_model::getCurrentModel()->staged = true;
+}
+
+namespace flopc {
+
+    /** A data file written by MP_data::save(): a header of 24 bytes,
+	the index columns and the values, aligned to 8 bytes.  On POSIX
+	systems the file is mapped privately, elsewhere it is read.
+    */
+    class DataFile {
+    public:
+	DataFile(const string& fileName) :
+	    dimension(0), nonzeros(0), values(0), base(0), length(0) {
+#ifndef _WIN32
+	    int fd = open(fileName.c_str(), O_RDONLY);
+	    struct stat st;
+	    if (fd < 0) {
+		return;
+	    }
+	    if (fstat(fd,&st) == 0 && st.st_size >= headerLength) {
+		length = static_cast<size_t>(st.st_size);
+		base = mmap(0,length,PROT_READ|PROT_WRITE,MAP_PRIVATE,fd,0);
+		if (base == MAP_FAILED) {
+		    base = 0;
+		}
+	    }
+	    close(fd);
+#else
+	    ifstream in(fileName.c_str(), ios::binary);
+	    in.seekg(0,ios::end);
+	    length = static_cast<size_t>(in.tellg());
+	    in.seekg(0,ios::beg);
+	    if (in && length >= headerLength) {
+		// doubles keep their alignment in a buffer of doubles
+		base = new double[(length+7)/8];
+		in.read(static_cast<char*>(base),length);
+		if (!in) {
+		    delete[] static_cast<double*>(base);
+		    base = 0;
+		}
+	    }
+#endif
+	    if (base != 0) {
+		parse();
+	    }
+	}
+	~DataFile() {
+	    if (base != 0) {
+#ifndef _WIN32
+		munmap(base,length);
+#else
+		delete[] static_cast<double*>(base);
+#endif
+	    }
+	}
+	bool valid() const {
+	    return values != 0;
+	}
+	static size_t valueOffset(int dimension, int nonzeros) {
+	    size_t offset = headerLength + 
+		sizeof(int)*static_cast<size_t>(dimension)*nonzeros;
+	    return (offset+7)/8*8;
+	}
+	static const char magic[9];
+	static const int headerLength = 24;
+
+	int dimension;
+	int nonzeros;
+	const int* columns[maxDimension];
+	double* values;
+    private:
+	void parse() {
+	    const char* p = static_cast<const char*>(base);
+	    int header[2];
+	    long long n;
+	    memcpy(header,p+8,sizeof(header));
+	    memcpy(&n,p+16,sizeof(n));
+	    if (memcmp(p,magic,8) != 0 || header[0] < 0 || header[0] > maxDimension ||
+		n < 0 || n > 2147483647LL ||
+		valueOffset(header[0],static_cast<int>(n)) + 
+		sizeof(double)*static_cast<size_t>(n) > length) {
+		return;
+	    }
+	    dimension = header[0];
+	    nonzeros = static_cast<int>(n);
+	    for (int k=0; k<dimension; k++) {
+		columns[k] = reinterpret_cast<const int*>(p+headerLength) + 
+		    static_cast<size_t>(k)*nonzeros;
+	    }
+	    values = reinterpret_cast<double*>(
+		static_cast<char*>(base)+valueOffset(dimension,nonzeros));
+	}
+	DataFile(const DataFile&);
+	DataFile& operator=(const DataFile&);
+
+	void* base;
+	size_t length;
+    };
+
+    const char DataFile::magic[9] = "FLOPDATA";
+}
+
+SparseIndex::SparseIndex(int n, const int* const* c, int d, int firstSize) : 
+    nonzeros(n), dimension(d), sorted(true) {
+    for (int k=0; k<dimension; k++) {
+	columns[k] = c[k];
+    }
+    int element[maxDimension];
+    for (int e=1; e<nonzeros && sorted==true; e++) {
+	getElement(e,element);
+	if (compare(e-1,element) >= 0) {
+	    sorted = false;
+	}
+    }
+    if (sorted == true && dimension > 0 && nonzeros > 0 &&
+	columns[0][0] >= 0 && columns[0][nonzeros-1] < firstSize) {
+	// starts[i] is the first entry whose first index value is i
+	starts.assign(firstSize+1,nonzeros);
+	for (int e=nonzeros-1; e>=0; e--) {
+	    starts[columns[0][e]] = e;
+	}
+	for (int i=firstSize-1; i>=0; i--) {
+	    starts[i] = std::min(starts[i],starts[i+1]);
+	}
+    }
+    if (sorted == false) {
+	size_t slots = 16;
+	while (slots < 2*static_cast<size_t>(nonzeros)) {
+	    slots *= 2;
+	}
+	table.assign(slots,-1);
+	for (int e=0; e<nonzeros; e++) {
+	    getElement(e,element);
+	    size_t s = slot(element);
+	    while (table[s] != -1 && compare(table[s],element) != 0) {
+		s = (s+1) & (table.size()-1);
+	    }
+	    // The first of duplicate entries is kept, as when sorted.
+	    if (table[s] == -1) {
+		table[s] = e;
+	    }
+	}
+    }
+}
+
+void SparseIndex::getElement(int e, int* element) const {
+    for (int k=0; k<dimension; k++) {
+	element[k] = columns[k][e];
+    }
+}
+
+int SparseIndex::compare(int e, const int* element) const {
+    for (int k=0; k<dimension; k++) {
+	if (columns[k][e] != element[k]) {
+	    return columns[k][e] < element[k] ? -1 : 1;
+	}
+    }
+    return 0;
+}
+
+size_t SparseIndex::slot(const int* element) const {
+    unsigned long long h = 0;
+    for (int k=0; k<dimension; k++) {
+	h = h*0x9E3779B1ULL + static_cast<unsigned int>(element[k]);
+    }
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h) & (table.size()-1);
+}
+
+int SparseIndex::find(const int* element) const {
+    for (int k=0; k<maxDimension; k++) {
+	if (element[k] == outOfBound) {
+	    return outOfBound;
+	}
+    }
+    if (sorted == true) {
+	int first = 0;
+	int last = nonzeros;
+	if (starts.empty() == false) {
+	    if (element[0] < 0 || 
+		element[0] >= static_cast<int>(starts.size())-1) {
+		return outOfBound;
+	    }
+	    first = starts[element[0]];
+	    last = starts[element[0]+1];
+	}
+	while (first < last) {
+	    const int middle = first + (last-first)/2;
+	    if (compare(middle,element) < 0) {
+		first = middle+1;
+	    } else {
+		last = middle;
+	    }
+	}
+	if (first < nonzeros && compare(first,element) == 0) {
+	    return first;
+	}
+	return outOfBound;
+    }
+    size_t s = slot(element);
+    while (table[s] != -1) {
+	if (compare(table[s],element) == 0) {
+	    return table[s];
+	}
+	s = (s+1) & (table.size()-1);
+    }
+    return outOfBound;
+}
+
+MP_data::MP_data(const string& fileName,
+		 const MP_set_base &s1, const MP_set_base &s2, 
+		 const MP_set_base &s3, const MP_set_base &s4, 
+		 const MP_set_base &s5, const MP_set_base &s6, 
+		 const MP_set_base &s7) :
+    RowMajor(s1.size(),s2.size(),s3.size(),s4.size(),s5.size(),s6.size(),
+	     s7.size()),
+    S1(s1),S2(s2),S3(s3),S4(s4),S5(s5),S6(s6),S7(s7),
+    v(0), manageData(false), sparse(0), file(new DataFile(fileName)),
+    recordedIn(0)
+{
+    if (file->valid() == false || file->dimension != dimension()) {
+	cout<<"FlopCpp Warning: Data file "<<fileName
+	    <<" could not be read or does not match the sets."<<endl;
+	const int* none[maxDimension] = {0, 0, 0, 0, 0, 0, 0};
+	sparse = new SparseIndex(0,none,0,0);
+    } else {
+	v = file->values;
+	sparse = new SparseIndex(file->nonzeros,file->columns,dimension(),
+				 sizes[0]);
+    }
+}
+
+MP_data::~MP_data() {
+    if (manageData == true) delete[] v;
+    delete sparse;
+    delete file;
+    /// @todo determine cause of seg fault.
+//     for (unsigned int i=0; i<myrefs.size(); i++) {
+// 	cout<<"# "<<i<<"   "<<myrefs[i]<<endl;
+// 	delete myrefs[i]; //Gives segmentation fault. I dont know why!
+//     }
+}
+
+int MP_data::dimension() const {
+    const MP_set_base* S[maxDimension] = {&S1, &S2, &S3, &S4, &S5, &S6, &S7};
+    int d = 0;
+    while (d < maxDimension && S[d] != &MP_set::getEmpty()) {
+	d++;
+    }
+    return d;
+}
+
+bool MP_data::save(const string& fileName) const {
+    const int d = dimension();
+    vector<int> positions;
+    vector<vector<int> > columns(d);
+    int element[maxDimension];
+    for (int i=0; i<entries(); i++) {
+	if (v[i] == 0.0) {
+	    continue;
+	}
+	positions.push_back(i);
+	if (sparse != 0) {
+	    sparse->getElement(i,element);
+	} else {
+	    int rest = i;
+	    for (int k=maxDimension-1; k>=0; k--) {
+		element[k] = rest % sizes[k];
+		rest /= sizes[k];
+	    }
+	}
+	for (int k=0; k<d; k++) {
+	    columns[k].push_back(element[k]);
+	}
+    }
+    const int n = static_cast<int>(positions.size());
+
+    ofstream out(fileName.c_str(), ios::binary);
+    const int header[2] = {d, 0};
+    const long long nonzeros = n;
+    out.write(DataFile::magic,8);
+    out.write(reinterpret_cast<const char*>(header),sizeof(header));
+    out.write(reinterpret_cast<const char*>(&nonzeros),sizeof(nonzeros));
+    for (int k=0; k<d && n>0; k++) {
+	out.write(reinterpret_cast<const char*>(&columns[k][0]),
+		  sizeof(int)*static_cast<size_t>(n));
+    }
+    const size_t padding = DataFile::valueOffset(d,n) - 
+	DataFile::headerLength - sizeof(int)*static_cast<size_t>(d)*n;
+    const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    out.write(zeros,padding);
+    for (int e=0; e<n; e++) {
+	out.write(reinterpret_cast<const char*>(&v[positions[e]]),
+		  sizeof(double));
+    }
+    return out.good();
+}
+
+void MP_data::startRecording(std::vector<const MP_data*>& used) {
+    recorded() = &used;
+    // A fresh stamp identifies this recording, see noteUse()
+    recording() = Stamped::tick();
+}
+
+void MP_data::stopRecording() {
+    recorded() = 0;
+    recording() = 0;
+}
+
+DataRef::DataRef(MP_data* d, 
+		 const MP_index_exp& i1,
+		 const MP_index_exp& i2,
+		 const MP_index_exp& i3,
+		 const MP_index_exp& i4,
+		 const MP_index_exp& i5,
+		 const MP_index_exp& i6,
+		 const MP_index_exp& i7,
+		 int s) : 
+    D(d),I1(i1),I2(i2),I3(i3),I4(i4),I5(i5),I6(i6),I7(i7),C(0),stochastic(s) {
+    const MP_set_base* S[maxDimension] =
+	{&D->S1, &D->S2, &D->S3, &D->S4, &D->S5, &D->S6, &D->S7};
+    const MP_index_exp* I[maxDimension] =
+	{&I1, &I2, &I3, &I4, &I5, &I6, &I7};
+    slots = usedSlots(S,I);
+}
 
 const DataRef& DataRef::operator=(const Constant& c) {
     C = c;
-    ((D->S1(I1)*D->S2(I2)*D->S3(I3)*D->S4(I4)*D->S5(I5)).such_that(B)).Forall(this);
+    ((D->S1(I1)*D->S2(I2)*D->S3(I3)*D->S4(I4)*D->S5(I5)*D->S6(I6)*
+      D->S7(I7)).such_that(B)).Forall(this);
+    D->touch();
     return *this;;
 }
 
@@ -40,14 +390,21 @@ DataRef& DataRef::such_that(const MP_boolean& b) {
 }
 
 
-double DataRef::evaluate() const {
-    int i1 = D->S1.check(I1->evaluate());
-    int i2 = D->S2.check(I2->evaluate());
-    int i3 = D->S3.check(I3->evaluate());
-    int i4 = D->S4.check(I4->evaluate());
-    int i5 = D->S5.check(I5->evaluate());
+int DataRef::position() const {
+    const MP_set_base* S[maxDimension] =
+	{&D->S1, &D->S2, &D->S3, &D->S4, &D->S5, &D->S6, &D->S7};
+    const MP_index_exp* I[maxDimension] =
+	{&I1, &I2, &I3, &I4, &I5, &I6, &I7};
+    int element[maxDimension];
+    if (evaluateSlots(slots,S,I,element) == false) {
+	return outOfBound;
+    }
+    return D->position(element);
+}
 
-    int i = D->f(i1,i2,i3,i4,i5);
+double DataRef::evaluate() const {
+    D->noteUse();
+    int i = position();
     if ( i ==  outOfBound ) {
 	return 0;
     } else {
@@ -57,12 +414,29 @@ double DataRef::evaluate() const {
 
 
 
+bool DataRef::factorize(double& factor, vector<DataEntry>& entries) const {
+    // The positions of sparse data move with their index values
+    if (D->sparse != 0 || D->file != 0) {
+	return false;
+    }
+    const int i = position();
+    if (i == outOfBound) {
+	factor = 0.0;
+    } else {
+	DataEntry entry = {&D->v, i};
+	entries.push_back(entry);
+    }
+    return true;
+}
+
 int DataRef::getStage() const {
     int i1 = D->S1.checkStage(I1->evaluate());
     int i2 = D->S2.checkStage(I2->evaluate());
     int i3 = D->S3.checkStage(I3->evaluate());
     int i4 = D->S4.checkStage(I4->evaluate());
     int i5 = D->S5.checkStage(I5->evaluate());
+    int i6 = D->S6.checkStage(I6->evaluate());
+    int i7 = D->S7.checkStage(I7->evaluate());
 
     int stage = 0;
     if (i1>stage) stage = i1;
@@ -70,6 +444,8 @@ int DataRef::getStage() const {
     if (i3>stage) stage = i3;
     if (i4>stage) stage = i4;
     if (i5>stage) stage = i5;
+    if (i6>stage) stage = i6;
+    if (i7>stage) stage = i7;
 
     // might need to add outofbound check here
     return stage+stochastic; 
@@ -77,13 +453,7 @@ int DataRef::getStage() const {
 
 
 void DataRef::evaluate_lhs(double v) const {
-    int i1 = D->S1.check(I1->evaluate());
-    int i2 = D->S2.check(I2->evaluate());
-    int i3 = D->S3.check(I3->evaluate());
-    int i4 = D->S4.check(I4->evaluate());
-    int i5 = D->S5.check(I5->evaluate());
-
-    int i = D->f(i1,i2,i3,i4,i5);
+    int i = position();
     if (i != outOfBound) {
 	D->v[i] = v;
     }
@@ -95,11 +465,15 @@ void MP_data::operator()() const {
     if (&S3!=&MP_set::getEmpty()) cout << i3.evaluate() << " ";
     if (&S4!=&MP_set::getEmpty()) cout << i4.evaluate() << " ";
     if (&S5!=&MP_set::getEmpty()) cout << i5.evaluate() << " ";
-    cout<<"  "<<v[f(i1.evaluate(),i2.evaluate(),i3.evaluate(),
-		    i4.evaluate(),i5.evaluate())] << endl;
+    if (&S6!=&MP_set::getEmpty()) cout << i6.evaluate() << " ";
+    if (&S7!=&MP_set::getEmpty()) cout << i7.evaluate() << " ";
+    const int i = position(i1.evaluate(),i2.evaluate(),i3.evaluate(),
+			   i4.evaluate(),i5.evaluate(),i6.evaluate(),
+			   i7.evaluate());
+    cout<<"  "<<(i == outOfBound ? 0.0 : v[i]) << endl;
 }
 
 void MP_data::display(string s) {
     cout<<s<<endl;
-    ((S1)(i1)*(S2)(i2)*(S3)(i3)*(S4)(i4)*(S5)(i5)).Forall(this);
+    ((S1)(i1)*(S2)(i2)*(S3)(i3)*(S4)(i4)*(S5)(i5)*(S6)(i6)*(S7)(i7)).Forall(this);
 }
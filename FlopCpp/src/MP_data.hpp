@@ -20,6 +20,39 @@
 namespace flopc {
 
     class MP_data;
+    class DataFile;
+
+    /** @brief Index into the entries of sparse data.
+        @ingroup INTERNAL_USE
+        @note FOR INTERNAL USE: This is not normally used directly by the
+	calling code.
+	The index values of entry e are columns[k][e], k<dimension.  The
+	columns are not copied.  If the entries are sorted in row-major
+	order they are binary searched within the range of their first
+	index value, otherwise a hash table is built.
+    */
+    class SparseIndex {
+    public:
+	SparseIndex(int nonzeros, const int* const* columns, int dimension,
+		    int firstSize);
+	/// position of the entry with the index values given, or outOfBound
+	int find(const int* element) const;
+	int size() const {
+	    return nonzeros;
+	}
+	/// index values of the entry at position e.
+	void getElement(int e, int* element) const;
+    private:
+	int compare(int e, const int* element) const;
+	size_t slot(const int* element) const;
+
+	int nonzeros;
+	int dimension;
+	const int* columns[maxDimension];
+	bool sorted;
+	std::vector<int> starts;
+	std::vector<int> table;
+    };
 
     /** @brief Reference to a set of data
         @ingroup INTERNAL_USE
@@ -34,23 +67,30 @@ namespace flopc {
 		const MP_index_exp& i3,
 		const MP_index_exp& i4,
 		const MP_index_exp& i5,
-		int s = 0) : 
-	    D(d),I1(i1),I2(i2),I3(i3),I4(i4),I5(i5),C(0),stochastic(s) {}
+		const MP_index_exp& i6,
+		const MP_index_exp& i7,
+		int s = 0);
 
 	~DataRef() {} 
 	DataRef& such_that(const MP_boolean& b);
 	double evaluate() const;
 	int getStage() const;
+	bool factorize(double& factor, std::vector<DataEntry>& entries) const;
 	const DataRef& operator=(const DataRef& r); 
 	const DataRef& operator=(const Constant& c);
 	void evaluate_lhs(double v) const;
 	void operator()() const;
     private:
+	/// position in D of the value referred to, or outOfBound.
+	int position() const;
+
 	MP_data* D;
-	MP_index_exp I1,I2,I3,I4,I5;
+	MP_index_exp I1,I2,I3,I4,I5,I6,I7;
 	Constant C;
 	int stochastic;
 	MP_boolean B;
+	/// number of the indices above which position() evaluates.
+	int slots;
     };
 
     /** @brief Input data set.
@@ -63,12 +103,16 @@ namespace flopc {
         If one wishes to refer to external data instead rather than
         doing a deep copy, use the constructor which takes the value pointer
         as an argument.  This copies the original data pointer value (rather than a deep copy).
+        Sparse data, where most entries are 0, can be given as caller-owned
+        columns of index values and values, or be mapped from a file
+        written by save(), without storing the full product of the sets.
         <br> This is used for construction of :
         @li objective coefficients
         @li constraint coefficients
         @li 'right hand sides'
     */
-    class MP_data : public RowMajor, public Functor , public Named {
+    class MP_data : public RowMajor, public Functor , public Named,
+                    public Stamped {
 	friend class MP_variable;
 	friend class DisplayData;
 	friend class DataRef;
@@ -77,9 +121,10 @@ namespace flopc {
 	void operator()() const;
 	/// similar to value() but copies the same value to all entries.
 	void initialize(double d) {
-	    for (int i=0; i<size(); i++) {
+	    for (int i=0; i<entries(); i++) {
 		v[i] = d;
 	    }
+	    touch();
 	}
 	/** Constructs the MP_data object, and allocates space for data, but
 	    does not initialize the data.
@@ -88,10 +133,14 @@ namespace flopc {
 		const MP_set_base &s2 = MP_set::getEmpty(), 
 		const MP_set_base &s3 = MP_set::getEmpty(),
 		const MP_set_base &s4 = MP_set::getEmpty(), 
-		const MP_set_base &s5 = MP_set::getEmpty()) :
-	    RowMajor(s1.size(),s2.size(),s3.size(),s4.size(),s5.size()),
-	    S1(s1),S2(s2),S3(s3),S4(s4),S5(s5),
-	    v(new double[size()]), manageData(true) 
+		const MP_set_base &s5 = MP_set::getEmpty(), 
+		const MP_set_base &s6 = MP_set::getEmpty(), 
+		const MP_set_base &s7 = MP_set::getEmpty()) :
+	    RowMajor(s1.size(),s2.size(),s3.size(),s4.size(),s5.size(),
+		     s6.size(),s7.size()),
+	    S1(s1),S2(s2),S3(s3),S4(s4),S5(s5),S6(s6),S7(s7),
+	    v(new double[size()]), manageData(true), sparse(0), file(0),
+	    recordedIn(0)
 	    {
 		initialize(0); 
 	    }
@@ -104,27 +153,62 @@ namespace flopc {
 		const MP_set_base &s2 = MP_set::getEmpty(), 
 		const MP_set_base &s3 = MP_set::getEmpty(),
 		const MP_set_base &s4 = MP_set::getEmpty(), 
-		const MP_set_base &s5 = MP_set::getEmpty()) :
-	    RowMajor(s1.size(),s2.size(),s3.size(),s4.size(),s5.size()),
-	    S1(s1),S2(s2),S3(s3),S4(s4),S5(s5),
-	    v(value), manageData(false) 
+		const MP_set_base &s5 = MP_set::getEmpty(), 
+		const MP_set_base &s6 = MP_set::getEmpty(), 
+		const MP_set_base &s7 = MP_set::getEmpty()) :
+	    RowMajor(s1.size(),s2.size(),s3.size(),s4.size(),s5.size(),
+		     s6.size(),s7.size()),
+	    S1(s1),S2(s2),S3(s3),S4(s4),S5(s5),S6(s6),S7(s7),
+	    v(value), manageData(false), sparse(0), file(0), recordedIn(0)
 	    {
 	    }
 
-	~MP_data() {
-	    if (manageData == true) delete[] v;
-	    /// @todo determine cause of seg fault.
-// 	    for (unsigned int i=0; i<myrefs.size(); i++) {
-// 		cout<<"# "<<i<<"   "<<myrefs[i]<<endl;
-// 		delete myrefs[i]; //Gives segmentation fault. I dont know why!
-// 	    }
-	}
+	/** Constructs sparse data over nonzeros caller-owned entries (shallow
+	    copy): entry e has the value value[e] and the index values
+	    indices[0][e], indices[1][e], ... in the sets given.  Each tuple
+	    may occur at most once, all other entries are 0.  Lookups are
+	    cheapest when the entries are sorted in row-major order, otherwise
+	    a hash table of 2 to 4 ints per entry is built.
+	*/
+	MP_data(int nonzeros, double* value, const int* const* indices,
+		const MP_set_base &s1 = MP_set::getEmpty(), 
+		const MP_set_base &s2 = MP_set::getEmpty(), 
+		const MP_set_base &s3 = MP_set::getEmpty(),
+		const MP_set_base &s4 = MP_set::getEmpty(), 
+		const MP_set_base &s5 = MP_set::getEmpty(), 
+		const MP_set_base &s6 = MP_set::getEmpty(), 
+		const MP_set_base &s7 = MP_set::getEmpty()) :
+	    RowMajor(s1.size(),s2.size(),s3.size(),s4.size(),s5.size(),
+		     s6.size(),s7.size()),
+	    S1(s1),S2(s2),S3(s3),S4(s4),S5(s5),S6(s6),S7(s7),
+	    v(value), manageData(false),
+	    sparse(new SparseIndex(nonzeros,indices,dimension(),sizes[0])),
+	    file(0),
+	    recordedIn(0)
+	    {
+	    }
+
+	/** Constructs sparse data from a file written by save(), which is
+	    mapped into memory rather than read.  Changes to the data are
+	    not written back to the file.
+	*/
+	MP_data(const std::string& fileName,
+		const MP_set_base &s1 = MP_set::getEmpty(), 
+		const MP_set_base &s2 = MP_set::getEmpty(), 
+		const MP_set_base &s3 = MP_set::getEmpty(),
+		const MP_set_base &s4 = MP_set::getEmpty(), 
+		const MP_set_base &s5 = MP_set::getEmpty(), 
+		const MP_set_base &s6 = MP_set::getEmpty(), 
+		const MP_set_base &s7 = MP_set::getEmpty());
+
+	~MP_data();
     
 	/// Used to bind and deep copy data into the MP_data data structure.
 	void value(const double* d) {
-	    for (int i=0; i<size(); i++) {
+	    for (int i=0; i<entries(); i++) {
 		v[i] = d[i];
 	    }
+	    touch();
 	}
 
 	/// @todo purpose?
@@ -136,17 +220,22 @@ namespace flopc {
 	    @note this is used internally, but may also be useful for spot
 	    checking data or in other expressions.
 	*/
-	double& operator()(int lcli1, int lcli2=0, int lcli3=0, int lcli4=0, int lcli5=0) {
+	double& operator()(int lcli1, int lcli2=0, int lcli3=0, int lcli4=0, int lcli5=0,
+			   int lcli6=0, int lcli7=0) {
 	    lcli1 = S1.check(lcli1);
 	    lcli2 = S2.check(lcli2);
 	    lcli3 = S3.check(lcli3);
 	    lcli4 = S4.check(lcli4);
 	    lcli5 = S5.check(lcli5);
-	    int i = f(lcli1,lcli2,lcli3,lcli4,lcli5);
+	    lcli6 = S6.check(lcli6);
+	    lcli7 = S7.check(lcli7);
+	    int i = position(lcli1,lcli2,lcli3,lcli4,lcli5,lcli6,lcli7);
 	    if (i == outOfBound) {
 		outOfBoundData = 0;
 		return outOfBoundData;
 	    } else {
+		// The reference may be written through, so assume it is.
+		touch();
 		return v[i];
 	    }
 	}
@@ -160,37 +249,107 @@ namespace flopc {
 	    const MP_index_exp& lcli2 = MP_index_exp::getEmpty(),
 	    const MP_index_exp& lcli3 = MP_index_exp::getEmpty(),
 	    const MP_index_exp& lcli4 = MP_index_exp::getEmpty(),
-	    const MP_index_exp& lcli5 = MP_index_exp::getEmpty()
+	    const MP_index_exp& lcli5 = MP_index_exp::getEmpty(),
+	    const MP_index_exp& lcli6 = MP_index_exp::getEmpty(),
+	    const MP_index_exp& lcli7 = MP_index_exp::getEmpty()
 	    ) {
-	    myrefs.push_back(new DataRef(this, lcli1, lcli2, lcli3, lcli4, lcli5));
+	    myrefs.push_back(new DataRef(this, lcli1, lcli2, lcli3, lcli4, lcli5,
+					 lcli6, lcli7));
 	    return *myrefs.back();
 	}
     
 
 	/// For displaying data in a human readable format.
 	void display(std::string s = "");
+
+	/** Writes the nonzero entries to a file, which the constructor
+	    taking a file name maps into memory.  The file holds a header,
+	    then one column of ints for the values of each set, then the
+	    values as doubles, all in the byte order of the machine.
+	    @return false if the file could not be written
+	*/
+	bool save(const std::string& fileName) const;
+
+	/** number of values stored: the size of the product of the sets,
+	    or the number of entries of sparse data.  initialize() and
+	    value() work on these.
+	*/
+	int entries() const {
+	    return sparse == 0 ? size() : sparse->size();
+	}
+
+	/** Returns true if the data may have changed after the stamp t.
+	    Data bound to an external array (shallow copy) can be changed
+	    behind our back, so it is always considered modified.
+	    @see Stamped
+	*/
+	bool modifiedSince(unsigned long t) const {
+	    return (manageData == false && file == 0) || getStamp() > t;
+	}
+
+	/** Starts collecting every MP_data which is read through a DataRef
+	    into used (each at most once), until stopRecording() is called.
+	    @note For internal use: MP_model uses this to find out which
+	    constraint blocks depend on which data.
+	*/
+	static void startRecording(std::vector<const MP_data*>& used);
+	/// Ends a recording started by startRecording()
+	static void stopRecording();
     protected:
 	std::vector<DataRef*> myrefs;
     private:
 	MP_data(const MP_data&); // Forbid copy constructor
 	MP_data& operator=(const MP_data&); // Forbid assignment
 
+	int dimension() const;
+	/// position of the value with the (checked) index values given.
+	int position(int i1, int i2, int i3, int i4, int i5, int i6,
+		     int i7) const {
+	    const int element[maxDimension] = {i1, i2, i3, i4, i5, i6, i7};
+	    for (int k=0; k<maxDimension; k++) {
+		if (element[k] == outOfBound) {
+		    return outOfBound;
+		}
+	    }
+	    return position(element);
+	}
+	int position(const int* element) const {
+	    if (sparse == 0) {
+		return f(element);
+	    }
+	    return sparse->find(element);
+	}
+
+	void noteUse() const {
+	    if (recording() != 0 && recordedIn() != recording()) {
+		recordedIn() = recording();
+		recorded()->push_back(this);
+	    }
+	}
+
 	static double outOfBoundData;
+	static PerThread<std::vector<const MP_data*>*> recorded;
+	static PerThread<unsigned long> recording;
 
-	MP_index i1,i2,i3,i4,i5;
-	const MP_set_base &S1,&S2,&S3,&S4,&S5;
+	MP_index i1,i2,i3,i4,i5,i6,i7;
+	const MP_set_base &S1,&S2,&S3,&S4,&S5,&S6,&S7;
 	double* v;
 	bool manageData;
+	SparseIndex* sparse;
+	DataFile* file;
+	PerThread<unsigned long> recordedIn;
     };
 
     class MP_stochastic_data : public MP_data {
     public:
+	/// the current model keeps track of the stages of its coefficients.
 	MP_stochastic_data(const MP_set_base &s1 = MP_set::getEmpty(), 
 			   const MP_set_base &s2 = MP_set::getEmpty(), 
 			   const MP_set_base &s3 = MP_set::getEmpty(),
 			   const MP_set_base &s4 = MP_set::getEmpty(), 
-			   const MP_set_base &s5 = MP_set::getEmpty()) :
-	    MP_data(s1,s2,s3,s4,s5) {}
+			   const MP_set_base &s5 = MP_set::getEmpty(), 
+			   const MP_set_base &s6 = MP_set::getEmpty(), 
+			   const MP_set_base &s7 = MP_set::getEmpty());
 
 	using flopc::MP_data::operator();
 	DataRef& operator() (
@@ -198,9 +357,12 @@ namespace flopc {
 	    const MP_index_exp& lcli2 = MP_index_exp::getEmpty(),
 	    const MP_index_exp& lcli3 = MP_index_exp::getEmpty(),
 	    const MP_index_exp& lcli4 = MP_index_exp::getEmpty(),
-	    const MP_index_exp& lcli5 = MP_index_exp::getEmpty()
+	    const MP_index_exp& lcli5 = MP_index_exp::getEmpty(),
+	    const MP_index_exp& lcli6 = MP_index_exp::getEmpty(),
+	    const MP_index_exp& lcli7 = MP_index_exp::getEmpty()
 	    ) {
-	    myrefs.push_back(new DataRef(this, lcli1, lcli2, lcli3, lcli4, lcli5, 1));
+	    myrefs.push_back(new DataRef(this, lcli1, lcli2, lcli3, lcli4, lcli5,
+					 lcli6, lcli7, 1));
 	    return *myrefs.back();
 	}
     };
@@ -19,6 +19,7 @@ namespace flopc {
         return MP_domain(const_cast<MP_domain_set*>(this));
     }
 
+    /// Calls F for the elements where all the conditions hold.
     class Functor_conditional : public Functor {
     public:
         Functor_conditional(const Functor* f, const std::vector<MP_boolean> & condition)
@@ -37,22 +38,29 @@ namespace flopc {
 	    }
 	}
 	const Functor* F;
-	std::vector<MP_boolean> Condition;
+	const std::vector<MP_boolean>& Condition;
     };	
 }
 
 using namespace flopc;
 
-const MP_domain* MP_domain::Empty = NULL;
+namespace {
+    // outlives any model, so it is kept out of their arenas
+    const MP_domain* makeEmpty() {
+	Arena::Scope scope(0);
+	return new MP_domain(new MP_domain_set(&MP_set::getEmpty(),&MP_set::getEmpty()));
+    }
+}
 
 const MP_domain& MP_domain::getEmpty() {
-    if(Empty==NULL) {
-	Empty= new MP_domain(new MP_domain_set(&MP_set::getEmpty(),&MP_set::getEmpty()));
-    }
+    // initialized once even if several threads get here first
+    static const MP_domain* Empty = makeEmpty();
     return *Empty;
 }
 
 
+PerThread<bool> MP_domain_base::threadLocalLinks(false);
+
 MP_domain_base::MP_domain_base() : count(0), donext(0) {}
 MP_domain_base::~MP_domain_base() {}
 
@@ -84,11 +92,16 @@ MP_domain MP_domain::such_that(const MP_boolean& b) {
 
 void MP_domain::Forall(const Functor* op) const {
     if (condition.size()>0) {
-        last->donext = new Functor_conditional(op,condition);
+        // Lives for the traversal only, it is called for every element
+        // but made once per call.
+        const Functor_conditional conditional(op,condition);
+        last->donext() = &conditional;
+        operator->()->operator()();
+        last->donext() = op;
     } else {
-        last->donext = op;
+        last->donext() = op;
+        operator->()->operator()();
     }
-    operator->()->operator()();
 }
 
 const MP_set_base* MP_domain_set::getSet() const {
@@ -105,12 +118,12 @@ int MP_domain_set::evaluate() const {
 
 void MP_domain_set::operator()() const {
     if (I->isInstantiated() == true) {
-        (*donext)(); 
+        (*donext())(); 
     } else {
         I->instantiate();
         for (int k=0; k<S->size(); k++) {
             I->assign(k);
-            (*donext)();
+            (*donext())();
         }
         I->assign(0);
         I->unInstantiate();
@@ -129,7 +142,11 @@ flopc::MP_domain flopc::operator*(const flopc::MP_domain& a, const flopc::MP_dom
         return a;
     } else {
         MP_domain retval = a;
-        retval.last->donext = b.operator->();
+        if (MP_domain_base::threadLocalLinks() == true) {
+            retval.last->donext() = b.operator->();
+        } else {
+            retval.last->donext.setAll(b.operator->());
+        }
         const_cast<MP_domain&>(b).increment();
         const_cast<MP_domain&>(a).increment();
         retval.last = b.last;
@@ -42,7 +42,15 @@ public:
     virtual const MP_set_base* getSet() const = 0;
     void display()const;
     virtual size_t size() const ;
-    const Functor* donext;
+    /** what to do for each element: the next domain of a product, or
+        the functor passed to MP_domain::Forall.
+    */
+    PerThread<const Functor*> donext;
+    /** If set for the calling thread, products of domains only link the
+        domains for this thread.  MP_model sets it while generating in
+        parallel, when products are only formed for the current traversal.
+    */
+    static PerThread<bool> threadLocalLinks;
 };
 
     /** @brief Range over which some other constuct is defined.
@@ -63,6 +71,7 @@ class MP_domain : public Handle<MP_domain_base*> {
     
     friend class MP_constraint;
     friend class MP_index_exp;
+    friend class GenerationProgram;
 public:
     /** @briefConstructs a set  which points to nothing.
         @note This is not the same as the "empty" set.
@@ -94,7 +103,6 @@ public:
 private:
 	std::vector<MP_boolean> condition;
     Handle<MP_domain_base*> last;
-    static const MP_domain* Empty;
 };
 
     /** @brief Range over which some other constuct is defined.
@@ -205,26 +213,26 @@ public:
 	    }
 	}
 	if (allBound == true) {
-	    (*donext)(); 
+	    (*donext())(); 
 	} else {
-	    std::map<std::vector<int>, int>::const_iterator i;
-	    int counter = 0;
-	    for (i = S->elements.begin(); i != S->elements.end(); i++) {
-		S->assign(counter);
-		counter++;
+	    S->sort();
+	    const int size = S->size();
+	    for (int e=0; e<size; e++) {
+		const int* element = &S->elements[S->order[e]*nbr];
+		S->assign(e);
 		bool goOn = true;
 		for (int j=0; j<nbr; j++) {
 		    if (isBound[j] == true) {
-			if (I[j]->evaluate() != i->first[j]) {
+			if (I[j]->evaluate() != element[j]) {
 			    goOn = false;
 			    break;
 			}
 		    } else {
-			I[j]->assign(i->first[j]);
+			I[j]->assign(element[j]);
 		    }
 		}
 		if (goOn == true) {
-		    (*donext)();
+		    (*donext())();
 		}
 	    }
 	}
@@ -7,6 +7,7 @@
 //****************************************************************************
 
 #include <sstream>
+#include <algorithm>
 #include "MP_expression.hpp"
 #include "MP_constant.hpp"
 #include "MP_boolean.hpp"
@@ -35,8 +36,11 @@ private:
     int getStage() const {
 	return C->getStage(); //NB to be changed
     }
+    bool factorize(double& factor, vector<DataEntry>& entries) const {
+	return C->factorize(factor,entries);
+    }
     void generate(const MP_domain& domain,
-		  vector<Constant> multiplicators,
+		  const vector<Constant>& multiplicators,
 		  GenerateFunctor& f,
 		  double m) const {
 	f.setMultiplicator(multiplicators,m);
@@ -59,12 +63,18 @@ private:
 	return left->level()+right->level(); 
     }
     void generate(const MP_domain& domain,
-		  vector<Constant> multiplicators,
+		  const vector<Constant>& multiplicators,
 		  GenerateFunctor& f,
 		  double m) const { 
 	left->generate(domain, multiplicators,f,m);
 	right->generate(domain, multiplicators,f,m);
     }
+    void compile(vector<MP_domain>& domains,
+		 vector<Constant>& multiplicators,
+		 double m, GenerationProgram& p) const {
+	left->compile(domains, multiplicators, m, p);
+	right->compile(domains, multiplicators, m, p);
+    }
 };
 
 class Expression_minus : public Expression_operator {
@@ -78,12 +88,18 @@ private:
 	return left->level()-right->level(); 
     }
     void generate(const MP_domain& domain,
-		  vector<Constant> multiplicators,
+		  const vector<Constant>& multiplicators,
 		  GenerateFunctor& f,
 		  double m) const {
 	left->generate(domain, multiplicators,f,m);
 	right->generate(domain, multiplicators,f,-m);
     }
+    void compile(vector<MP_domain>& domains,
+		 vector<Constant>& multiplicators,
+		 double m, GenerationProgram& p) const {
+	left->compile(domains, multiplicators, m, p);
+	right->compile(domains, multiplicators, -m, p);
+    }
 };
 
 class Expression_mult : public MP_expression_base {
@@ -97,11 +113,19 @@ private:
 	return left->evaluate()*right->level(); 
     }
     void generate(const MP_domain& domain,
-		  vector<Constant> multiplicators,
+		  const vector<Constant>& multiplicators,
 		  GenerateFunctor& f,
 		  double m) const {
+	vector<Constant> mults(multiplicators);
+	mults.push_back(left);
+	right->generate(domain, mults, f, m);
+    }
+    void compile(vector<MP_domain>& domains,
+		 vector<Constant>& multiplicators,
+		 double m, GenerationProgram& p) const {
 	multiplicators.push_back(left);
-	right->generate(domain, multiplicators, f, m);
+	right->compile(domains, multiplicators, m, p);
+	multiplicators.pop_back();
     }
     void insertVariables(set<MP_variable*>& v) const {
 	right->insertVariables(v);
@@ -116,25 +140,32 @@ private:
     Expression_sum(const MP_domain& d, const MP_expression& e) : 
 	D(d), exp(e) {}
     void operator()() const {
-	the_sum += exp->level();
+	the_sum() += exp->level();
     }
     double level() const {
-	the_sum = 0;
+	the_sum() = 0;
 	D.Forall(this);
-	return the_sum;
+	return the_sum();
     } 
     void generate(const MP_domain& domain,
-		  vector<Constant> multiplicators,
+		  const vector<Constant>& multiplicators,
 		  GenerateFunctor& f,
 		  double m) const {
 	// The order, D*domain (NOT domain*D), is important for efficiency! 
 	exp->generate(D*domain, multiplicators, f, m); 
     }
+    void compile(vector<MP_domain>& domains,
+		 vector<Constant>& multiplicators,
+		 double m, GenerationProgram& p) const {
+	domains.push_back(D);
+	exp->compile(domains, multiplicators, m, p);
+	domains.pop_back();
+    }
     void insertVariables(set<MP_variable*>& v) const {
 	exp->insertVariables(v);
     }
 
-    mutable double the_sum;
+    PerThread<double> the_sum;
     MP_domain D;
     MP_expression exp;
 };
@@ -189,28 +220,439 @@ int GenerateFunctor::row_number() const {
     return R->row_number();
 }
 
+double CoefRecipes::add(const TerminalExpression* c, const Constant* mults,
+			size_t number, double m) {
+    const size_t size = entries.size();
+    double f = m;
+    bool product = true;
+    for (size_t i=0; i<number && product==true; i++) {
+	product = mults[i]->factorize(f,entries);
+    }
+    if (product == true) {
+	product = c->factorize(f,entries);
+    }
+    double value = f;
+    if (product == true) {
+	for (size_t e=size; e<entries.size(); e++) {
+	    value *= entries[e].value();
+	}
+    } else {
+	complete = false;
+	entries.resize(size);
+	value = m;
+	for (size_t i=0; i<number; i++) {
+	    value *= mults[i]->evaluate();
+	}
+	value *= c->getValue();
+    }
+    factor.push_back(f);
+    first.push_back(static_cast<int>(entries.size()));
+    return value;
+}
+
 void GenerateFunctor::operator()() const {
-    double multiplicator = m_;
-    int stage = 0;
-    for (unsigned int i=0; i<multiplicators.size(); i++) {
-	multiplicator *= multiplicators[i]->evaluate();
-	if (multiplicators[i]->getStage() > stage) {
-	    stage = multiplicators[i]->getStage();
+    Iterations++;
+    emit(C, multiplicators.empty() ? 0 : &multiplicators[0],
+	 multiplicators.size(), m_);
+}
+
+void GenerateFunctor::emit(const TerminalExpression* C, 
+			   const Constant* multiplicators,
+			   size_t number, double m) const {
+    double multiplicator = m;
+    if (Recipes == 0) {
+	for (size_t i=0; i<number; i++) {
+	    multiplicator *= multiplicators[i]->evaluate();
 	}
     }
     int rowNumber = row_number();
     if (rowNumber != outOfBound) {
 	int colNumber = C->getColumn();
 	if ( colNumber != outOfBound  ) {
-	    double val = multiplicator*C->getValue();
-	    int tstage = C->getStage();
-	    if (tstage > stage) {
-		stage = tstage;
-	    }
+	    double val = Recipes == 0 ? multiplicator*C->getValue() :
+		Recipes->add(C,multiplicators,number,m);
 	    // For the SP core it might be usefull to generate zero coefs
 	    // if (val != 0) {
-	    Coefs.push_back(Coef(colNumber, rowNumber, val, stage));
+	    Coefs.push_back(Coef(colNumber, rowNumber, val));
+	    if (Counts != 0) {
+		Counts[colNumber+1]++;
+	    }
+	    if (Stages != 0) {
+		int stage = 0;
+		for (size_t i=0; i<number; i++) {
+		    if (multiplicators[i]->getStage() > stage) {
+			stage = multiplicators[i]->getStage();
+		    }
+		}
+		if (C->getStage() > stage) {
+		    stage = C->getStage();
+		}
+		Stages->push_back(stage);
+	    }
 	    //}
 	}
     }
 }
+
+/** Continues a program at a given instruction, for domains which call
+    the functor in their donext for each of their elements.
+*/
+class GenerationProgram::Resume : public Functor {
+public:
+    Resume(const GenerationProgram* p, size_t pc, GenerateFunctor& f) :
+	P(p), Pc(pc), F(f) {}
+    void operator()() const {
+	P->run(Pc,F);
+    }
+private:
+    const GenerationProgram* P;
+    size_t Pc;
+    GenerateFunctor& F;
+};
+
+void GenerationProgram::compile(const MP_expression_base* e, 
+				const MP_domain& d, double m) {
+    vector<MP_domain> domains(1,d);
+    vector<Constant> multiplicators;
+    e->compile(domains,multiplicators,m,*this);
+}
+
+void GenerationProgram::clear() {
+    instructions.clear();
+    starts.clear();
+    terms.clear();
+    subsetLoops.clear();
+    domains.clear();
+}
+
+/// orders positions in a subset by the components of their elements.
+class GenerationProgram::ElementLess {
+public:
+    ElementLess(const SUBSETREF* s, const vector<int>& c) :
+	S(s), Components(c) {}
+    bool operator()(int a, int b) const {
+	const int* x = S->getElement(a);
+	const int* y = S->getElement(b);
+	for (size_t j=0; j<Components.size(); j++) {
+	    if (x[Components[j]] != y[Components[j]]) {
+		return x[Components[j]] < y[Components[j]];
+	    }
+	}
+	return false;
+    }
+private:
+    const SUBSETREF* S;
+    const vector<int>& Components;
+};
+
+void GenerationProgram::prepare() {
+    for (size_t l=0; l<subsetLoops.size(); l++) {
+	SubsetLoop& sl = subsetLoops[l];
+	const int size = sl.S->getSize();
+	if (sl.prepared == size) {
+	    continue;
+	}
+	sl.prepared = size;
+	if (sl.inOrder == false) {
+	    sl.order.resize(size);
+	    for (int p=0; p<size; p++) {
+		sl.order[p] = p;
+	    }
+	    std::stable_sort(sl.order.begin(),sl.order.end(),
+			     ElementLess(sl.S,sl.components));
+	}
+	// The elements are sorted by their leading index first, so those
+	// with the same value of it are next to each other.
+	const int leading = sl.components[0];
+	int values = 0;
+	for (int p=0; p<size; p++) {
+	    values = std::max(values,sl.S->getElement(p)[leading]+1);
+	}
+	sl.first.assign(values+1,0);
+	for (int p=0; p<size; p++) {
+	    sl.first[sl.S->getElement(p)[leading]+1]++;
+	}
+	for (int v=0; v<values; v++) {
+	    sl.first[v+1] += sl.first[v];
+	}
+    }
+}
+
+void GenerationProgram::addTerm(const TerminalExpression* c, 
+				const vector<MP_domain>& lcl_domains,
+				const vector<Constant>& multiplicators,
+				double m) {
+    Term t;
+    t.C = c;
+    t.E = 0;
+    t.m = m;
+    t.multiplicators = multiplicators;
+    starts.push_back(instructions.size());
+
+    // The domain of a term is the product of the domains entered, the
+    // last one entered outermost, just as Expression_sum::generate forms
+    // it.  The product leaves out the empty domain.
+    const MP_domain_base* empty = MP_domain::getEmpty().operator->();
+    vector<const MP_domain*> used;
+    for (size_t k=lcl_domains.size(); k>0; k--) {
+	if (lcl_domains[k-1].operator->() != empty) {
+	    used.push_back(&lcl_domains[k-1]);
+	}
+    }
+    if (used.empty()) {
+	used.push_back(&lcl_domains[0]);
+    }
+    vector<Instruction> loops;
+    for (size_t k=0; k<used.size(); k++) {
+	const MP_domain& d = *used[k];
+	t.conditions.insert(t.conditions.end(),d.condition.begin(),
+			    d.condition.end());
+	MP_domain_base* p = d.operator->();
+	while (p != 0) {
+	    Instruction ins;
+	    ins.index = 0;
+	    ins.set = 0;
+	    ins.domain = 0;
+	    ins.term = -1;
+	    ins.loop = -1;
+	    MP_domain_set* s = dynamic_cast<MP_domain_set*>(p);
+	    if (s != 0) {
+		ins.op = SET_LOOP;
+		ins.index = s->getIndex();
+		ins.set = s->getSet();
+	    } else {
+		ins.op = DOMAIN_LOOP;
+		ins.domain = p;
+	    }
+	    loops.push_back(ins);
+	    if (p == d.last.operator->()) {
+		break;
+	    }
+	    p = const_cast<MP_domain_base*>(
+		dynamic_cast<const MP_domain_base*>(p->donext()));
+	}
+	domains.push_back(d);
+    }
+    for (size_t i=0; i<t.conditions.size(); i++) {
+	t.conditions[i]->conjuncts(t.tests);
+    }
+    addSubsetLoops(loops,t);
+    instructions.insert(instructions.end(),loops.begin(),loops.end());
+
+    Instruction ins;
+    ins.op = TERM;
+    ins.index = 0;
+    ins.set = 0;
+    ins.domain = 0;
+    ins.term = static_cast<int>(terms.size());
+    ins.loop = -1;
+    instructions.push_back(ins);
+    terms.push_back(t);
+}
+
+/** A term whose condition requires the indices of consecutive set loops
+    to form an element of a subset only has to visit the elements of the
+    subset.  The loops are replaced by a single loop over the elements,
+    and the membership test is dropped, which is the difference between
+    the size of the subset and that of the product of its sets.
+*/
+void GenerationProgram::addSubsetLoops(vector<Instruction>& loops, Term& t) {
+    vector<MP_index*> indices;
+    vector<const MP_set_base*> sets;
+    size_t i = 0;
+    while (i < t.tests.size()) {
+	const SUBSETREF* S = t.tests[i]->membership();
+	if (S == 0 || S->getIndices(indices,sets) == false) {
+	    i++;
+	    continue;
+	}
+	const size_t n = indices.size();
+	vector<size_t> at(n,loops.size());
+	bool usable = true;
+	for (size_t k=0; k<n && usable==true; k++) {
+	    for (size_t j=0; j<loops.size(); j++) {
+		if (loops[j].op == SET_LOOP && loops[j].index == indices[k]) {
+		    if (at[k] != loops.size() || loops[j].set != sets[k]) {
+			usable = false;
+		    }
+		    at[k] = j;
+		}
+	    }
+	    if (at[k] == loops.size()) {
+		usable = false;
+	    }
+	}
+	size_t first = loops.size();
+	if (usable == true) {
+	    first = *std::min_element(at.begin(),at.end());
+	    vector<bool> covered(n,false);
+	    for (size_t k=0; k<n; k++) {
+		if (at[k] >= first+n || covered[at[k]-first] == true) {
+		    usable = false;
+		    break;
+		}
+		covered[at[k]-first] = true;
+	    }
+	}
+	if (usable == false) {
+	    i++;
+	    continue;
+	}
+
+	SubsetLoop sl;
+	sl.S = S;
+	sl.inOrder = true;
+	sl.prepared = -1;
+	for (size_t j=0; j<n; j++) {
+	    const int k = static_cast<int>(
+		std::find(at.begin(),at.end(),first+j)-at.begin());
+	    sl.indices.push_back(indices[k]);
+	    sl.components.push_back(k);
+	    if (k != static_cast<int>(j)) {
+		sl.inOrder = false;
+	    }
+	}
+	Instruction ins;
+	ins.op = SUBSET_LOOP;
+	ins.index = 0;
+	ins.set = 0;
+	ins.domain = 0;
+	ins.term = -1;
+	ins.loop = static_cast<int>(subsetLoops.size());
+	subsetLoops.push_back(sl);
+	loops.erase(loops.begin()+first,loops.begin()+first+n);
+	loops.insert(loops.begin()+first,ins);
+	t.tests.erase(t.tests.begin()+i);
+    }
+}
+
+void GenerationProgram::addExpression(const MP_expression_base* e, 
+				      const vector<MP_domain>& lcl_domains,
+				      const vector<Constant>& multiplicators,
+				      double m) {
+    Term t;
+    t.C = 0;
+    t.E = e;
+    t.m = m;
+    t.multiplicators = multiplicators;
+    t.domains = lcl_domains;
+    starts.push_back(instructions.size());
+
+    Instruction ins;
+    ins.op = EXPRESSION;
+    ins.index = 0;
+    ins.set = 0;
+    ins.domain = 0;
+    ins.term = static_cast<int>(terms.size());
+    ins.loop = -1;
+    instructions.push_back(ins);
+    terms.push_back(t);
+}
+
+void GenerationProgram::run(GenerateFunctor& f) const {
+    for (size_t k=0; k<starts.size(); k++) {
+	run(starts[k],f);
+    }
+}
+
+void GenerationProgram::run(size_t pc, GenerateFunctor& f) const {
+    const Instruction& ins = instructions[pc];
+    switch (ins.op) {
+	case SET_LOOP:
+	    if (ins.index->isInstantiated() == true) {
+		run(pc+1,f);
+	    } else {
+		const int size = ins.set->size();
+		ins.index->instantiate();
+		for (int k=0; k<size; k++) {
+		    ins.index->assign(k);
+		    run(pc+1,f);
+		}
+		ins.index->assign(0);
+		ins.index->unInstantiate();
+	    }
+	    break;
+	case SUBSET_LOOP: {
+	    const SubsetLoop& sl = subsetLoops[ins.loop];
+	    const size_t n = sl.indices.size();
+	    bool bound[maxDimension];
+	    for (size_t j=0; j<n; j++) {
+		bound[j] = sl.indices[j]->isInstantiated();
+		if (bound[j] == false) {
+		    sl.indices[j]->instantiate();
+		}
+	    }
+	    // With the leading index bound only the elements having its
+	    // value are visited.
+	    int begin = 0;
+	    int end = sl.inOrder == true ? sl.S->getSize() :
+		static_cast<int>(sl.order.size());
+	    if (bound[0] == true) {
+		const int value = sl.indices[0]->evaluate();
+		if (value >= 0 && value+1 < static_cast<int>(sl.first.size())) {
+		    begin = sl.first[value];
+		    end = sl.first[value+1];
+		} else {
+		    end = 0;
+		}
+	    }
+	    for (int p=begin; p<end; p++) {
+		const int* element =
+		    sl.S->getElement(sl.inOrder == true ? p : sl.order[p]);
+		bool member = true;
+		for (size_t j=0; j<n; j++) {
+		    const int value = element[sl.components[j]];
+		    if (bound[j] == true) {
+			if (sl.indices[j]->evaluate() != value) {
+			    member = false;
+			    break;
+			}
+		    } else {
+			sl.indices[j]->assign(value);
+		    }
+		}
+		if (member == true) {
+		    run(pc+1,f);
+		}
+	    }
+	    for (size_t j=0; j<n; j++) {
+		if (bound[j] == false) {
+		    sl.indices[j]->assign(0);
+		    sl.indices[j]->unInstantiate();
+		}
+	    }
+	    break;
+	}
+	case DOMAIN_LOOP: {
+	    // The domain may link to the next one of its chain, which later
+	    // compilations walk, so the link is put back afterwards.
+	    const Functor* const link = ins.domain->donext();
+	    Resume next(this,pc+1,f);
+	    ins.domain->donext() = &next;
+	    ins.domain->operator()();
+	    ins.domain->donext() = link;
+	    break;
+	}
+	case TERM: {
+	    const Term& t = terms[ins.term];
+	    f.countIteration();
+	    for (size_t i=0; i<t.tests.size(); i++) {
+		if (t.tests[i]->evaluate() == false) {
+		    return;
+		}
+	    }
+	    f.emit(t.C, t.multiplicators.empty() ? 0 : &t.multiplicators[0],
+		   t.multiplicators.size(), t.m);
+	    break;
+	}
+	case EXPRESSION: {
+	    const Term& t = terms[ins.term];
+	    MP_domain d = t.domains[0];
+	    for (size_t k=1; k<t.domains.size(); k++) {
+		d = t.domains[k]*d;
+	    }
+	    t.E->generate(d, t.multiplicators, f, t.m);
+	    break;
+	}
+    }
+}
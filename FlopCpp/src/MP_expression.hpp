@@ -24,21 +24,44 @@ namespace flopc {
     class Row;
     class MP_variable;
     class VariableRef;
-    class CoefLess;
-
     /** @brief Internal representation of a Coefficient in a matrix.
         @ingroup INTERNAL_USE
         @note FOR INTERNAL USE: This is not normally used directly by the
         calling code.
+        @note The stage of a coefficient is only of interest for stochastic
+        models, so it is kept apart (see GenerateFunctor::setStages) and a
+        coefficient takes 16 bytes instead of 24.
     */
     struct Coef {
-	Coef(int c, int r, double v, int s = 0) : 
-	    col(c), row(r), stage(s), val(v)  {}
-	int col, row, stage;
+	Coef(int c, int r, double v) : 
+	    col(c), row(r), val(v)  {}
+	int col, row;
 	double val;
     };
 
     class TerminalExpression;
+    class MP_expression_base;
+
+    /** @brief How the coefficients generated by a GenerateFunctor are
+        computed from MP_data values, recorded for model templates (see
+        MP_model::useTemplate()).
+        @ingroup INTERNAL_USE
+        Coefficient k is factor[k] times the values of entries[first[k]],
+        ..., entries[first[k+1]-1].  complete is false if some coefficient
+        is no such product.
+    */
+    struct CoefRecipes {
+	CoefRecipes() : first(1,0), complete(true) {}
+	/** Records the recipe of the coefficient of c multiplied by m and
+	    the number multiplicators starting at mults, returns its value.
+	*/
+	double add(const TerminalExpression* c, const Constant* mults,
+		   size_t number, double m);
+	std::vector<double> factor;
+	std::vector<int> first;
+	std::vector<DataEntry> entries;
+	bool complete;
+    };
 
     /** @brief Functor to facilitate generation of coefficients.
         @ingroup INTERNAL_USE
@@ -47,28 +70,69 @@ namespace flopc {
     */
     class GenerateFunctor : public Functor {
     public:
-	GenerateFunctor(std::vector<Coef>& coefs) : Coefs(coefs) {}
+	GenerateFunctor(std::vector<Coef>& coefs) : 
+	    Counts(0), Stages(0), Recipes(0), Iterations(0), Coefs(coefs) {}
 
 	virtual ~GenerateFunctor(){}
 
 	void setConstraint(MP_constraint* r) {
 	    R = r;
 	}
-	void setMultiplicator(std::vector<Constant>& mults, double m) {
+	void setMultiplicator(const std::vector<Constant>& mults, double m) {
 	    multiplicators = mults;
 	    m_ = m;
 	}
 	void setTerminalExpression(const TerminalExpression* c) {
 	    C = c;
 	}
+	/** Makes the functor count the coefficients of each column while
+	    generating them: counts[col+1] for column col, counts[0] for the
+	    right hand side.
+	*/
+	void setColumnCounts(int* counts) {
+	    Counts = counts;
+	}
+	/** Makes the functor record the stage of each coefficient in
+	    stages, parallel to the coefficients.  Only needed for
+	    stochastic models, without it the stages are not computed.
+	*/
+	void setStages(std::vector<int>* stages) {
+	    Stages = stages;
+	}
+	/** Makes the functor record in recipes how each coefficient is
+	    computed.  The values are then computed from the recipes, so
+	    MP_data recording only sees the data read otherwise.
+	*/
+	void setRecipes(CoefRecipes* recipes) {
+	    Recipes = recipes;
+	}
 	virtual int row_number() const;
 
+	/// counts a visit of a term by the domain loops.
+	void countIteration() const {
+	    Iterations++;
+	}
+	/// returns the number of visits of a term, see countIteration().
+	size_t getIterations() const {
+	    return Iterations;
+	}
+
 	void operator()() const;
 
+	/** Generates the coefficient of terminal expression c multiplied by
+	    m and the number multiplicators starting at mults.
+	*/
+	void emit(const TerminalExpression* c, const Constant* mults,
+		  size_t number, double m) const;
+
 	double m_;
 	std::vector<Constant> multiplicators;
 	MP_constraint* R;
 	const TerminalExpression* C;
+	int* Counts;
+	std::vector<int>* Stages;
+	CoefRecipes* Recipes;
+	mutable size_t Iterations;
 	std::vector<Coef>& Coefs;
     };
 
@@ -85,12 +149,92 @@ namespace flopc {
 	}
     };
 
+    /** @brief Flat form of expressions over a domain, for generating
+        their coefficients.
+        @ingroup INTERNAL_USE
+        @note FOR INTERNAL USE: This is not normally used directly by the
+        calling code.
+        Compiling walks the expression tree once and lowers every term to
+        a loop for each index of its domain, followed by the term with its
+        multiplicators and conditions.  Running the program then needs
+        neither the tree nor the domain products, and does not copy or
+        allocate anything.
+    */
+    class GenerationProgram {
+    public:
+	/// Adds expression e multiplied by m over domain d to the program.
+	void compile(const MP_expression_base* e, const MP_domain& d, double m);
+	void clear();
+	/** Brings the program up to date with the subsets it loops over.
+	    Must be called before run() whenever subsets may have changed,
+	    and not while the program is running.
+	*/
+	void prepare();
+	/// Generates the coefficients of the program through f.
+	void run(GenerateFunctor& f) const;
+
+	/// Used by MP_expression_base::compile for a terminal expression.
+	void addTerm(const TerminalExpression* c, 
+		     const std::vector<MP_domain>& domains,
+		     const std::vector<Constant>& multiplicators, double m);
+	/// Used by MP_expression_base::compile for anything else.
+	void addExpression(const MP_expression_base* e, 
+			   const std::vector<MP_domain>& domains,
+			   const std::vector<Constant>& multiplicators, double m);
+    private:
+	enum Operation {SET_LOOP, SUBSET_LOOP, DOMAIN_LOOP, TERM, EXPRESSION};
+	struct Instruction {
+	    Operation op;
+	    MP_index* index;
+	    const MP_set_base* set;
+	    MP_domain_base* domain;
+	    int term;
+	    int loop;
+	};
+	struct Term {
+	    const TerminalExpression* C;
+	    const MP_expression_base* E;
+	    double m;
+	    std::vector<Constant> multiplicators;
+	    std::vector<MP_boolean> conditions;
+	    std::vector<const Boolean_base*> tests;
+	    std::vector<MP_domain> domains;
+	};
+	/** Consecutive loops over the indices of a subset, which the term
+	    requires to be an element of it.  They are replaced by a loop
+	    over the elements, sorted as the loops would have visited them.
+	*/
+	struct SubsetLoop {
+	    const SUBSETREF* S;
+	    std::vector<MP_index*> indices;
+	    std::vector<int> components;
+	    bool inOrder;
+	    std::vector<int> order;
+	    /** positions first[v] up to first[v+1] hold the elements whose
+		leading index has value v.
+	    */
+	    std::vector<int> first;
+	    /// the size of the subset order and first were prepared for.
+	    int prepared;
+	};
+	class Resume;
+	class ElementLess;
+	void addSubsetLoops(std::vector<Instruction>& loops, Term& t);
+	void run(size_t pc, GenerateFunctor& f) const;
+
+	std::vector<Instruction> instructions;
+	std::vector<size_t> starts;
+	std::vector<Term> terms;
+	std::vector<SubsetLoop> subsetLoops;
+	std::vector<MP_domain> domains;
+    };
+
     /** @brief The base class for all expressions.
         @ingroup INTERNAL_USE
         @note FOR INTERNAL USE: This is not normally used directly by the
         calling code.
     */
-    class MP_expression_base {
+    class MP_expression_base : public ArenaNode {
 	friend class MP_expression;
 	friend class Handle<MP_expression_base*>;
     private:
@@ -100,10 +244,20 @@ namespace flopc {
 
 	virtual double level() const = 0;
 	virtual void generate(const MP_domain& domain,
-			      std::vector<Constant> multiplicators,
+			      const std::vector<Constant>& multiplicators,
 			      GenerateFunctor& f,
 			      double m) const = 0;
 	virtual void insertVariables(std::set<MP_variable*>& v) const = 0;
+	/** Lowers the expression into p.  domains and multiplicators are
+	    those of the sums and products the expression is nested in, in
+	    the order they were entered.  By default the expression is kept
+	    as it is, to be generated by generate().
+	*/
+	virtual void compile(std::vector<MP_domain>& domains,
+			     std::vector<Constant>& multiplicators,
+			     double m, GenerationProgram& p) const {
+	    p.addExpression(this, domains, multiplicators, m);
+	}
 
 	virtual ~MP_expression_base() {}
     };
@@ -146,6 +300,16 @@ namespace flopc {
 	virtual double getValue() const = 0; 
 	virtual int getColumn() const = 0;
 	virtual int getStage() const = 0;
+	/// getValue() factorized as by Constant_base::factorize()
+	virtual bool factorize(double& factor,
+			       std::vector<DataEntry>& entries) const {
+	    return false;
+	}
+	void compile(std::vector<MP_domain>& domains,
+		     std::vector<Constant>& multiplicators,
+		     double m, GenerationProgram& p) const {
+	    p.addTerm(this, domains, multiplicators, m);
+	}
     };
 
     /** @brief The base class for all expressions.
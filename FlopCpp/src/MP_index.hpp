@@ -23,7 +23,7 @@ namespace flopc {
         @note FOR INTERNAL USE: This is not normally used directly by the
         calling code.
     */
-    class MP_index_base {
+    class MP_index_base : public ArenaNode {
 	friend class Handle<MP_index_base*>;
 	friend class MP_index_exp;
     public:
@@ -54,33 +54,36 @@ namespace flopc {
     public:
         /// Default constructor. 
 	MP_index() : index(0), instantiated(false) {}
+	/// indices and sets are declared by the user, never in an Arena.
+	static void* operator new(size_t size) { return ::operator new(size); }
+	static void operator delete(void* p) { ::operator delete(p); }
 	int evaluate() const { 
-	    return index; 
+	    return index(); 
 	}
     /** interrogate state of instatiation of data.
         @todo should this be private?
     */
 	bool isInstantiated() const { 
-	    return instantiated; 
+	    return instantiated(); 
 	}
     /** Setter for the index.
         @todo should this be private?
         @todo should this assert "instatiated"?
     */
 	void assign(int i) { 
-	    index = i;
+	    index() = i;
 	}
     /** unsetter for instatiated.
         @todo should this be private?
     */
 	void unInstantiate() {
-	    instantiated = false; 
+	    instantiated() = false; 
 	}
     /** setter for instatiated.
         @todo should this be private?
     */
 	void instantiate() {
-	    instantiated = true; 
+	    instantiated() = true; 
 	}
     /** getter for MP_index * data type.  
         @todo should this be private?
@@ -100,8 +103,8 @@ namespace flopc {
 
     private:
 	static MP_index& Empty;
-	int index;
-	bool instantiated;
+	PerThread<int> index;
+	PerThread<bool> instantiated;
     };
 
 
@@ -9,23 +9,38 @@
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <map>
 
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <ctime>
+
+#include <CoinError.hpp>
 #include <CoinPackedMatrix.hpp>
+#include <CoinFileIO.hpp>
+#include <CoinWarmStartBasis.hpp>
 #include <OsiSolverInterface.hpp>
 #include "MP_model.hpp"
 #include "MP_variable.hpp"
 #include "MP_constraint.hpp"
+#include "MP_writer.hpp"
 #include <CoinTime.hpp>
+#ifdef FLOPCPP_THREAD
+#include <pthread.h>
+#endif
 
 using namespace flopc;
 using namespace std;
 
 MP_model& MP_model::default_model = *new MP_model(0);
-MP_model* MP_model::current_model = &MP_model::default_model;
+FLOPCPP_THREAD_LOCAL MP_model* MP_model::current_model = 0;
 MP_model &MP_model::getDefaultModel() { return default_model;}
-MP_model *MP_model::getCurrentModel() { return current_model;}
+MP_model *MP_model::getCurrentModel() {
+    return current_model!=0 ? current_model : &default_model;
+}
 
-void NormalMessenger::statistics(int bm, int m, int bn, int n, int nz) {
+void NormalMessenger::statistics(int bm, int m, int bn, int n, CoinBigIndex nz) {
     cout<<"FlopCpp: Number of constraint blocks: " <<bm<<endl;
     cout<<"FlopCpp: Number of individual constraints: " <<m<<endl;
     cout<<"FlopCpp: Number of variable blocks: " <<bn<<endl;
@@ -37,13 +52,106 @@ void NormalMessenger::generationTime(double t) {
     cout<<"FlopCpp: Generation time: "<<t<<endl;
 }
 
+void VerboseMessenger::generationProfile(const GenerationProfile& profile) {
+    cout<<"FlopCpp: Generation profile ("<<profile.kind<<")"<<endl;
+    for (size_t b=0; b<profile.blocks.size(); b++) {
+	const BlockProfile& block = profile.blocks[b];
+	cout<<"FlopCpp: Block "<<block.name<<"  rows "<<block.rows
+	    <<"  iterations "<<block.iterations<<"  coefficients "
+	    <<block.coefficients<<"  wall "<<block.wallTime<<"  cpu "
+	    <<block.cpuTime<<endl;
+    }
+    cout<<"FlopCpp: generate "<<profile.generateTime<<"  assemble "
+	<<profile.assembleTime<<"  load "<<profile.loadTime<<endl;
+}
+
+namespace {
+    void writeJsonString(ostream& os, const string& s) {
+	os<<'"';
+	for (size_t i=0; i<s.size(); i++) {
+	    const unsigned char c = s[i];
+	    if (c=='"' || c=='\\') {
+		os<<'\\'<<c;
+	    } else if (c<0x20) {
+		char escape[8];
+		sprintf(escape,"\\u%04x",c);
+		os<<escape;
+	    } else {
+		os<<c;
+	    }
+	}
+	os<<'"';
+    }
+
+    void writeBlock(ostream& os, const BlockProfile& block) {
+	os<<"{\"name\": ";
+	writeJsonString(os,block.name);
+	os<<", \"rows\": "<<block.rows
+	  <<", \"iterations\": "<<block.iterations
+	  <<", \"coefficients\": "<<block.coefficients
+	  <<", \"wallTime\": "<<block.wallTime
+	  <<", \"cpuTime\": "<<block.cpuTime<<"}";
+    }
+
+    // CPU time of the calling thread, where it can be told apart from
+    // that of the process
+    double threadCpuTime() {
+#if defined(FLOPCPP_THREAD) && defined(CLOCK_THREAD_CPUTIME_ID)
+	timespec t;
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID,&t)==0) {
+	    return t.tv_sec+1.0e-9*t.tv_nsec;
+	}
+#endif
+	return CoinCpuTime();
+    }
+
+    void startBlock(BlockProfile& block, const string& name, int rows) {
+	block.name = name;
+	block.rows = rows;
+	block.wallTime = -CoinGetTimeOfDay();
+	block.cpuTime = -threadCpuTime();
+    }
+
+    void stopBlock(BlockProfile& block, const GenerateFunctor& f,
+		   size_t coefficients) {
+	block.wallTime += CoinGetTimeOfDay();
+	block.cpuTime += threadCpuTime();
+	block.iterations = f.getIterations();
+	block.coefficients = coefficients;
+    }
+}
+
+void GenerationProfile::writeJson(ostream& os) const {
+    os<<"{\"kind\": ";
+    writeJsonString(os,kind);
+    os<<", \"rows\": "<<m<<", \"columns\": "<<n<<", \"nonzeros\": "<<nz
+      <<",\n \"generateTime\": "<<generateTime
+      <<", \"assembleTime\": "<<assembleTime
+      <<", \"loadTime\": "<<loadTime
+      <<", \"wallTime\": "<<wallTime
+      <<", \"cpuTime\": "<<cpuTime
+      <<",\n \"objective\": ";
+    writeBlock(os,objective);
+    os<<",\n \"blocks\": [";
+    for (size_t b=0; b<blocks.size(); b++) {
+	os<<(b==0 ? "\n  " : ",\n  ");
+	writeBlock(os,blocks[b]);
+    }
+    os<<"]}"<<endl;
+}
+
 void VerboseMessenger::constraintDebug(string name, const vector<Coef>& cfs) {
+    constraintDebug(name,cfs,vector<int>());
+}
+
+void VerboseMessenger::constraintDebug(string name, const vector<Coef>& cfs,
+                                       const vector<int>& stages) {
     cout<<"FlopCpp: Constraint "<<name<<endl;
     for (unsigned int j=0; j<cfs.size(); j++) {
 	int col=cfs[j].col;
 	int row=cfs[j].row;
 	double elm=cfs[j].val;
-	int stage=cfs[j].stage;
+	int stage=stages.empty() ? 0 : stages[j];
 	cout<<row<<"   "<<col<<"  "<<elm<<"  "<<stage<<endl;
     }
 }
@@ -58,15 +166,123 @@ void VerboseMessenger::objectiveDebug(const vector<Coef>& cfs) {
     }
 }
 
+/** The template of a model captured by MP_model::useTemplate().  The
+    matrix coefficients (in the pattern attach() passes to the solver),
+    then the right hand sides of the rows (as generated, so the negated
+    bounds) and the objective coefficients are the sum of base and of
+    the products of factors and data values.
+*/
+class flopc::GenerationTemplate {
+public:
+    GenerationTemplate() : stamp(0), start(1,0) {}
+    /// Computes the values as described above.
+    void evaluate(vector<double>& values) const {
+	values = base;
+	for (size_t k=0; k<target1.size(); k++) {
+	    values[target1[k]] += factor1[k]*entry1[k].value();
+	}
+	for (size_t k=0; k<targetN.size(); k++) {
+	    double value = factorN[k];
+	    for (int e=firstN[k]; e<firstN[k+1]; e++) {
+		value *= entryN[e].value();
+	    }
+	    values[targetN[k]] += value;
+	}
+    }
+    unsigned long stamp;
+    /// column starts and row indices of the matrix
+    vector<CoinBigIndex> start;
+    vector<int> index;
+    /// the matrix coefficients last passed to the solver
+    vector<double> elements;
+    vector<double> base;
+    /// the terms with a single data value
+    vector<int> target1;
+    vector<double> factor1;
+    vector<DataEntry> entry1;
+    /// the terms with several data values
+    vector<int> targetN;
+    vector<double> factorN;
+    vector<int> firstN;
+    vector<DataEntry> entryN;
+    /// data read other than as a factor of some term
+    vector<const MP_data*> structure;
+    /// subsets read, which decide what the terms are
+    vector<const MP_subset_base*> subsets;
+};
+
 MP_model::MP_model(OsiSolverInterface* s, Messenger* m) : 
-    solution(0), messenger(m), Objective(0), Solver(s), 
+    solution(0), messenger(m), arena(0), Objective(0), objectiveStamp(0),
+    attachedSolver(0), attachStamp(0), generationTemplate(0),
+    mResolve(false), numberThreads(1), staged(false), direction(MINIMIZE),
+    Solver(s),
     m(0), n(0), nz(0), bl(0),
     mSolverState(((s==NULL)?(MP_model::DETACHED):(MP_model::SOLVER_ONLY))) {
     MP_model::current_model = this;
+    Arena::setCurrent(0);
+}
+
+MP_model::~MP_model() {
+    if (current_model == this) {
+	current_model = 0;
+    }
+    delete messenger;
+    delete generationTemplate;
+    if (arena != 0) {
+	// the objective is usually one of the nodes
+	Objective = MP_expression();
+	delete arena;
+    }
+}
+
+void MP_model::useArena() {
+    if (arena == 0) {
+	arena = new Arena;
+    }
+    if (current_model == this) {
+	Arena::setCurrent(arena);
+    }
+}
+
+MP_context::MP_context() : previousModel(0), previousArena(0) {
+    bind();
+}
+
+MP_context::MP_context(MP_model& m) : previousModel(0), previousArena(0) {
+    bind();
+    MP_model::current_model = &m;
+    Arena::setCurrent(m.arena);
+}
+
+void MP_context::bind() {
+    previousSlot = threadSlot();
+    previousModel = MP_model::current_model;
+    previousArena = Arena::current();
+    slot = acquireThreadSlot();
+    if (slot<0) {
+	throw CoinError("all thread slots are taken","MP_context","MP_context");
+    }
+    setThreadSlot(slot);
+}
+
+MP_context::~MP_context() {
+    MP_model::current_model = previousModel;
+    Arena::setCurrent(previousArena);
+    setThreadSlot(previousSlot);
+    releaseThreadSlot(slot);
 }
 
 MP_model& MP_model::add(MP_constraint& lcl_c) {
     Constraints.insert(&lcl_c);
+    // The stage sets may have been declared before the model
+    const MP_set_base* sets[maxDimension] =
+	{&lcl_c.S1, &lcl_c.S2, &lcl_c.S3, &lcl_c.S4, &lcl_c.S5, &lcl_c.S6,
+	 &lcl_c.S7};
+    for (int k=0; k<maxDimension; k++) {
+	if (sets[k]->isStage()) {
+	    staged = true;
+	}
+    }
     return *this;
 }
 
@@ -87,51 +303,243 @@ double MP_model::getInfinity() const {
 void MP_model::add(MP_variable* v) {
     v->M = this;
     v->offset = n;
+    v->added.clear();
     n += v->size();
 }
 
+namespace {
+    // Orders coefficients by column, then row
+    bool columnOrder(const Coef& a, const Coef& b) {
+	return a.col < b.col || (a.col == b.col && a.row < b.row);
+    }
+}
+
+namespace flopc {
+    bool rowOrder(const Coef& a, const Coef& b) {
+	return a.row < b.row || (a.row == b.row && a.col < b.col);
+    }
+
+    void merge(vector<Coef>& coefs) {
+	size_t k = 0;
+	for (size_t i=0; i<coefs.size(); i++) {
+	    if (k>0 && coefs[k-1].col==coefs[i].col && 
+		coefs[k-1].row==coefs[i].row) {
+		coefs[k-1].val += coefs[i].val;
+	    } else {
+		coefs[k++] = coefs[i];
+	    }
+	}
+	coefs.erase(coefs.begin()+k,coefs.end());
+    }
+
+}
+
 void MP_model::addRow(const Constraint& lcl_c) {
-    vector<Coef> cfs;
+    addRows(vector<Constraint>(1,lcl_c));
+}
+
+void MP_model::addRows(const vector<Constraint>& cuts) {
+    // temporaries of the generation stay out of the arena, see generate()
+    Arena::Scope scope(0);
+    vector<Coef> coefs;
+    vector<Sense_enum> senses;
     vector<Constant> v;
-    ObjectiveGenerateFunctor f(cfs);
-    lcl_c.left->generate(MP_domain::getEmpty(),v,f,1.0);
-    lcl_c.right->generate(MP_domain::getEmpty(),v,f,-1.0);
-    CoinPackedVector newRow;
-    double rhs = 0.0;
-    for (unsigned int j=0; j<cfs.size(); j++) {
-	int col=cfs[j].col;
-	//int row=cfs[j].row;
-	double elm=cfs[j].val;
-	//cout<<row<<"   "<<col<<"  "<<elm<<endl;
-	if (col>=0) {
-	    newRow.insert(col,elm);
-	} else if (col==-1) {
-	    rhs = elm;
+    for (size_t k=0; k<cuts.size(); k++) {
+	vector<Coef> cfs;
+	ObjectiveGenerateFunctor f(cfs);
+	cuts[k].left->generate(MP_domain::getEmpty(),v,f,1.0);
+	cuts[k].right->generate(MP_domain::getEmpty(),v,f,-1.0);
+	for (size_t j=0; j<cfs.size(); j++) {
+	    coefs.push_back(Coef(cfs[j].col,static_cast<int>(k),cfs[j].val));
+	}
+	senses.push_back(cuts[k].sense);
+    }
+    addRows(coefs,senses);
+}
+
+void MP_model::addRows(MP_constraint& cuts) {
+    assert(Solver);
+    // The constraint was put in the current model when it was declared.
+    // It becomes a block of this model, after the rows in the solver, so
+    // an attach() which regenerates the model reproduces its rows.
+    if (cuts.M!=0) {
+	cuts.M->Constraints.erase(&cuts);
+    }
+    const bool same = Solver==attachedSolver && sameLayout();
+    Constraints.insert(&cuts);
+    cuts.M = this;
+    cuts.offset = Solver->getNumRows();
+    vector<MP_constraint*> blocks(1,&cuts);
+    vector<vector<Coef> > buffers;
+    vector<size_t> firstBuffer;
+    generate(blocks,buffers,firstBuffer,0);
+    vector<Coef> coefs;
+    for (size_t b=0; b<buffers.size(); b++) {
+	for (size_t k=0; k<buffers[b].size(); k++) {
+	    Coef cf = buffers[b][k];
+	    cf.row -= cuts.offset;
+	    coefs.push_back(cf);
+	}
+	vector<Coef>().swap(buffers[b]);
+    }
+    addRows(coefs,vector<Sense_enum>(cuts.size(),cuts.sense));
+    // The block extends the layout attached, so the next attach() can
+    // still update the solver.
+    if (same==true) {
+	m += cuts.size();
+	constraintLayout.clear();
+	for (conIt i=Constraints.begin(); i!=Constraints.end(); i++) {
+	    constraintLayout.push_back(make_pair((*i)->offset,(*i)->size()));
+	}
+    }
+}
+
+void MP_model::addRows(vector<Coef>& coefs, const vector<Sense_enum>& senses) {
+    assert(Solver);
+    const int rows = static_cast<int>(senses.size());
+    if (rows==0) {
+	return;
+    }
+    // Assemble the rows, summing up coefficients of the same column and
+    // the constants, which make up the right hand side.
+    std::sort(coefs.begin(),coefs.end(),rowOrder);
+    merge(coefs);
+    vector<CoinBigIndex> starts(1,0);
+    vector<int> columns;
+    vector<double> elements;
+    vector<double> lower(rows);
+    vector<double> upper(rows);
+    const double inf = Solver->getInfinity();
+    size_t k = 0;
+    for (int r=0; r<rows; r++) {
+	double rhs = 0.0;
+	for (; k<coefs.size() && coefs[k].row==r; k++) {
+	    if (coefs[k].col>=0) {
+		if (coefs[k].val!=0.0) {
+		    columns.push_back(coefs[k].col);
+		    elements.push_back(coefs[k].val);
+		}
+	    } else {
+		rhs -= coefs[k].val;
+	    }
+	}
+	starts.push_back(static_cast<CoinBigIndex>(columns.size()));
+	lower[r] = senses[r]==LE ? -inf : rhs;
+	upper[r] = senses[r]==GE ? inf : rhs;
+    }
+    columns.push_back(0);
+    elements.push_back(0.0);
+
+    // New rows enter the basis as slacks, the rest of it is kept
+    CoinWarmStart* basis = Solver->getWarmStart();
+    Solver->addRows(rows,&starts[0],&columns[0],&elements[0],
+		    &lower[0],&upper[0]);
+    CoinWarmStartBasis* rowBasis = dynamic_cast<CoinWarmStartBasis*>(basis);
+    if (rowBasis!=0) {
+	rowBasis->resize(Solver->getNumRows(),Solver->getNumCols());
+	Solver->setWarmStart(rowBasis);
+    }
+    delete basis;
+    mResolve = true;
+}
+
+int MP_model::addColumns(MP_variable& v, const vector<MP_column>& columns) {
+    assert(Solver);
+    assert(v.rank==1);
+    const int first = Solver->getNumCols();
+    const int count = static_cast<int>(columns.size());
+    vector<CoinBigIndex> starts(1,0);
+    vector<int> rows;
+    vector<double> elements;
+    vector<double> objective(count);
+    vector<double> lower(count);
+    vector<double> upper(count);
+    vector<pair<int,double> > column;
+    int outside = 0;
+    for (int j=0; j<count; j++) {
+	// Sum up coefficients of the same row
+	column.clear();
+	const vector<MP_column::Entry>& entries = columns[j].entries;
+	for (size_t k=0; k<entries.size(); k++) {
+	    const MP_constraint* c = entries[k].constraint;
+	    // Index values are checked against the sets, as in generation
+	    const MP_set_base* S[maxDimension] =
+		{&c->S1, &c->S2, &c->S3, &c->S4, &c->S5, &c->S6, &c->S7};
+	    int element[maxDimension];
+	    bool inside = true;
+	    for (int s=0; s<maxDimension; s++) {
+		element[s] = S[s]->check(entries[k].element[s]);
+		if (element[s]==outOfBound) {
+		    inside = false;
+		}
+	    }
+	    if (inside==false) {
+		outside++;
+		continue;
+	    }
+	    const int position = c->f(element);
+	    if (c->offset>=0 && entries[k].value!=0.0) {
+		column.push_back(make_pair(c->offset+position,
+					   entries[k].value));
+	    }
+	}
+	std::sort(column.begin(),column.end());
+	for (size_t k=0; k<column.size(); k++) {
+	    if (rows.size()>static_cast<size_t>(starts.back()) &&
+		rows.back()==column[k].first) {
+		elements.back() += column[k].second;
+	    } else {
+		rows.push_back(column[k].first);
+		elements.push_back(column[k].second);
+	    }
 	}
+	starts.push_back(static_cast<CoinBigIndex>(rows.size()));
+	objective[j] = columns[j].objective;
+	lower[j] = columns[j].lower;
+	upper[j] = columns[j].upper;
     }
-    // NB no "assembly" of added row yet. Will be done....
- 
-    double lcl_bl = -rhs;
-    double lcl_bu = -rhs;
+    if (outside>0) {
+	ostringstream os;
+	os<<"FlopCpp: "<<outside<<" column coefficients outside of their "
+	  <<"constraints dropped";
+	messenger->logMessage(0,os.str().c_str());
+    }
+    rows.push_back(0);
+    elements.push_back(0.0);
 
-    double inf = Solver->getInfinity();
-    switch (lcl_c.sense) {
-	case LE:
-	    lcl_bl = - inf;
-	    break;
-	case GE:
-	    lcl_bu = inf;
-	    break;
-	case EQ:
-	    // Nothing to do
-	    break;		
+    // New columns are nonbasic at their lower bound, the rest of the
+    // basis is kept
+    CoinWarmStart* basis = Solver->getWarmStart();
+    Solver->addCols(count,&starts[0],&rows[0],&elements[0],
+		    &lower[0],&upper[0],&objective[0]);
+    CoinWarmStartBasis* columnBasis = dynamic_cast<CoinWarmStartBasis*>(basis);
+    if (columnBasis!=0) {
+	columnBasis->resize(Solver->getNumRows(),Solver->getNumCols());
+	Solver->setWarmStart(columnBasis);
+    }
+    delete basis;
+    if (v.type == discrete) {
+	for (int j=first; j<first+count; j++) {
+	    Solver->setInteger(j);
+	}
     }
 
-    Solver->addRow(newRow,lcl_bl,lcl_bu);
+    v.M = this;
+    const int index = v.size()+static_cast<int>(v.added.size());
+    for (int j=first; j<first+count; j++) {
+	v.added.push_back(j);
+    }
+    mResolve = true;
+    return index;
+}
+
+int MP_model::addColumn(MP_variable& v, const MP_column& column) {
+    return addColumns(v,vector<MP_column>(1,column));
 }
 
 void MP_model::setObjective(const MP_expression& o) { 
     Objective = o; 
+    objectiveStamp = Stamped::tick();
 }
 
 void MP_model::minimize_max(MP_set &s, const MP_expression  &obj) {
@@ -143,39 +551,251 @@ void MP_model::minimize_max(MP_set &s, const MP_expression  &obj) {
 } 
 
 
-class flopc::CoefLess {
+/** A piece of work for the generation threads: a constraint block, or the
+    rows of a block whose first index lies in [first,last).
+*/
+class flopc::GenerationTask {
 public:
-    bool operator() (const Coef& a, const Coef& b) const {
-	if (a.col < b.col) {
-	    return true;
-	} else if (a.col == b.col && a.row < b.row) {
-	    return true;
-	} else {
-	    return false;
-	}
-    }
+    GenerationTask(MP_constraint* c, bool s, MP_index* i = 0, int f = 0,
+                   int l = 0) :
+        constraint(c), staged(s), index(i), first(f), last(l) {}
+    MP_constraint* constraint;
+    bool staged;
+    MP_index* index;
+    int first;
+    int last;
+    vector<Coef> coefs;
+    vector<int> stages;
+    vector<const MP_data*> dataUsed;
+    vector<const MP_subset_base*> subsetsUsed;
+    BlockProfile profile;
 };
 
-void MP_model::assemble(vector<Coef>& v, vector<Coef>& av) {
-    std::sort(v.begin(),v.end(),CoefLess());
-    int c,r,s;
-    double val;
-    std::vector<Coef>::const_iterator i = v.begin();
-    while (i!=v.end()) {
-	c = i->col;
-	r = i->row;
-	val = i->val;
-	s = i->stage;
-	i++;
-	while (i!=v.end() && c==i->col && r==i->row) {
-	    val += i->val;
-	    if (i->stage>s) {
-		s = i->stage;
-	    }
-	    i++;
-	}
-	av.push_back(Coef(c,r,val,s));
+namespace {
+    struct GenerationQueue {
+        vector<GenerationTask*>* tasks;
+        int next;
+    };
+    struct GenerationThread {
+        GenerationQueue* queue;
+        int slot;
+        int* counts;
+    };
+}
+
+void MP_model::setNumberThreads(int number) {
+#ifdef FLOPCPP_THREAD
+    numberThreads = std::max(1,std::min(number,FLOPCPP_MAX_THREADS));
+#endif
+}
+
+void MP_model::generate(GenerationTask& task, int* counts) {
+    GenerateFunctor f(task.coefs);
+    f.setColumnCounts(counts);
+    if (task.staged) {
+        f.setStages(&task.stages);
+    }
+    startBlock(task.profile,"",0);
+    MP_data::startRecording(task.dataUsed);
+    MP_subset_base::startRecording(task.subsetsUsed);
+    if (task.index==0) {
+        task.constraint->coefficients(f);
+    } else {
+        // With its first index bound the block's domain does not loop
+        // over it, so this generates the rows of one index value at a time.
+        task.index->instantiate();
+        for (int k=task.first; k<task.last; k++) {
+            task.index->assign(k);
+            task.constraint->coefficients(f);
+        }
+        task.index->assign(0);
+        task.index->unInstantiate();
     }
+    MP_data::stopRecording();
+    MP_subset_base::stopRecording();
+    stopBlock(task.profile,f,task.coefs.size());
+}
+
+void* MP_model::generationThread(void* info) {
+#ifdef FLOPCPP_THREAD
+    GenerationThread* thread = static_cast<GenerationThread*>(info);
+    GenerationQueue* queue = thread->queue;
+    setThreadSlot(thread->slot);
+    MP_domain_base::threadLocalLinks() = true;
+    const int number = static_cast<int>(queue->tasks->size());
+    for (;;) {
+        const int i = __sync_fetch_and_add(&queue->next,1);
+        if (i>=number) {
+            break;
+        }
+        generate(*(*queue->tasks)[i],thread->counts);
+    }
+    MP_domain_base::threadLocalLinks() = false;
+#endif
+    return 0;
+}
+
+void MP_model::generate(const vector<MP_constraint*>& blocks,
+                        vector<vector<Coef> >& coefs,
+                        vector<size_t>& firstBuffer, int* counts,
+                        vector<BlockProfile>* profiles) {
+    // Nodes built while generating are temporaries (or kept by the
+    // compiled constraints), so they go to the free store and are freed
+    // with their handles instead of piling up in the arena.  Worker
+    // threads start out with the free store.
+    Arena::Scope scope(0);
+    coefs.clear();
+    firstBuffer.assign(1,0);
+    if (profiles!=0) {
+        profiles->resize(blocks.size());
+    }
+    if (numberThreads<=1) {
+        coefs.resize(blocks.size());
+        vector<int> stages;
+        for (size_t b=0; b<blocks.size(); b++) {
+            BlockProfile block;
+            startBlock(block,blocks[b]->getName(),blocks[b]->size());
+            GenerateFunctor f(coefs[b]);
+            f.setColumnCounts(counts);
+            if (staged) {
+                stages.clear();
+                f.setStages(&stages);
+            }
+            blocks[b]->dataUsed.clear();
+            blocks[b]->subsetsUsed.clear();
+            MP_data::startRecording(blocks[b]->dataUsed);
+            MP_subset_base::startRecording(blocks[b]->subsetsUsed);
+            blocks[b]->coefficients(f);
+            MP_data::stopRecording();
+            MP_subset_base::stopRecording();
+            stopBlock(block,f,coefs[b].size());
+            if (profiles!=0) {
+                (*profiles)[b] = block;
+            }
+            if (staged) {
+                messenger->constraintDebug(blocks[b]->getName(),coefs[b],stages);
+            } else {
+                messenger->constraintDebug(blocks[b]->getName(),coefs[b]);
+            }
+            firstBuffer.push_back(b+1);
+        }
+        return;
+    }
+#ifdef FLOPCPP_THREAD
+    // Blocks which are large compared to the work per thread are split
+    // on their first index, provided it is a plain index.  As the rows of
+    // a slice follow those of the previous slice, appending the slices
+    // gives the same columns as generating the block at once.
+    int rows = 0;
+    for (size_t b=0; b<blocks.size(); b++) {
+        rows += blocks[b]->size();
+    }
+    vector<GenerationTask*> tasks;
+    for (size_t b=0; b<blocks.size(); b++) {
+        MP_constraint* cst = blocks[b];
+        MP_index* index = 0;
+        // The threads only run the compiled constraints
+        if (cst->I1.operator->()!=0) {
+            cst->compile();
+        }
+        int slices = 1;
+        if (cst->I1.operator->()!=0) {
+            index = cst->I1->getIndex();
+        }
+        if (index!=0 && index==cst->I1.operator->() && rows>0) {
+            const double share = 4.0*numberThreads*cst->size()/rows;
+            slices = std::min(cst->S1.size(),static_cast<int>(share));
+        }
+        if (slices<=1) {
+            tasks.push_back(new GenerationTask(cst,staged));
+        } else {
+            const int size = cst->S1.size();
+            for (int k=0; k<slices; k++) {
+                tasks.push_back(new GenerationTask(cst,staged,index,
+                                                   (k*size)/slices,
+                                                   ((k+1)*size)/slices));
+            }
+        }
+        firstBuffer.push_back(tasks.size());
+    }
+
+    // Make sure shared statics exist before the threads look at them
+    MP_domain::getEmpty();
+
+    // Each thread counts columns into its own array, the caller's
+    // array is used by the calling thread.
+    const int numberCounts = counts==0 ? 0 : n+2;
+    vector<int> threadCounts((numberThreads-1)*numberCounts,0);
+    GenerationQueue queue;
+    queue.tasks = &tasks;
+    queue.next = 0;
+    vector<GenerationThread> info(numberThreads);
+    vector<pthread_t> threads(numberThreads);
+    vector<bool> started(numberThreads,false);
+    for (int t=0; t<numberThreads; t++) {
+        info[t].queue = &queue;
+        info[t].slot = t==0 ? threadSlot() : acquireThreadSlot();
+        info[t].counts = counts;
+        if (t>0 && counts!=0) {
+            info[t].counts = &threadCounts[(t-1)*numberCounts];
+        }
+    }
+    for (int t=1; t<numberThreads; t++) {
+        // The calling thread works through the queue as well, so tasks
+        // still get done if a thread cannot be started, or other models
+        // generating at the same time hold all the slots.
+        started[t] = info[t].slot>=0 &&
+            pthread_create(&threads[t],NULL,generationThread,&info[t])==0;
+    }
+    generationThread(&info[0]);
+    for (int t=1; t<numberThreads; t++) {
+        if (started[t]==true) {
+            pthread_join(threads[t],NULL);
+        }
+        releaseThreadSlot(info[t].slot);
+    }
+    for (size_t k=0; k<threadCounts.size(); k++) {
+        counts[k%numberCounts] += threadCounts[k];
+    }
+
+    coefs.resize(tasks.size());
+    for (size_t b=0; b<blocks.size(); b++) {
+        vector<const MP_data*>& used = blocks[b]->dataUsed;
+        vector<const MP_subset_base*>& subsets = blocks[b]->subsetsUsed;
+        used.clear();
+        subsets.clear();
+        BlockProfile block;
+        block.name = blocks[b]->getName();
+        block.rows = blocks[b]->size();
+        for (size_t t=firstBuffer[b]; t<firstBuffer[b+1]; t++) {
+            const BlockProfile& slice = tasks[t]->profile;
+            block.iterations += slice.iterations;
+            block.coefficients += slice.coefficients;
+            block.wallTime += slice.wallTime;
+            block.cpuTime += slice.cpuTime;
+            coefs[t].swap(tasks[t]->coefs);
+            used.insert(used.end(),tasks[t]->dataUsed.begin(),
+                        tasks[t]->dataUsed.end());
+            subsets.insert(subsets.end(),tasks[t]->subsetsUsed.begin(),
+                           tasks[t]->subsetsUsed.end());
+            if (staged) {
+                messenger->constraintDebug(blocks[b]->getName(),coefs[t],
+                                           tasks[t]->stages);
+            } else {
+                messenger->constraintDebug(blocks[b]->getName(),coefs[t]);
+            }
+            delete tasks[t];
+        }
+        std::sort(used.begin(),used.end());
+        used.erase(std::unique(used.begin(),used.end()),used.end());
+        std::sort(subsets.begin(),subsets.end());
+        subsets.erase(std::unique(subsets.begin(),subsets.end()),
+                      subsets.end());
+        if (profiles!=0) {
+            (*profiles)[b] = block;
+        }
+    }
+#endif
 }
 
 void MP_model::maximize() {
@@ -189,7 +809,7 @@ void MP_model::maximize() {
 
 void MP_model::maximize(const MP_expression &obj) {
     if (Solver!=0) {
-	Objective = obj;
+	setObjective(obj);
 	attach(Solver);
         solve(MP_model::MAXIMIZE);
     } else {
@@ -208,7 +828,7 @@ void MP_model::minimize() {
 
 void MP_model::minimize(const MP_expression &obj) {
     if (Solver!=0) {
-	Objective = obj;
+	setObjective(obj);
 	attach(Solver);
         solve(MP_model::MINIMIZE);
     } else {
@@ -228,47 +848,32 @@ void MP_model::attach(OsiSolverInterface *_solver) {
         }
         Solver=_solver;
     }
-    double time = CoinCpuTime();
-    m=0;
-    n=0;
-    vector<Coef> coefs;
-    vector<Coef> cfs;
-
-    typedef std::set<MP_variable* >::iterator varIt;
-    typedef std::set<MP_constraint* >::iterator conIt;
-    
-    Objective->insertVariables(Variables);
-    for (conIt i=Constraints.begin(); i!=Constraints.end(); i++) {
-	add(*i);
-	(*i)->insertVariables(Variables);
-    }
-    for (varIt j=Variables.begin(); j!=Variables.end(); j++) {
-	add(*j);
-    }
-
-    // Generate coefficient matrix and right hand side
-    bool doAssemble = true;
-    if (doAssemble == true) {
-	GenerateFunctor f(cfs);
-	for (conIt i=Constraints.begin(); i!=Constraints.end(); i++) {
-	    (*i)->coefficients(f);
-	    messenger->constraintDebug((*i)->getName(),cfs);
-	    assemble(cfs,coefs);
-	    cfs.erase(cfs.begin(),cfs.end());
-	}
-    } else {
-	GenerateFunctor f(coefs);
-	for (conIt i=Constraints.begin(); i!=Constraints.end(); i++) {
-	    (*i)->coefficients(f);
-	}
+    if (Solver==attachedSolver) {
+        if (generationTemplate!=0 ? rebind() : update()) {
+            return;
+        }
     }
-    nz = static_cast<int>(coefs.size());
+    // The data recorded while capturing a template leave out the factors
+    // of the coefficients, so dropping it means regenerating everything.
+    delete generationTemplate;
+    generationTemplate = 0;
+    double time = CoinCpuTime();
+    double wall = CoinGetTimeOfDay();
+    profile = GenerationProfile();
+    profile.kind = "attach";
+    layout();
 
-    messenger->statistics(static_cast<int>(Constraints.size()),m,static_cast<int>(Variables.size()),n,nz);
+    // Generate coefficient matrix and right hand side, counting the
+    // coefficients of each column (counts[0] is the right hand side)
+    vector<MP_constraint*> blocks(Constraints.begin(),Constraints.end());
+    vector<vector<Coef> > coefs;
+    vector<size_t> firstBuffer;
+    vector<int> counts(n+2,0);
+    double step = CoinGetTimeOfDay();
+    generate(blocks,coefs,firstBuffer,&counts[0],&profile.blocks);
+    profile.generateTime = CoinGetTimeOfDay()-step;
 
-    Elm = new double[nz]; 
-    Rnr = new int[nz];    
-    Cst = new int[n+2];   
+    Cst = new CoinBigIndex[n+2];   
     Clg = new int[n+1];   
     l =   new double[n];  
     u =   new double[n];  
@@ -277,47 +882,81 @@ void MP_model::attach(OsiSolverInterface *_solver) {
 
     const double inf = Solver->getInfinity();
 
+    // Treat right hand side as n'th column, and put the coefficients into
+    // their columns in the order they were generated.
+    Cst[0] = 0;
     for (int j=0; j<n; j++) {
-	Clg[j] = 0;
+	Cst[j+1] = Cst[j]+counts[j+1];
     }
-    Clg[n] = 0;
-    
-    // Treat right hand side as n'th column
+    Cst[n+1] = Cst[n]+counts[0];
+    const CoinBigIndex size = Cst[n+1];
+    Elm = new double[size]; 
+    Rnr = new int[size];    
     for (int j=0; j<=n; j++) {
 	Clg[j] = 0;
     }
-    for (int i=0; i<nz; i++) {
-	int col = coefs[i].col;
-	if (col == -1)  {
-	    col = n;
+    for (size_t b=0; b<coefs.size(); b++) {
+	for (size_t i=0; i<coefs[b].size(); i++) {
+	    int col = coefs[b][i].col;
+	    if (col==-1) {
+		col = n;
+	    }
+	    const CoinBigIndex k = Cst[col]+Clg[col];
+	    Elm[k] = coefs[b][i].val;
+	    Rnr[k] = coefs[b][i].row;
+	    Clg[col]++;
 	}
-	Clg[col]++;
+	vector<Coef>().swap(coefs[b]);
     }
-    Cst[0]=0;
+    coefs.clear();
+
+    // Sum up duplicate coefficients with a scatter over the rows: where[r]
+    // is the position of row r if it lies in the current column.  The
+    // columns are compacted on the way, and sorted by row where needed.
+    vector<CoinBigIndex> where(m,-1);
+    nz = 0;
     for (int j=0; j<=n; j++) {
-	Cst[j+1]=Cst[j]+Clg[j]; 
-    }
-    for (int i=0; i<=n; i++) {
-	Clg[i]=0;
-    }
-    for (int i=0; i<nz; i++) {
-	int col = coefs[i].col;
-	if (col==-1) {
-	    col = n;
+	const CoinBigIndex begin = Cst[j];
+	const CoinBigIndex end = Cst[j]+Clg[j];
+	Cst[j] = nz;
+	bool sorted = true;
+	for (CoinBigIndex k=begin; k<end; k++) {
+	    const int row = Rnr[k];
+	    if (where[row]>=Cst[j]) {
+		Elm[where[row]] += Elm[k];
+	    } else {
+		if (nz>Cst[j] && Rnr[nz-1]>row) {
+		    sorted = false;
+		}
+		where[row] = nz;
+		Rnr[nz] = row;
+		Elm[nz] = Elm[k];
+		nz++;
+	    }
+	}
+	Clg[j] = static_cast<int>(nz-Cst[j]);
+	if (sorted == false) {
+	    vector<pair<int,double> > column(Clg[j]);
+	    for (int k=0; k<Clg[j]; k++) {
+		column[k] = make_pair(Rnr[Cst[j]+k],Elm[Cst[j]+k]);
+	    }
+	    std::sort(column.begin(),column.end());
+	    for (int k=0; k<Clg[j]; k++) {
+		Rnr[Cst[j]+k] = column[k].first;
+		Elm[Cst[j]+k] = column[k].second;
+	    }
 	}
-	int row = coefs[i].row;
-	double elm = coefs[i].val;
-	Elm[Cst[col]+Clg[col]] = elm;
-	Rnr[Cst[col]+Clg[col]] = row;
-	Clg[col]++;
     }
+    Cst[n+1] = nz;
+
+    messenger->statistics(static_cast<int>(Constraints.size()),m,static_cast<int>(Variables.size()),n,nz);
 
     // Row bounds
     for (int i=0; i<m; i++) {
 	bl[i] = 0;
 	bu[i] = 0;
     }
-    for (int j=Cst[n]; j<Cst[n+1]; j++) {
+    for (CoinBigIndex j=Cst[n]; j<Cst[n+1]; j++) {
 	bl[Rnr[j]] = -Elm[j];
 	bu[Rnr[j]] = -Elm[j];
     }
@@ -343,28 +982,17 @@ void MP_model::attach(OsiSolverInterface *_solver) {
     }
 
     // Generate objective function coefficients
-    vector<Constant> v;
-    if (doAssemble == true) {
-	ObjectiveGenerateFunctor f(cfs);
-	coefs.erase(coefs.begin(),coefs.end());
-	Objective->generate(MP_domain::getEmpty(), v, f, 1.0);
-
-	messenger->objectiveDebug(cfs);
-	assemble(cfs,coefs);
-    } else {
-	ObjectiveGenerateFunctor f(coefs);
-	coefs.erase(coefs.begin(),coefs.end());
-	Objective->generate(MP_domain::getEmpty(), v, f, 1.0);
-    }	
+    vector<Coef> objCoefs;
+    generateObjective(objCoefs,0,&profile.objective);
 
     c =  new double[n]; 
     for (int j=0; j<n; j++) {
 	c[j] = 0.0;
     }
-    for (size_t i=0; i<coefs.size(); i++) {
-	int col = coefs[i].col;
-	double elm = coefs[i].val;
-	c[col] = elm;
+    for (size_t i=0; i<objCoefs.size(); i++) {
+	if (objCoefs[i].col>=0) {
+	    c[objCoefs[i].col] += objCoefs[i].val;
+	}
     } 
 
     // Column bounds
@@ -380,21 +1008,12 @@ void MP_model::attach(OsiSolverInterface *_solver) {
 	}
     }
 
-    CoinPackedMatrix A(true,m,n,Cst[n],Elm,Rnr,Cst,Clg);
-    Solver->loadProblem(A, l, u, c, bl, bu);
-
-    // Instead of the 2 lines above we should be able to use
-    // the line below, but due to a bug in OsiGlpk it does not work
-    // Solver->loadProblem(n, m, Cst, Rnr, Elm, l, u, c, bl, bu);
-
-    delete [] Elm; 
-    delete [] Rnr;    
-    delete [] Cst;   
-    delete [] Clg;   
-    delete [] l;  
-    delete [] u;  
-    delete [] bl;  
-    delete [] bu;  
+    // The solver takes over the arrays (which sets the pointers to 0).
+    // The right hand side left behind the last column is free space.
+    step = CoinGetTimeOfDay();
+    CoinPackedMatrix* A = new CoinPackedMatrix;
+    A->assignMatrix(true,m,n,Cst[n],Elm,Rnr,Cst,Clg,n+1,size);
+    Solver->assignProblem(A, l, u, c, bl, bu);
 
     for (varIt i=Variables.begin(); i!=Variables.end(); i++) {
         int begin = (*i)->offset;
@@ -405,13 +1024,601 @@ void MP_model::attach(OsiSolverInterface *_solver) {
             }
         }
     }
+    profile.loadTime = CoinGetTimeOfDay()-step;
+    constraintLayout.clear();
+    for (conIt i=Constraints.begin(); i!=Constraints.end(); i++) {
+        constraintLayout.push_back(make_pair((*i)->offset,(*i)->size()));
+    }
+    variableLayout.clear();
+    for (varIt i=Variables.begin(); i!=Variables.end(); i++) {
+        variableLayout.push_back(make_pair((*i)->offset,(*i)->size()));
+    }
+    attachedSolver = Solver;
+    attachStamp = Stamped::now();
+    mResolve = false;
+
     mSolverState = MP_model::ATTACHED;
-    messenger->generationTime(time-CoinCpuTime());
+    finishProfile(time,wall);
+}
+
+void MP_model::layout() {
+    m=0;
+    n=0;
+    if (Objective.operator->()!=0) {
+	Objective->insertVariables(Variables);
+    }
+    for (conIt i=Constraints.begin(); i!=Constraints.end(); i++) {
+	add(*i);
+	(*i)->insertVariables(Variables);
+    }
+    for (varIt j=Variables.begin(); j!=Variables.end(); j++) {
+	add(*j);
+    }
+}
 
+void MP_model::generateObjective(vector<Coef>& coefs, CoefRecipes* recipes,
+                                BlockProfile* profile) {
+    Arena::Scope scope(0);
+    ObjectiveGenerateFunctor f(coefs);
+    f.setRecipes(recipes);
+    BlockProfile block;
+    startBlock(block,"objective",0);
+    const size_t first = coefs.size();
+    GenerationProgram program;
+    program.compile(Objective.operator->(), MP_domain::getEmpty(), 1.0);
+    program.prepare();
+    objectiveData.clear();
+    objectiveSubsets.clear();
+    MP_data::startRecording(objectiveData);
+    MP_subset_base::startRecording(objectiveSubsets);
+    program.run(f);
+    MP_data::stopRecording();
+    MP_subset_base::stopRecording();
+    stopBlock(block,f,coefs.size()-first);
+    if (profile!=0) {
+        *profile = block;
+    }
+    messenger->objectiveDebug(coefs);
+}
+
+bool MP_model::isModified(const vector<const MP_data*>& used) const {
+    for (size_t i=0; i<used.size(); i++) {
+        if (used[i]->modifiedSince(attachStamp) == true) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MP_model::isModified(const vector<const MP_subset_base*>& used) const {
+    for (size_t i=0; i<used.size(); i++) {
+        if (used[i]->getStamp()>attachStamp) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MP_model::sameLayout() {
+    // Anything that moves rows or columns around requires a full attach.
+    if (attachStamp==0 || Solver->getNumRows()!=m || Solver->getNumCols()!=n ||
+        Constraints.size()!=constraintLayout.size() ||
+        Variables.size()!=variableLayout.size()) {
+        return false;
+    }
+    set<MP_variable*> vars;
+    Objective->insertVariables(vars);
+    size_t k = 0;
+    for (conIt i=Constraints.begin(); i!=Constraints.end(); i++, k++) {
+        if ((*i)->M!=this || (*i)->offset!=constraintLayout[k].first ||
+            (*i)->size()!=constraintLayout[k].second) {
+            return false;
+        }
+        (*i)->insertVariables(vars);
+    }
+    for (varIt j=vars.begin(); j!=vars.end(); j++) {
+        if (Variables.find(*j)==Variables.end()) {
+            return false;
+        }
+    }
+    k = 0;
+    for (varIt j=Variables.begin(); j!=Variables.end(); j++, k++) {
+        if ((*j)->M!=this || (*j)->offset!=variableLayout[k].first ||
+            (*j)->size()!=variableLayout[k].second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MP_model::update() {
+    if (sameLayout()==false) {
+        return false;
+    }
+    double time = CoinCpuTime();
+    double wall = CoinGetTimeOfDay();
+    profile = GenerationProfile();
+    profile.kind = "update";
+    const double inf = Solver->getInfinity();
+
+    // Regenerate the modified constraint blocks. Rows whose coefficients
+    // are unchanged only get their bounds updated, the others are kept
+    // for a reload of the matrix.
+    vector<int> boundRows;
+    vector<double> boundValues;
+    map<int, vector<pair<int,double> > > newRows;
+    const CoinPackedMatrix* rowMatrix = 0;
+    vector<double> dense;
+    vector<int> where;
+    vector<MP_constraint*> blocks;
+    for (conIt i=Constraints.begin(); i!=Constraints.end(); i++) {
+        if ((*i)->getStamp()>attachStamp || isModified((*i)->dataUsed)==true ||
+            isModified((*i)->subsetsUsed)==true) {
+            blocks.push_back(*i);
+        }
+    }
+    vector<vector<Coef> > coefs;
+    vector<size_t> firstBuffer;
+    double step = CoinGetTimeOfDay();
+    generate(blocks,coefs,firstBuffer,0,&profile.blocks);
+    profile.generateTime = CoinGetTimeOfDay()-step;
+    for (size_t b=0; b<blocks.size(); b++) {
+        MP_constraint* const cst = blocks[b];
+        const int begin = cst->offset;
+        const int size = cst->size();
+        vector<vector<pair<int,double> > > rows(size);
+        vector<double> rhs(size,0.0);
+        for (size_t t=firstBuffer[b]; t<firstBuffer[b+1]; t++) {
+            for (size_t j=0; j<coefs[t].size(); j++) {
+                const Coef& cf = coefs[t][j];
+                if (cf.col==-1) {
+                    rhs[cf.row-begin] += cf.val;
+                } else {
+                    rows[cf.row-begin].push_back(make_pair(cf.col,cf.val));
+                }
+            }
+            vector<Coef>().swap(coefs[t]);
+        }
+        if (rowMatrix==0) {
+            rowMatrix = Solver->getMatrixByRow();
+            dense.resize(n,0.0);
+            where.resize(n,-1);
+        }
+        const double* rowLower = Solver->getRowLower();
+        const double* rowUpper = Solver->getRowUpper();
+        for (int r=0; r<size; r++) {
+            const int row = begin+r;
+            double lb = -rhs[r];
+            double ub = -rhs[r];
+            switch (cst->sense) {
+                case LE:
+                    lb = -inf;
+                    break;
+                case GE:
+                    ub = inf;
+                    break;
+                case EQ:
+                    break;
+            }
+            if (lb!=rowLower[row] || ub!=rowUpper[row]) {
+                boundRows.push_back(row);
+                boundValues.push_back(lb);
+                boundValues.push_back(ub);
+            }
+            // Sum up duplicate coefficients of the new row
+            vector<pair<int,double> >& newRow = rows[r];
+            int length = 0;
+            for (size_t e=0; e<newRow.size(); e++) {
+                const int col = newRow[e].first;
+                if (where[col]>=0) {
+                    newRow[where[col]].second += newRow[e].second;
+                } else {
+                    where[col] = length;
+                    newRow[length++] = newRow[e];
+                }
+            }
+            newRow.resize(length);
+            for (int e=0; e<length; e++) {
+                where[newRow[e].first] = -1;
+            }
+            // Compare with the row in the solver, ignoring explicit zeros
+            const CoinShallowPackedVector old = rowMatrix->getVector(row);
+            int oldCount = 0;
+            for (int e=0; e<old.getNumElements(); e++) {
+                if (old.getElements()[e]!=0.0) {
+                    dense[old.getIndices()[e]] = old.getElements()[e];
+                    oldCount++;
+                }
+            }
+            bool same = true;
+            int newCount = 0;
+            for (size_t e=0; e<rows[r].size(); e++) {
+                if (rows[r][e].second!=0.0) {
+                    newCount++;
+                    if (dense[rows[r][e].first]!=rows[r][e].second) {
+                        same = false;
+                    }
+                }
+            }
+            for (int e=0; e<old.getNumElements(); e++) {
+                dense[old.getIndices()[e]] = 0.0;
+            }
+            if (same==false || oldCount!=newCount) {
+                newRows[row].swap(rows[r]);
+            }
+        }
+    }
+    step = CoinGetTimeOfDay();
+    if (boundRows.size()>0) {
+        Solver->setRowSetBounds(&boundRows[0],&boundRows[0]+boundRows.size(),
+                                &boundValues[0]);
+    }
+    profile.loadTime += CoinGetTimeOfDay()-step;
+
+    // Objective
+    if (objectiveStamp>attachStamp || isModified(objectiveData)==true ||
+        isModified(objectiveSubsets)==true) {
+        vector<Coef> objCoefs;
+        generateObjective(objCoefs,0,&profile.objective);
+        vector<double> obj(n,0.0);
+        for (size_t j=0; j<objCoefs.size(); j++) {
+            if (objCoefs[j].col>=0) {
+                obj[objCoefs[j].col] += objCoefs[j].val;
+            }
+        }
+        const double* oldObj = Solver->getObjCoefficients();
+        vector<int> cols;
+        vector<double> vals;
+        for (int j=0; j<n; j++) {
+            if (obj[j]!=oldObj[j]) {
+                cols.push_back(j);
+                vals.push_back(obj[j]);
+            }
+        }
+        step = CoinGetTimeOfDay();
+        if (cols.size()>0) {
+            Solver->setObjCoeffSet(&cols[0],&cols[0]+cols.size(),&vals[0]);
+        }
+        profile.loadTime += CoinGetTimeOfDay()-step;
+    }
+
+    // Column bounds and types
+    step = CoinGetTimeOfDay();
+    for (varIt i=Variables.begin(); i!=Variables.end(); i++) {
+        const int begin = (*i)->offset;
+        const int end = (*i)->offset+(*i)->size();
+        if ((*i)->lowerLimit.modifiedSince(attachStamp)==true ||
+            (*i)->upperLimit.modifiedSince(attachStamp)==true) {
+            for (int j=begin; j<end; j++) {
+                Solver->setColBounds(j,(*i)->lowerLimit.v[j-begin],
+                                     (*i)->upperLimit.v[j-begin]);
+            }
+        }
+        if ((*i)->getStamp()>attachStamp) {
+            for (int j=begin; j<end; j++) {
+                if ((*i)->type == discrete) {
+                    Solver->setInteger(j);
+                } else {
+                    Solver->setContinuous(j);
+                }
+            }
+        }
+    }
+    profile.loadTime += CoinGetTimeOfDay()-step;
+
+    // Coefficients changed: reload the matrix, keeping bounds, objective
+    // and the current basis.
+    if (newRows.size()>0) {
+        rowMatrix = Solver->getMatrixByRow();
+        vector<CoinBigIndex> start(1,0);
+        vector<int> length;
+        vector<int> index;
+        vector<double> element;
+        map<int, vector<pair<int,double> > >::const_iterator nr = newRows.begin();
+        for (int row=0; row<m; row++) {
+            if (nr!=newRows.end() && nr->first==row) {
+                for (size_t e=0; e<nr->second.size(); e++) {
+                    index.push_back(nr->second[e].first);
+                    element.push_back(nr->second[e].second);
+                }
+                nr++;
+            } else {
+                const CoinShallowPackedVector old = rowMatrix->getVector(row);
+                index.insert(index.end(),old.getIndices(),
+                             old.getIndices()+old.getNumElements());
+                element.insert(element.end(),old.getElements(),
+                               old.getElements()+old.getNumElements());
+            }
+            length.push_back(static_cast<int>(index.size()-start.back()));
+            start.push_back(static_cast<CoinBigIndex>(index.size()));
+        }
+        CoinPackedMatrix A(false,n,m,static_cast<CoinBigIndex>(element.size()),
+                           &element[0],&index[0],&start[0],&length[0]);
+        step = CoinGetTimeOfDay();
+        reload(A);
+        profile.loadTime += CoinGetTimeOfDay()-step;
+    }
+
+    attachStamp = Stamped::now();
+    mResolve = true;
+    mSolverState = MP_model::ATTACHED;
+    finishProfile(time,wall);
+    return true;
+}
+
+void MP_model::finishProfile(double time, double wall) {
+    profile.m = m;
+    profile.n = n;
+    profile.nz = Solver->getNumElements();
+    profile.wallTime = CoinGetTimeOfDay()-wall;
+    profile.cpuTime = CoinCpuTime()-time;
+    profile.assembleTime = std::max(0.0,profile.wallTime-profile.generateTime-
+                                    profile.objective.wallTime-profile.loadTime);
+    messenger->generationTime(profile.cpuTime);
+    messenger->generationProfile(profile);
+}
+
+void MP_model::reload(const CoinPackedMatrix& A) {
+    vector<double> collb(Solver->getColLower(),Solver->getColLower()+n);
+    vector<double> colub(Solver->getColUpper(),Solver->getColUpper()+n);
+    vector<double> obj(Solver->getObjCoefficients(),
+                       Solver->getObjCoefficients()+n);
+    vector<double> rowlb(Solver->getRowLower(),Solver->getRowLower()+m);
+    vector<double> rowub(Solver->getRowUpper(),Solver->getRowUpper()+m);
+    CoinWarmStart* basis = Solver->getWarmStart();
+    Solver->loadProblem(A,&collb[0],&colub[0],&obj[0],&rowlb[0],&rowub[0]);
+    for (varIt i=Variables.begin(); i!=Variables.end(); i++) {
+        if ((*i)->type == discrete) {
+            for (int j=(*i)->offset; j<(*i)->offset+(*i)->size(); j++) {
+                Solver->setInteger(j);
+            }
+        }
+    }
+    if (basis!=0) {
+        Solver->setWarmStart(basis);
+        delete basis;
+    }
+}
+
+bool MP_model::useTemplate() {
+    delete generationTemplate;
+    generationTemplate = 0;
+    if (Solver==0) {
+        return false;
+    }
+    attach();
+    double time = CoinCpuTime();
+    GenerationTemplate* t = new GenerationTemplate;
+    t->stamp = Stamped::now();
+
+    // Generate everything once more, recording the recipes of the values
+    CoefRecipes recipes;
+    vector<Coef> all;
+    vector<Coef> coefs;
+    for (conIt i=Constraints.begin(); i!=Constraints.end(); i++) {
+        generate(*i,coefs,0,&recipes);
+        all.insert(all.end(),coefs.begin(),coefs.end());
+        t->structure.insert(t->structure.end(),(*i)->dataUsed.begin(),
+                            (*i)->dataUsed.end());
+        t->subsets.insert(t->subsets.end(),(*i)->subsetsUsed.begin(),
+                          (*i)->subsetsUsed.end());
+    }
+    coefs.clear();
+    generateObjective(coefs,&recipes);
+    all.insert(all.end(),coefs.begin(),coefs.end());
+    t->structure.insert(t->structure.end(),objectiveData.begin(),
+                        objectiveData.end());
+    t->subsets.insert(t->subsets.end(),objectiveSubsets.begin(),
+                      objectiveSubsets.end());
+    if (recipes.complete==false) {
+        delete t;
+        // dataUsed lacks the factors now
+        attachStamp = 0;
+        messenger->logMessage(1,"FlopCpp: some coefficients are no "
+                              "products of data, no template used");
+        return false;
+    }
+    sort(t->structure.begin(),t->structure.end());
+    t->structure.erase(unique(t->structure.begin(),t->structure.end()),
+                       t->structure.end());
+
+    // The matrix pattern, column by column as attach() lays it out
+    vector<size_t> order;
+    for (size_t k=0; k<all.size(); k++) {
+        if (all[k].col>=0 && all[k].row>=0) {
+            order.push_back(k);
+        }
+    }
+    vector<pair<pair<int,int>,size_t> > keys(order.size());
+    for (size_t k=0; k<order.size(); k++) {
+        keys[k] = make_pair(make_pair(all[order[k]].col,all[order[k]].row),
+                            order[k]);
+    }
+    sort(keys.begin(),keys.end());
+    vector<int> target(all.size(),-1);
+    t->start.assign(n+1,0);
+    for (size_t k=0; k<keys.size(); k++) {
+        if (k==0 || keys[k].first!=keys[k-1].first) {
+            t->index.push_back(keys[k].first.second);
+            t->start[keys[k].first.first+1]++;
+        }
+        target[keys[k].second] = static_cast<int>(t->index.size())-1;
+    }
+    for (int j=0; j<n; j++) {
+        t->start[j+1] += t->start[j];
+    }
+    const int nz = static_cast<int>(t->index.size());
+    for (size_t k=0; k<all.size(); k++) {
+        if (all[k].col==-1 && all[k].row>=0) {
+            target[k] = nz+all[k].row;
+        } else if (all[k].row==-1 && all[k].col>=0) {
+            target[k] = nz+m+all[k].col;
+        }
+    }
+
+    // Sort the terms by the number of data values they read
+    t->base.assign(nz+m+n,0.0);
+    t->firstN.push_back(0);
+    for (size_t k=0; k<all.size(); k++) {
+        if (target[k]<0) {
+            continue;
+        }
+        const int begin = recipes.first[k];
+        const int end = recipes.first[k+1];
+        if (begin==end) {
+            t->base[target[k]] += recipes.factor[k];
+        } else if (end==begin+1) {
+            t->target1.push_back(target[k]);
+            t->factor1.push_back(recipes.factor[k]);
+            t->entry1.push_back(recipes.entries[begin]);
+        } else {
+            t->targetN.push_back(target[k]);
+            t->factorN.push_back(recipes.factor[k]);
+            t->entryN.insert(t->entryN.end(),recipes.entries.begin()+begin,
+                             recipes.entries.begin()+end);
+            t->firstN.push_back(static_cast<int>(t->entryN.size()));
+        }
+    }
+    vector<double> values;
+    t->evaluate(values);
+    t->elements.assign(values.begin(),values.begin()+nz);
+    generationTemplate = t;
+    messenger->generationTime(CoinCpuTime()-time);
+    return true;
+}
+
+bool MP_model::rebind() {
+    GenerationTemplate& t = *generationTemplate;
+    if (sameLayout()==false || objectiveStamp>t.stamp) {
+        return false;
+    }
+    for (conIt i=Constraints.begin(); i!=Constraints.end(); i++) {
+        if ((*i)->getStamp()>t.stamp) {
+            return false;
+        }
+    }
+    for (varIt j=Variables.begin(); j!=Variables.end(); j++) {
+        if ((*j)->getStamp()>t.stamp) {
+            return false;
+        }
+    }
+    for (size_t d=0; d<t.structure.size(); d++) {
+        if (t.structure[d]->modifiedSince(t.stamp)==true) {
+            return false;
+        }
+    }
+    for (size_t d=0; d<t.subsets.size(); d++) {
+        if (t.subsets[d]->getStamp()>t.stamp) {
+            return false;
+        }
+    }
+    double time = CoinCpuTime();
+    double wall = CoinGetTimeOfDay();
+    profile = GenerationProfile();
+    profile.kind = "template";
+    const double inf = Solver->getInfinity();
+    const int nz = static_cast<int>(t.index.size());
+    vector<double> values;
+    t.evaluate(values);
+    profile.generateTime = CoinGetTimeOfDay()-wall;
+
+    // Row bounds
+    const double* rowLower = Solver->getRowLower();
+    const double* rowUpper = Solver->getRowUpper();
+    vector<int> rows;
+    vector<double> bounds;
+    for (conIt i=Constraints.begin(); i!=Constraints.end(); i++) {
+        for (int row=(*i)->offset; row<(*i)->offset+(*i)->size(); row++) {
+            double lb = -values[nz+row];
+            double ub = -values[nz+row];
+            switch ((*i)->sense) {
+                case LE:
+                    lb = -inf;
+                    break;
+                case GE:
+                    ub = inf;
+                    break;
+                case EQ:
+                    break;
+            }
+            if (lb!=rowLower[row] || ub!=rowUpper[row]) {
+                rows.push_back(row);
+                bounds.push_back(lb);
+                bounds.push_back(ub);
+            }
+        }
+    }
+    double step = CoinGetTimeOfDay();
+    if (rows.size()>0) {
+        Solver->setRowSetBounds(&rows[0],&rows[0]+rows.size(),&bounds[0]);
+    }
+    profile.loadTime += CoinGetTimeOfDay()-step;
+
+    // Objective
+    const double* obj = Solver->getObjCoefficients();
+    vector<int> cols;
+    vector<double> vals;
+    for (int j=0; j<n; j++) {
+        if (values[nz+m+j]!=obj[j]) {
+            cols.push_back(j);
+            vals.push_back(values[nz+m+j]);
+        }
+    }
+    step = CoinGetTimeOfDay();
+    if (cols.size()>0) {
+        Solver->setObjCoeffSet(&cols[0],&cols[0]+cols.size(),&vals[0]);
+    }
+    profile.loadTime += CoinGetTimeOfDay()-step;
+
+    // Column bounds
+    const double* colLower = Solver->getColLower();
+    const double* colUpper = Solver->getColUpper();
+    cols.clear();
+    bounds.clear();
+    for (varIt i=Variables.begin(); i!=Variables.end(); i++) {
+        for (int k=0; k<(*i)->size(); k++) {
+            const int col = (*i)->offset+k;
+            if ((*i)->lowerLimit.v[k]!=colLower[col] ||
+                (*i)->upperLimit.v[k]!=colUpper[col]) {
+                cols.push_back(col);
+                bounds.push_back((*i)->lowerLimit.v[k]);
+                bounds.push_back((*i)->upperLimit.v[k]);
+            }
+        }
+    }
+    step = CoinGetTimeOfDay();
+    if (cols.size()>0) {
+        Solver->setColSetBounds(&cols[0],&cols[0]+cols.size(),&bounds[0]);
+    }
+    profile.loadTime += CoinGetTimeOfDay()-step;
+
+    // Osi cannot change coefficients in place, so a changed matrix is
+    // reloaded, keeping bounds, objective and the current basis.
+    if (std::equal(t.elements.begin(),t.elements.end(),values.begin())==false) {
+        t.elements.assign(values.begin(),values.begin()+nz);
+        vector<int> length(n);
+        for (int j=0; j<n; j++) {
+            length[j] = static_cast<int>(t.start[j+1]-t.start[j]);
+        }
+        CoinPackedMatrix A(true,m,n,nz,&t.elements[0],&t.index[0],
+                           &t.start[0],&length[0]);
+        step = CoinGetTimeOfDay();
+        reload(A);
+        profile.loadTime += CoinGetTimeOfDay()-step;
+    }
+
+    attachStamp = Stamped::now();
+    mResolve = true;
+    mSolverState = MP_model::ATTACHED;
+    finishProfile(time,wall);
+    return true;
 }
 void MP_model::detach() {
     assert(Solver);
     mSolverState=MP_model::DETACHED;
+    attachedSolver=NULL;
+    delete generationTemplate;
+    generationTemplate=0;
     /// @todo strip all data out of the solver.
     delete Solver;
     Solver=NULL;
@@ -422,6 +1629,7 @@ MP_model::MP_status MP_model::solve(const MP_model::MP_direction &dir) {
     assert(mSolverState != MP_model::DETACHED && 
            mSolverState != MP_model::SOLVER_ONLY);
     Solver->setObjSense(dir);
+    direction = dir;
     bool isMIP = false;
     for (varIt i=Variables.begin(); i!=Variables.end(); i++) {
         if ((*i)->type == discrete) {
@@ -432,19 +1640,23 @@ MP_model::MP_status MP_model::solve(const MP_model::MP_direction &dir) {
     if (isMIP == true) {
 	try {
 	    Solver->branchAndBound();
-	} catch  (CoinError e) {
+	} catch (const CoinError& e) {
 	    cout<<e.message()<<endl;
 	    cout<<"Solving the LP relaxation instead."<<endl;
 	    try {
 		Solver->initialSolve();
-	    } catch (CoinError e) {
+	    } catch (const CoinError& e) {
 		cout<<e.message()<<endl;
 	    }
 	}
     } else {
 	try {
-	    Solver->initialSolve();
-	}  catch (CoinError e) {
+	    if (mResolve == true) {
+		Solver->resolve();
+	    } else {
+		Solver->initialSolve();
+	    }
+	} catch (const CoinError& e) {
 	    cout<<e.message()<<endl;
 	}
     }
@@ -507,3 +1719,501 @@ namespace flopc {
         return os;
     }
 }
+
+namespace {
+    // Coefficients are written in chunks of at most this many
+    const size_t chunkSize = 1<<22;
+
+    /** A temporary file coefficients are spilled to while a model too
+	large to keep is written, so its blocks are generated only once.
+	ok() turns false once the file cannot be created, written or read.
+    */
+    class CoefFile {
+    public:
+	CoefFile() : fp(0), size(0), position(0), good(true) {}
+	~CoefFile() {
+	    close();
+	}
+	bool ok() const {
+	    return good;
+	}
+	bool empty() const {
+	    return size == 0;
+	}
+	void append(const vector<Coef>& coefs) {
+	    if (coefs.empty() || good == false) {
+		return;
+	    }
+	    if (fp == 0) {
+		fp = std::tmpfile();
+		good = fp != 0;
+	    }
+	    good = good &&
+		std::fwrite(&coefs[0],sizeof(Coef),coefs.size(),fp) ==
+		coefs.size();
+	    size += coefs.size();
+	}
+	/// starts reading from the first coefficient.
+	void rewind() {
+	    position = 0;
+	    if (fp != 0) {
+		std::rewind(fp);
+	    }
+	}
+	/// reads the next at most max coefficients into coefs.
+	void read(vector<Coef>& coefs, size_t max) {
+	    const size_t count = std::min(max,size-position);
+	    coefs.resize(count,Coef(0,0,0.0));
+	    if (count > 0 && good == true) {
+		good = std::fread(&coefs[0],sizeof(Coef),count,fp) == count;
+	    }
+	    position += count;
+	}
+	/// reads all coefficients into coefs and closes the file.
+	void readAll(vector<Coef>& coefs) {
+	    rewind();
+	    read(coefs,size);
+	    close();
+	}
+	void close() {
+	    if (fp != 0) {
+		std::fclose(fp);
+		fp = 0;
+	    }
+	}
+    private:
+	CoefFile(const CoefFile&);
+	CoefFile& operator=(const CoefFile&);
+	FILE* fp;
+	size_t size;
+	size_t position;
+	bool good;
+    };
+}
+
+double MP_model::writtenInfinity() const {
+    // Variable bounds default to the infinity of the default model, which
+    // has no solver, so the smaller of the two is taken to be infinite.
+    return std::min(getInfinity(),getDefaultModel().getInfinity());
+}
+
+void MP_model::generate(MP_constraint* block, vector<Coef>& coefs,
+			vector<int>* stages, CoefRecipes* recipes) {
+    if (stages != 0 || recipes != 0) {
+	Arena::Scope scope(0);
+	coefs.clear();
+	if (stages != 0) {
+	    stages->clear();
+	}
+	GenerateFunctor f(coefs);
+	f.setStages(stages);
+	f.setRecipes(recipes);
+	block->dataUsed.clear();
+	block->subsetsUsed.clear();
+	MP_data::startRecording(block->dataUsed);
+	MP_subset_base::startRecording(block->subsetsUsed);
+	block->coefficients(f);
+	MP_data::stopRecording();
+	MP_subset_base::stopRecording();
+	return;
+    }
+    vector<MP_constraint*> blocks(1,block);
+    vector<vector<Coef> > buffers;
+    vector<size_t> firstBuffer;
+    generate(blocks,buffers,firstBuffer,0);
+    coefs.clear();
+    for (size_t b=0; b<buffers.size(); b++) {
+	coefs.insert(coefs.end(),buffers[b].begin(),buffers[b].end());
+	vector<Coef>().swap(buffers[b]);
+    }
+}
+
+namespace flopc {
+    CoinFileOutput* openOutput(string& name, int compression, 
+			       Messenger* messenger) {
+	CoinFileOutput::Compression method = CoinFileOutput::COMPRESS_NONE;
+	if (compression == 1 && 
+	    CoinFileOutput::compressionSupported(CoinFileOutput::COMPRESS_GZIP)) {
+	    method = CoinFileOutput::COMPRESS_GZIP;
+	    name += ".gz";
+	} else if (compression == 2 && 
+	    CoinFileOutput::compressionSupported(CoinFileOutput::COMPRESS_BZIP2)) {
+	    method = CoinFileOutput::COMPRESS_BZIP2;
+	    name += ".bz2";
+	}
+	try {
+	    return CoinFileOutput::create(name,method);
+	} catch (const CoinError&) {
+	    messenger->logMessage(0,("FlopCpp: cannot write "+name).c_str());
+	    return 0;
+	}
+    }
+}
+
+void MP_model::nameElements(ElementNames& rows, ElementNames& cols) {
+    for (conIt i=Constraints.begin(); i!=Constraints.end(); i++) {
+	rows.add((*i)->getName(),'R',(*i)->offset,(*i)->size(),
+		 (*i)->sizes,(*i)->rank);
+    }
+    for (varIt j=Variables.begin(); j!=Variables.end(); j++) {
+	cols.add((*j)->getName(),'C',(*j)->offset,(*j)->size(),
+		 (*j)->sizes,(*j)->rank);
+    }
+}
+
+int MP_model::write(const string& fileName, MP_format format,
+		    int compression) {
+    string name = fileName;
+    CoinFileOutput* out = openOutput(name,compression,messenger);
+    if (out == 0) {
+	return 1;
+    }
+
+    layout();
+    ElementNames rows;
+    ElementNames cols;
+    nameElements(rows,cols);
+    bool written = true;
+    if (format == LP) {
+	writeLp(*out,rows,cols);
+    } else {
+	written = writeMps(*out,rows,cols);
+    }
+    delete out;
+    return written ? 0 : 1;
+}
+
+bool MP_model::writeMps(CoinFileOutput& file, const ElementNames& rows,
+			const ElementNames& cols, const string& name,
+			const vector<int>& rowOrder,
+			const vector<int>& colOrder) {
+    const double inf = writtenInfinity();
+    vector<MP_constraint*> blocks(Constraints.begin(),Constraints.end());
+    LineWriter out(file);
+
+    // The i-th row written is order[i], column j is written at
+    // position[j]
+    vector<int> order(rowOrder);
+    if (order.empty()) {
+	for (int i=0; i<m; i++) {
+	    order.push_back(i);
+	}
+    }
+    vector<int> position(colOrder.empty() ? 0 : n);
+    for (size_t p=0; p<colOrder.size(); p++) {
+	position[colOrder[p]] = static_cast<int>(p);
+    }
+
+    out<<"NAME";
+    if (!name.empty()) {
+	out<<"          "<<name;
+    }
+    out<<"\n";
+    out<<"ROWS\n";
+    out<<" N  OBJ\n";
+    vector<const char*> senses(m);
+    for (size_t b=0; b<blocks.size(); b++) {
+	const char* sense = blocks[b]->sense == LE ? " L  " : 
+	    blocks[b]->sense == GE ? " G  " : " E  ";
+	for (int k=0; k<blocks[b]->size(); k++) {
+	    senses[blocks[b]->offset+k] = sense;
+	}
+    }
+    for (int i=0; i<m; i++) {
+	out<<senses[order[i]]<<rows(order[i])<<"\n";
+    }
+
+    // Each block is generated once, counting the coefficients of each
+    // column.  They are kept, or spilled to a file if there are too
+    // many.  The right hand side is kept.
+    vector<double> rhs(m,0.0);
+    vector<int> counts(n+2,0);
+    vector<Coef> chunk;
+    vector<Coef> coefs;
+    CoefFile spilled;
+    for (size_t b=0; b<blocks.size(); b++) {
+	vector<MP_constraint*> one(1,blocks[b]);
+	vector<vector<Coef> > buffers;
+	vector<size_t> firstBuffer;
+	generate(one,buffers,firstBuffer,&counts[0]);
+	for (size_t i=0; i<buffers.size(); i++) {
+	    for (size_t k=0; k<buffers[i].size(); k++) {
+		Coef& cf = buffers[i][k];
+		if (cf.col < 0) {
+		    rhs[cf.row] -= cf.val;
+		} else {
+		    if (!position.empty()) {
+			cf.col = position[cf.col];
+		    }
+		    chunk.push_back(cf);
+		}
+	    }
+	    vector<Coef>().swap(buffers[i]);
+	}
+	if (chunk.size() > chunkSize) {
+	    spilled.append(chunk);
+	    chunk.clear();
+	}
+    }
+    if (!spilled.empty()) {
+	spilled.append(chunk);
+	vector<Coef>().swap(chunk);
+    }
+    // From here on columns are identified by their position
+    if (!position.empty()) {
+	vector<int> byPosition(counts);
+	for (int j=0; j<n; j++) {
+	    byPosition[position[j]+1] = counts[j+1];
+	}
+	counts.swap(byPosition);
+    }
+
+    vector<Coef> objective;
+    if (Objective.operator->()!=0) {
+	generateObjective(objective);
+    }
+    vector<double> obj(n,0.0);
+    for (size_t i=0; i<objective.size(); i++) {
+	if (objective[i].col >= 0) {
+	    obj[objective[i].col] += objective[i].val;
+	}
+    }
+    vector<Coef>().swap(objective);
+
+    vector<bool> integer(n,false);
+    for (varIt j=Variables.begin(); j!=Variables.end(); j++) {
+	if ((*j)->type == discrete) {
+	    for (int k=0; k<(*j)->size(); k++) {
+		integer[(*j)->offset+k] = true;
+	    }
+	}
+    }
+
+    // The columns [bounds[c],bounds[c+1]) make up chunk c.  The
+    // coefficients spilled are sorted into a file for each chunk.
+    vector<int> bounds(1,0);
+    while (bounds.back() < n) {
+	int last = bounds.back();
+	size_t size = 0;
+	while (last < n && (last == bounds.back() || spilled.empty() ||
+			    size+counts[last+1] <= chunkSize)) {
+	    size += counts[last+1];
+	    last++;
+	}
+	bounds.push_back(last);
+    }
+    const int chunks = static_cast<int>(bounds.size())-1;
+    vector<CoefFile*> parts;
+    if (!spilled.empty()) {
+	vector<int> part(n);
+	for (int c=0; c<chunks; c++) {
+	    parts.push_back(new CoefFile);
+	    for (int p=bounds[c]; p<bounds[c+1]; p++) {
+		part[p] = c;
+	    }
+	}
+	const size_t pending = 1<<12;
+	vector<vector<Coef> > sorted(chunks);
+	spilled.rewind();
+	do {
+	    spilled.read(chunk,chunkSize);
+	    for (size_t k=0; k<chunk.size(); k++) {
+		const int c = part[chunk[k].col];
+		sorted[c].push_back(chunk[k]);
+		if (sorted[c].size() == pending) {
+		    parts[c]->append(sorted[c]);
+		    sorted[c].clear();
+		}
+	    }
+	} while (!chunk.empty());
+	spilled.close();
+	for (int c=0; c<chunks; c++) {
+	    parts[c]->append(sorted[c]);
+	}
+    }
+    bool ok = spilled.ok();
+    for (size_t c=0; c<parts.size(); c++) {
+	ok = ok && parts[c]->ok();
+    }
+
+    out<<"COLUMNS\n";
+    bool marked = false;
+    for (int c=0; c<chunks && ok==true; c++) {
+	const int first = bounds[c];
+	const int last = bounds[c+1];
+	if (parts.empty()) {
+	    chunk.swap(coefs);
+	} else {
+	    parts[c]->readAll(coefs);
+	    if (parts[c]->ok() == false) {
+		ok = false;
+		break;
+	    }
+	}
+	std::sort(coefs.begin(),coefs.end(),columnOrder);
+	merge(coefs);
+	size_t k = 0;
+	for (int p=first; p<last; p++) {
+	    const int j = colOrder.empty() ? p : colOrder[p];
+	    if (integer[j] != marked) {
+		out<<(marked ? "    MARKER  'MARKER'  'INTEND'\n" :
+		       "    MARKER  'MARKER'  'INTORG'\n");
+		marked = integer[j];
+	    }
+	    if (obj[j] != 0.0 || k == coefs.size() || coefs[k].col != p) {
+		out<<"    "<<cols(j)<<"  OBJ  "<<obj[j]<<"\n";
+	    }
+	    for (; k<coefs.size() && coefs[k].col==p; k++) {
+		out<<"    "<<cols(j)<<"  "<<rows(coefs[k].row)<<"  "
+		   <<coefs[k].val<<"\n";
+	    }
+	}
+	vector<Coef>().swap(coefs);
+    }
+    for (size_t c=0; c<parts.size(); c++) {
+	delete parts[c];
+    }
+    if (ok == false) {
+	messenger->logMessage(0,"FlopCpp: cannot write a temporary file");
+	return false;
+    }
+    if (marked == true) {
+	out<<"    MARKER  'MARKER'  'INTEND'\n";
+    }
+
+    out<<"RHS\n";
+    for (int i=0; i<m; i++) {
+	if (rhs[order[i]] != 0.0) {
+	    out<<"    RHS  "<<rows(order[i])<<"  "<<rhs[order[i]]<<"\n";
+	}
+    }
+
+    out<<"BOUNDS\n";
+    for (varIt j=Variables.begin(); j!=Variables.end(); j++) {
+	for (int k=0; k<(*j)->size(); k++) {
+	    const double lower = (*j)->lowerLimit.v[k];
+	    const double upper = (*j)->upperLimit.v[k];
+	    const ElementNames::Name col = cols((*j)->offset+k);
+	    if (lower == upper) {
+		out<<" FX BND "<<col<<"  "<<lower<<"\n";
+		continue;
+	    }
+	    if (lower <= -inf) {
+		out<<" MI BND "<<col<<"\n";
+	    } else if (lower != 0.0) {
+		out<<" LO BND "<<col<<"  "<<lower<<"\n";
+	    }
+	    if (upper < inf) {
+		out<<" UP BND "<<col<<"  "<<upper<<"\n";
+	    } else if ((*j)->type == discrete) {
+		// Some readers give integer columns an upper bound of 1
+		out<<" PL BND "<<col<<"\n";
+	    }
+	}
+    }
+    out<<"ENDATA\n";
+    return true;
+}
+
+void MP_model::writeLp(CoinFileOutput& file, const ElementNames& rows,
+		       const ElementNames& cols) {
+    const double inf = writtenInfinity();
+    vector<MP_constraint*> blocks(Constraints.begin(),Constraints.end());
+    LineWriter out(file);
+
+    vector<Coef> coefs;
+    if (Objective.operator->()!=0) {
+	generateObjective(coefs);
+    }
+    for (size_t i=0; i<coefs.size(); i++) {
+	// The row is irrelevant, constants are left out
+	coefs[i].row = 0;
+    }
+    std::sort(coefs.begin(),coefs.end(),rowOrder);
+    merge(coefs);
+    out<<(direction == MAXIMIZE ? "Maximize\n obj:" : "Minimize\n obj:");
+    int terms = 0;
+    for (size_t i=0; i<coefs.size(); i++) {
+	if (coefs[i].col >= 0) {
+	    out<<(coefs[i].val < 0 ? " - " : " + ")<<std::abs(coefs[i].val)
+	       <<" "<<cols(coefs[i].col);
+	    if (++terms%4 == 0) {
+		out<<"\n";
+	    }
+	}
+    }
+    if (terms == 0 && n > 0) {
+	out<<" 0 "<<cols(0);
+    }
+    out<<"\nSubject To\n";
+
+    for (size_t b=0; b<blocks.size(); b++) {
+	generate(blocks[b],coefs);
+	std::sort(coefs.begin(),coefs.end(),rowOrder);
+	merge(coefs);
+	const char* sense = blocks[b]->sense == LE ? " <= " :
+	    blocks[b]->sense == GE ? " >= " : " = ";
+	size_t i = 0;
+	for (int r=blocks[b]->offset; 
+	     r<blocks[b]->offset+blocks[b]->size(); r++) {
+	    out<<" "<<rows(r)<<":";
+	    double rhs = 0.0;
+	    terms = 0;
+	    for (; i<coefs.size() && coefs[i].row==r; i++) {
+		if (coefs[i].col < 0) {
+		    rhs -= coefs[i].val;
+		} else {
+		    out<<(coefs[i].val < 0 ? " - " : " + ")
+		       <<std::abs(coefs[i].val)<<" "<<cols(coefs[i].col);
+		    if (++terms%4 == 0) {
+			out<<"\n";
+		    }
+		}
+	    }
+	    if (terms == 0 && n > 0) {
+		out<<" 0 "<<cols(0);
+	    }
+	    out<<sense<<rhs<<"\n";
+	}
+    }
+    vector<Coef>().swap(coefs);
+
+    out<<"Bounds\n";
+    for (varIt j=Variables.begin(); j!=Variables.end(); j++) {
+	for (int k=0; k<(*j)->size(); k++) {
+	    const double lower = (*j)->lowerLimit.v[k];
+	    const double upper = (*j)->upperLimit.v[k];
+	    const ElementNames::Name col = cols((*j)->offset+k);
+	    if (lower == upper) {
+		out<<" "<<col<<" = "<<lower<<"\n";
+	    } else if (lower <= -inf && upper >= inf) {
+		out<<" "<<col<<" free\n";
+	    } else if (lower != 0.0 || upper < inf) {
+		if (lower <= -inf) {
+		    out<<" -inf";
+		} else {
+		    out<<" "<<lower;
+		}
+		out<<" <= "<<col<<" <= ";
+		if (upper >= inf) {
+		    out<<"+inf\n";
+		} else {
+		    out<<upper<<"\n";
+		}
+	    }
+	}
+    }
+    bool generals = false;
+    for (varIt j=Variables.begin(); j!=Variables.end(); j++) {
+	if ((*j)->type == discrete) {
+	    if (generals == false) {
+		out<<"Generals\n";
+		generals = true;
+	    }
+	    for (int k=0; k<(*j)->size(); k++) {
+		out<<" "<<cols((*j)->offset+k)<<"\n";
+	    }
+	}
+    }
+    out<<"End\n";
+}
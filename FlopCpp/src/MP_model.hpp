@@ -17,13 +17,68 @@
 #include "MP_expression.hpp"
 #include "MP_constraint.hpp"
 #include <CoinPackedVector.hpp>
+#include <CoinTypes.hpp>
 class OsiSolverInterface;
+class CoinFileOutput;
+class CoinPackedMatrix;
 
 namespace flopc {
 
     class MP_variable;
     class MP_index;
     class MP_set;
+    class GenerationTask;
+    class GenerationTemplate;
+    class ElementNames;
+    class MP_column;
+
+    /** @brief How long generating one constraint block took.
+        @ingroup PublicInterface
+        @see GenerationProfile
+    */
+    struct BlockProfile {
+        BlockProfile() : rows(0), iterations(0), coefficients(0),
+                         wallTime(0.0), cpuTime(0.0) {}
+        std::string name;
+        int rows;
+        /// times the domain reached a term, whether or not it emitted
+        size_t iterations;
+        /// coefficients emitted, including right hand side terms
+        size_t coefficients;
+        double wallTime;
+        double cpuTime;
+    };
+
+    /** @brief Where the time of the last attach() of a model went.
+        @ingroup PublicInterface
+        Only the regenerated blocks are listed after an incremental
+        update, none after a template rebind.  With several threads the
+        block times add up the slices of a block done on different
+        threads, so they may exceed generateTime.
+        @see MP_model::getGenerationProfile(), Messenger
+    */
+    struct GenerationProfile {
+        GenerationProfile() : m(0), n(0), nz(0), generateTime(0.0),
+                              assembleTime(0.0), loadTime(0.0),
+                              wallTime(0.0), cpuTime(0.0) {}
+        /// writes the profile as a JSON object.
+        void writeJson(std::ostream& os) const;
+        /// "attach", "update" or "template"
+        std::string kind;
+        int m, n;
+        CoinBigIndex nz;
+        std::vector<BlockProfile> blocks;
+        BlockProfile objective;
+        /// wall time generating the constraint blocks
+        double generateTime;
+        /// wall time merging the coefficients into the matrix and bounds
+        double assembleTime;
+        /// wall time passing the problem to the solver
+        double loadTime;
+        /// time of the whole attach()
+        double wallTime;
+        double cpuTime;
+    };
 
     /** @brief Inteface for hooking up to internal flopc++ message handling.
         @ingroup PublicInterface
@@ -38,9 +93,18 @@ namespace flopc {
         friend class MP_model;
     private:
         virtual void constraintDebug(std::string name, const std::vector<Coef>& cfs) {}
+        /** Called instead of the above for models with stages, stages[k]
+            is the stage of cfs[k].
+        */
+        virtual void constraintDebug(std::string name, const std::vector<Coef>& cfs,
+                                     const std::vector<int>& stages) {
+            constraintDebug(name,cfs);
+        }
         virtual void objectiveDebug(const std::vector<Coef>& cfs) {}
-        virtual void statistics(int bm, int m, int bn, int n, int nz) {}
+        virtual void statistics(int bm, int m, int bn, int n, CoinBigIndex nz) {}
         virtual void generationTime(double t) {}
+        /// Called at the end of each attach().
+        virtual void generationProfile(const GenerationProfile& profile) {}
     protected:
         virtual ~Messenger() {}
     };
@@ -51,7 +115,7 @@ namespace flopc {
     class NormalMessenger : public Messenger {
         friend class MP_model;
     private:
-        virtual void statistics(int bm, int m, int bn, int n, int nz);
+        virtual void statistics(int bm, int m, int bn, int n, CoinBigIndex nz);
         virtual void generationTime(double t);
     };
 
@@ -62,7 +126,10 @@ namespace flopc {
         friend class MP_model;
     private:
         virtual void constraintDebug(std::string name, const std::vector<Coef>& cfs);
+        virtual void constraintDebug(std::string name, const std::vector<Coef>& cfs,
+                                     const std::vector<int>& stages);
         virtual void objectiveDebug(const std::vector<Coef>& cfs);
+        virtual void generationProfile(const GenerationProfile& profile);
     };
 
     /** @brief This is the anchor point for all constructs in a FlopC++ model.
@@ -88,6 +155,11 @@ namespace flopc {
     */
     class MP_model {
         friend class MP_constraint;
+        friend class MP_context;
+        friend class MP_benders;
+        friend class MP_smps;
+        friend class MP_stage;
+        friend class MP_stochastic_data;
     public:
         /// used when calling the solve() method.  
         typedef enum {MINIMIZE=1, MAXIMIZE=-1} MP_direction;
@@ -113,12 +185,13 @@ namespace flopc {
             DETACHED
         } MP_status;
 
+        /// file formats written by write().
+        typedef enum {MPS, LP} MP_format;
+
         /// Constructs an MP_model from an OsiSolverInterface *.
         MP_model(OsiSolverInterface* s, Messenger* m = new NormalMessenger);
 
-        ~MP_model() {
-            delete messenger;
-        }
+        ~MP_model();
 
         /** @brief Returns the current status of the model-solver interaction.
             This method will return the current understanding of the model in
@@ -144,6 +217,7 @@ namespace flopc {
         /// allows for replacement of the solver used.
         void setSolver(OsiSolverInterface* s) {
             Solver = s;
+            attachedSolver = 0;
         }
 
         /// allows access to the OsiSolverInterface *
@@ -151,6 +225,54 @@ namespace flopc {
             return Solver;
         }
 
+        /** @brief Sets the number of threads generating the coefficients
+            of the constraint blocks in attach().
+            The blocks, and slices of the first index of large blocks, are
+            generated concurrently into separate buffers which are merged
+            in block order, so the solver gets the same problem as with a
+            single thread.
+            @note This only has an effect if FlopCpp is configured with
+            --enable-flopcpp-parallel (FLOPCPP_THREAD); the number is
+            limited to FLOPCPP_MAX_THREADS.
+        */
+        void setNumberThreads(int number);
+
+        /** @brief Places the symbolic nodes built from now on in an arena
+            owned by the model.
+            Expressions, constants, booleans, domains and index
+            expressions are then allocated from large blocks and copying
+            them does not touch a reference count; they are all freed
+            together when the model is destroyed.  This holds while the
+            model is the current one, i.e. until another model is
+            constructed.
+            @note Objects built from these nodes (constraints, objectives,
+            expressions) must not outlive the model.  Nodes built while
+            the model is generated are not placed in the arena, so
+            attaching the model again does not make it grow.
+        */
+        void useArena();
+        /** @brief Captures the generated model as a template for solving
+            it again with other data.
+            Attaches the model if needed and records where each matrix
+            coefficient, right hand side and objective coefficient is in
+            the solver, and which MP_data values and numbers it is the
+            product of.  As long as neither the sets, variables and
+            constraint blocks nor the data read other than as such a
+            factor (e.g. in conditions) change, attach() then only
+            gathers the new values, multiplies them out and passes those
+            which changed to the solver, along with the variable bounds.
+            Otherwise the template is dropped and the model regenerated.
+            @return false, and no template, if some coefficient is not a
+            product of dense MP_data values and numbers such as index
+            values.
+            @note The MP_data must outlive the template.
+        */
+        bool useTemplate();
+        /// returns the number of threads used by attach().
+        int getNumberThreads() const {
+            return numberThreads;
+        }
+
         /// Adds a constrataint block to the model.
         MP_model& add(MP_constraint& c);
 
@@ -178,6 +300,13 @@ namespace flopc {
 
         /// sets the "current objective" to the parameter  o
         void setObjective(const MP_expression& o);
+        /** Sets the direction of the objective written by write(), which
+            minimize() and maximize() set as well.  It is MINIMIZE until
+            set.
+        */
+        void setDirection(MP_direction d) {
+            direction = d;
+        }
 	/** @brief attaches the symantic representation of a model and data to
             a particular OsiSolverInterface
             @note this is called as a part of minimize(), maximize(), and 
@@ -187,8 +316,39 @@ namespace flopc {
             adds them into the OsiSolverInterface.  The OsiSolverInterface may
             be specified at construction time, 
             or as late as the call to attach()
+            <br>
+            If the model is attached to the same solver again and no sets,
+            variables or constraint blocks were added or resized since,
+            only the constraint blocks and the objective which were
+            redefined, or read MP_data that was modified, are regenerated.
+            Their changes are passed to the solver through its row, column
+            and objective modification calls (or, if matrix coefficients
+            changed, by reloading the matrix), keeping the current basis.
+            @note MP_data bound to an external array is always considered
+            modified, as changes to the array cannot be detected.
 	*/
         void attach(OsiSolverInterface *solver=NULL);
+	/** @brief Writes the model to a file in MPS or LP format, without
+            attaching it to a solver.
+            The constraint blocks are generated once, one at a time, and
+            their rows written as they come (LP) or gathered by columns
+            (MPS).  If there are too many coefficients to keep, the MPS
+            writer spills them to temporary files, and reads them back
+            in chunks of a bounded number of coefficients.
+            Rows and columns are named after their block and index
+            values, as in supply(2,0); blocks without a name are called
+            R1, R2, ... and C1, C2, ...  An LP file states the direction
+            of the objective, see setDirection(); MPS files, which have
+            no standard way to state it, give the objective as it is.
+            @param compression as for CoinMpsIO::writeMps: 0 for plain
+            text, 1 for gzip (".gz" is appended to fileName), 2 for bzip2
+            (".bz2"); a plain file is written if the library was built
+            without the compression requested.
+            @return 0 on success, nonzero if the file or a temporary file
+            could not be written
+	*/
+        int write(const std::string& fileName, MP_format format = MPS,
+                  int compression = 0);
 	/** @brief detaches an OsiSolverInterface object from the model.  
             In essence, this will clean up any intermediate storage. A model 
             may then be attached to another solverInterface.
@@ -219,14 +379,38 @@ namespace flopc {
 
         /// Adds a variable to the MP_model.
         void add(MP_variable* v);
-        /// Adds a constraint to the MP_model
+        /// Adds a constraint to the solver as a cut, see addRows().
         void addRow(const Constraint& c); 
+        /** Adds constraints to the solver as cuts, in a single call which
+            keeps the current basis for a warm restart.  Like the rows of
+            addRow() they belong to the solver only, and are dropped by
+            the next attach() that regenerates the model.
+        */
+        void addRows(const std::vector<Constraint>& cuts);
+        /** Adds the rows of an indexed constraint to the solver as cuts,
+            as above.  The constraint becomes a block of this model, so
+            unlike the rows of addRow() its rows are kept by a later
+            attach(), and its price() gives the duals of the rows added.
+        */
+        void addRows(MP_constraint& cuts);
+        /** Appends columns to the solver as new elements of the one
+            dimensional variable v, in a single call which keeps the
+            current basis for a warm restart.  The new elements follow
+            those of the set of v, and v.level() gives their values.
+            Like the rows of addRows() they belong to the solver only.
+            @return the index in v of the first column added.
+        */
+        int addColumns(MP_variable& v, const std::vector<MP_column>& columns);
+        /// Appends a column to the solver, see addColumns().
+        int addColumn(MP_variable& v, const MP_column& column);
 
         /** Can be used to get the default model
             @todo explain the default and current model concepts.
         */
         static MP_model &getDefaultModel();
-        /** Can be used to get the current model
+        /** Can be used to get the current model: the model constructed
+            last by the calling thread, or bound to it by an MP_context,
+            the default model if there is none.
             @todo explain the default and current model concepts.
         */
         static MP_model *getCurrentModel();
@@ -235,30 +419,90 @@ namespace flopc {
         Messenger *getMessenger(){ 
             return messenger;
         }
+        /// returns the profile of the last attach().
+        const GenerationProfile& getGenerationProfile() const {
+            return profile;
+        }
     private:
         typedef std::set<MP_variable* >::iterator varIt;
         typedef std::set<MP_constraint* >::iterator conIt;
         static MP_model& default_model;
-        static MP_model* current_model;
+        /// of the calling thread, 0 for the default model
+        static FLOPCPP_THREAD_LOCAL MP_model* current_model;
         MP_model(const MP_model&);
         MP_model& operator=(const MP_model&);
 
         Messenger* messenger;
+        Arena* arena;
    
     
-        static void assemble(std::vector<Coef>& v, std::vector<Coef>& av);
+        void generate(const std::vector<MP_constraint*>& blocks,
+                      std::vector<std::vector<Coef> >& coefs,
+                      std::vector<size_t>& firstBuffer, int* counts,
+                      std::vector<BlockProfile>* profiles = 0);
+        static void generate(GenerationTask& task, int* counts);
+        static void* generationThread(void* info);
         void add(MP_constraint* c);
+        void addRows(std::vector<Coef>& coefs,
+                     const std::vector<Sense_enum>& senses);
+        void layout();
+        void generate(MP_constraint* block, std::vector<Coef>& coefs,
+                      std::vector<int>* stages = 0,
+                      CoefRecipes* recipes = 0);
+        double writtenInfinity() const;
+        void nameElements(ElementNames& rows, ElementNames& cols);
+        /** Writes the rows and columns in the given orders, if any, and
+            name as the name of the problem.  Returns false if a temporary
+            file could not be written.
+        */
+        bool writeMps(CoinFileOutput& file, const ElementNames& rows,
+                      const ElementNames& cols,
+                      const std::string& name = "",
+                      const std::vector<int>& rowOrder = std::vector<int>(),
+                      const std::vector<int>& colOrder = std::vector<int>());
+        void writeLp(CoinFileOutput& file, const ElementNames& rows,
+                     const ElementNames& cols);
+        bool sameLayout();
+        bool update();
+        /// fills in the totals of the profile and reports it
+        void finishProfile(double time, double wall);
+        bool rebind();
+        void reload(const CoinPackedMatrix& A);
+        bool isModified(const std::vector<const MP_data*>& used) const;
+        bool isModified(const std::vector<const MP_subset_base*>& used) const;
+        void generateObjective(std::vector<Coef>& coefs,
+                               CoefRecipes* recipes = 0,
+                               BlockProfile* profile = 0);
         MP_expression Objective;
+        unsigned long objectiveStamp;
+        std::vector<const MP_data*> objectiveData;
+        std::vector<const MP_subset_base*> objectiveSubsets;
         std::set<MP_constraint *> Constraints;
         std::set<MP_variable *> Variables;
+        /// Solver and block layout as of the last attach()
+        OsiSolverInterface* attachedSolver;
+        unsigned long attachStamp;
+        std::vector<std::pair<int,int> > constraintLayout;
+        std::vector<std::pair<int,int> > variableLayout;
+        GenerationTemplate* generationTemplate;
+        GenerationProfile profile;
+        bool mResolve;
+        int numberThreads;
+        /** whether an MP_stage or MP_stochastic_data was declared for the
+            model, or a constraint over an MP_stage; only then are the
+            stages of the coefficients kept track of.
+        */
+        bool staged;
+        /// the direction of the last solve(), written to LP files
+        MP_direction direction;
     public:
         /// @todo should this be private?
         OsiSolverInterface* Solver; 
     private:
         int m;
         int n;
-        int nz;
-        int *Cst;
+        CoinBigIndex nz;
+        CoinBigIndex *Cst;
         int *Clg;
         int *Rnr;
         double *Elm;
@@ -270,6 +514,75 @@ namespace flopc {
         MP_status mSolverState;
     };
     
+    /** @brief A column to be appended to an attached model by
+        MP_model::addColumns(): its objective coefficient, its bounds and
+        its coefficients in rows of constraint blocks.
+        @ingroup PublicInterface
+    */
+    class MP_column {
+        friend class MP_model;
+    public:
+        /// Bounds default to those of a new MP_variable.
+        MP_column(double o = 0.0, double l = 0.0,
+                  double u = MP_model::getDefaultModel().getInfinity()) :
+            objective(o), lower(l), upper(u) {}
+        /** Adds the coefficient of the column in row (i1,...,i7) of c.
+            Index values are checked against the sets of c as in
+            generation: those of cyclic sets wrap around, a row outside
+            of c is dropped by addColumns() with a message.
+        */
+        MP_column& add(const MP_constraint& c, double value,
+                       int i1=0, int i2=0, int i3=0, int i4=0, int i5=0,
+                       int i6=0, int i7=0) {
+            Entry e = {&c, {i1, i2, i3, i4, i5, i6, i7}, value};
+            entries.push_back(e);
+            return *this;
+        }
+        double objective;
+        double lower;
+        double upper;
+    private:
+        struct Entry {
+            const MP_constraint* constraint;
+            int element[maxDimension];
+            double value;
+        };
+        std::vector<Entry> entries;
+    };
+
+    /** @brief Binds the calling thread to a model while in scope.
+        @ingroup PublicInterface
+        Independent models can be built, attached and solved on several
+        threads at the same time, if each thread does so within an
+        MP_context of its own.  The context reserves a thread slot for the
+        index values and partial results kept while generating, and makes
+        its model the current one of the thread, so that the constraints
+        declared there go to that model.  The previous binding is
+        restored when the context goes out of scope.
+        @note The threads must not share sets, data, variables or
+        constraints; only the empty sets, indices and domains are shared.
+        The number of threads is limited to FLOPCPP_MAX_THREADS, and
+        without --enable-flopcpp-parallel (FLOPCPP_THREAD) to one.  The
+        constructors throw a CoinError if the other contexts and the
+        generation threads hold all the slots.
+    */
+    class MP_context {
+    public:
+        /// binds the thread to the model it constructs next.
+        MP_context();
+        /// binds the thread to m.
+        MP_context(MP_model& m);
+        ~MP_context();
+    private:
+        MP_context(const MP_context&);
+        MP_context& operator=(const MP_context&);
+        void bind();
+        int slot;
+        int previousSlot;
+        MP_model* previousModel;
+        Arena* previousArena;
+    };
+
     /// allows print of result from call to solve();
     std::ostream &operator<<(std::ostream &os, 
                              const MP_model::MP_status &condition);
@@ -17,6 +17,25 @@ namespace flopc {
     MP_set &MP_set::getEmpty() {
 	return Empty;
     }
+
+    MP_stage::MP_stage(int i) : MP_set(i) {
+	MP_model::getCurrentModel()->staged = true;
+    }
+
+    PerThread<std::vector<const MP_subset_base*>*>
+    MP_subset_base::recorded(0);
+    PerThread<unsigned long> MP_subset_base::recording(0);
+
+    void MP_subset_base::startRecording(
+	std::vector<const MP_subset_base*>& used) {
+	recorded() = &used;
+	recording() = Stamped::tick();
+    }
+
+    void MP_subset_base::stopRecording() {
+	recorded() = 0;
+	recording() = 0;
+    }
     
     void MP_set_base::display()const { 
 	//I don't like this hack.  However, until messenger is segregated from the 
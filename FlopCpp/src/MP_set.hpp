@@ -14,6 +14,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <algorithm>
 
 #include "MP_domain.hpp"
 #include "MP_index.hpp"
@@ -115,10 +116,44 @@ private:
     static MP_set Empty;
     int cardinality;
 };
+
+/** Number of index slots of a reference into an object over the sets S
+    which have to be evaluated: trailing indices which are left out
+    always evaluate to 0, which is in any nonempty set.
+    @ingroup INTERNAL_USE
+*/
+inline int usedSlots(const MP_set_base* const* S, const MP_index_exp* const* I) {
+    int n = maxDimension;
+    while (n > 0 && (*I[n-1]).operator->() == 
+	   MP_index_exp::getEmpty().operator->() && S[n-1]->size() > 0) {
+	n--;
+    }
+    return n;
+}
+
+/** Evaluates the first n of the indices I and checks them against the
+    sets S, the others are taken to be 0.
+    @return false if an index is out of bound.
+    @ingroup INTERNAL_USE
+*/
+inline bool evaluateSlots(int n, const MP_set_base* const* S, 
+			  const MP_index_exp* const* I, int* element) {
+    for (int k=0; k<n; k++) {
+	element[k] = S[k]->check((*I[k])->evaluate());
+	if (element[k] == outOfBound) {
+	    return false;
+	}
+    }
+    for (int k=n; k<maxDimension; k++) {
+	element[k] = 0;
+    }
+    return true;
+}
     
 class MP_stage : public MP_set {
 public:
-    MP_stage(int i = 0): MP_set(i) {}
+    /// the current model keeps track of the stages of its coefficients.
+    MP_stage(int i = 0);
     virtual int isStage() const {
 	return 1;
     }
@@ -149,16 +184,54 @@ private:
 
 template <int nbr> class SubsetRef;
 
+/** @brief What the subsets of any dimension have in common: they change
+    as elements are inserted, and the model has to find out which of its
+    constraint blocks read them.
+    @ingroup INTERNAL_USE
+*/
+class MP_subset_base : public MP_set, public Stamped {
+public:
+    MP_subset_base() : recordedIn(0) {}
+
+    /** Starts collecting every subset which is read into used (each at
+	most once), until stopRecording() is called.
+	@note For internal use: MP_model uses this, like
+	MP_data::startRecording(), to find out which constraint blocks
+	depend on which subsets.
+    */
+    static void startRecording(std::vector<const MP_subset_base*>& used);
+    /// Ends a recording started by startRecording()
+    static void stopRecording();
+protected:
+    void noteUse() const {
+	if (recording() != 0 && recordedIn() != recording()) {
+	    recordedIn() = recording();
+	    recorded()->push_back(this);
+	}
+    }
+private:
+    static PerThread<std::vector<const MP_subset_base*>*> recorded;
+    static PerThread<unsigned long> recording;
+    PerThread<unsigned long> recordedIn;
+};
+
 /** @brief Internal representation of a "set" 
     @ingroup INTERNAL_USE
     @note FOR INTERNAL USE: This is not normally used directly by the
     calling code.
     @note this is often implicitly created with many expressions which may
     subset a set.
+    @note The elements are numbered in the order they are inserted, and
+    kept in a flat array.  They are found through an open addressing hash
+    table keyed by their position in the product of the sets, packed into
+    a single integer, so that looking up an element allocates nothing.
+    The subset is traversed in sorted order.  Elements inserted since the
+    last traversal are sorted and merged into that order all at once when
+    the subset is traversed next.
 */
 
 template <int nbr>
-class MP_subset : public MP_set {
+class MP_subset : public MP_subset_base {
     friend class MP_domain_subset<nbr>;
     friend class SubsetRef<nbr>;
 public:
@@ -166,100 +239,325 @@ public:
 	      const MP_set& s2=MP_set::getEmpty(), 
 	      const MP_set& s3=MP_set::getEmpty(), 
 	      const MP_set& s4=MP_set::getEmpty(), 
-	      const MP_set& s5=MP_set::getEmpty()) {
-	S = makeVector<nbr,const MP_set*>(&s1,&s2,&s3,&s4,&s5);
+	      const MP_set& s5=MP_set::getEmpty(), 
+	      const MP_set& s6=MP_set::getEmpty(), 
+	      const MP_set& s7=MP_set::getEmpty()) : unsorted(0), locked(0) {
+	S = makeVector<nbr,const MP_set*>(&s1,&s2,&s3,&s4,&s5,&s6,&s7);
+	initialize();
     }
 	void display(const std::string& s = "") const 
 	{
 // 		Messenger &msgr = *MP_model::getCurrentModel()->getMessenger();
 // 		msgr.logMessage(5,s.c_str());
-// 		std::map<std::vector<int>, int>::const_iterator i;
-// 		for (i = elements.begin(); i != elements.end(); i++) 
+// 		for (int i=0; i<size(); i++) 
 // 		{
 // 			std::stringstream ss;
 // 			for (int j=0; j<nbr; j++) 
 // 			{
-// 				ss<<(*i).first[j]<<"  ";
+// 				ss<<elements[i*nbr+j]<<"  ";
 // 			}
-// 			ss<<(*i).second<<std::ends;
+// 			ss<<i<<std::ends;
 // 			msgr.logMessage(5,ss.str().c_str());
 // 		}
 	}
 
-    MP_subset(std::vector<const MP_set*> s) : S(s) {}
+    MP_subset(std::vector<const MP_set*> s) : S(s), unsorted(0), locked(0) {
+	initialize();
+    }
 
     ~MP_subset() {}
 
-    int operator()(int i1, int i2=0, int i3=0, int i4=0, int i5=0) {
-	std::map<std::vector<int>, int>::const_iterator pos;
-	pos = elements.find(makeVector<nbr>(i1, i2, i3, i4, i5));
-	if (pos==elements.end()) {
-	    return outOfBound;
-	} else {
-	    return pos->second;
-	}
+    int operator()(int i1, int i2=0, int i3=0, int i4=0, int i5=0,
+		   int i6=0, int i7=0) {
+	const int element[maxDimension] = {i1, i2, i3, i4, i5, i6, i7};
+	return find(element);
     }
 
     SubsetRef<nbr>& operator()(const MP_index_exp& i1, 
 			       const MP_index_exp& i2=MP_index::getEmpty(),  
 			       const MP_index_exp& i3=MP_index::getEmpty(),
 			       const MP_index_exp& i4=MP_index::getEmpty(),
-			       const MP_index_exp& i5=MP_index::getEmpty()) {
-	return *new SubsetRef<nbr>(this,i1,i2,i3,i4,i5);
+			       const MP_index_exp& i5=MP_index::getEmpty(),
+			       const MP_index_exp& i6=MP_index::getEmpty(),
+			       const MP_index_exp& i7=MP_index::getEmpty()) {
+	return *new SubsetRef<nbr>(this,i1,i2,i3,i4,i5,i6,i7);
     }
 
-    MP_domain& operator()(const SUBSETREF& s) {
+    MP_domain operator()(const SUBSETREF& s) {
 	return MP_domain(s);
     }
 
     int evaluate(const std::vector<MP_index*>& I) const {
-	std::vector<int> vi;
+	int element[nbr];
 	for (int k=0; k<nbr; k++) {
-	    int temp = I[k]->evaluate();
-	    vi.push_back(temp);
-	}
-	std::map<std::vector<int>, int>::const_iterator pos;
-	pos = elements.find(vi);
-	if (pos==elements.end()) {
-	    return outOfBound;
-	} else {
-	    return pos->second;
+	    element[k] = I[k]->evaluate();
 	}
+	return find(element);
     }
     
     void insert(const std::vector<int> &args) {
-	bool isOk = true;
-	for (int i=0; i<nbr; i++) {
-	    if ( S[i]->check(args[i]) == outOfBound ) {
-		isOk = false;
-	    }
-	}
-	if (isOk == true) {
-	    std::map<std::vector<int>, int>::const_iterator pos;
-	    pos = elements.find(args);
-	    if (pos==elements.end()) {  // insert if not existent
-		const int v = static_cast<int>(elements.size());
-		elements[args] = v;
+	insertElement(&args[0]);
+    }
+    void insert(int i1, int i2=0, int i3=0, int i4=0, int i5=0, int i6=0,
+		int i7=0) {
+	const int element[maxDimension] = {i1, i2, i3, i4, i5, i6, i7};
+	insertElement(element);
+    }
+    /** Inserts number elements at once, the k'th index of element e being
+        ik[e].
+    */
+    void insert(int number, const int* i1, const int* i2=0, const int* i3=0,
+		const int* i4=0, const int* i5=0, const int* i6=0,
+		const int* i7=0) {
+	const int* indices[maxDimension] = {i1, i2, i3, i4, i5, i6, i7};
+	reserve(size()+number);
+	int element[nbr];
+	for (int e=0; e<number; e++) {
+	    for (int k=0; k<nbr; k++) {
+		element[k] = indices[k][e];
 	    }
+	    insertElement(element);
 	}
     }
-    void insert(int i1, int i2=0, int i3=0, int i4=0, int i5=0) {
-	insert(makeVector<nbr>(i1, i2, i3, i4, i5));
-    }
     const InsertFunctor<nbr>& insert(MP_index_exp i1, 
 				     MP_index_exp i2=MP_index_exp::getEmpty(), 
 				     MP_index_exp i3=MP_index_exp::getEmpty(), 
 				     MP_index_exp i4=MP_index_exp::getEmpty(), 
-				     MP_index_exp i5=MP_index_exp::getEmpty()) {
-	return *new InsertFunctor<nbr>(this,makeVector<nbr>(i1, i2, i3, i4, i5));
+				     MP_index_exp i5=MP_index_exp::getEmpty(), 
+				     MP_index_exp i6=MP_index_exp::getEmpty(), 
+				     MP_index_exp i7=MP_index_exp::getEmpty()) {
+	return *new InsertFunctor<nbr>(this,makeVector<nbr>(i1, i2, i3, i4, i5,
+							    i6, i7));
+    }
+    /// makes room for number elements without growing the hash table.
+    void reserve(int number) {
+	elements.reserve(static_cast<size_t>(number)*nbr);
+	order.reserve(number);
+	if (packed == true) {
+	    keys.reserve(number);
+	}
+	size_t slots = 16;
+	while (slots < 2*static_cast<size_t>(number)) {
+	    slots *= 2;
+	}
+	if (slots > table.size()) {
+	    rehash(slots);
+	}
     }
     virtual int size() const {
-	return static_cast<int>(elements.size());
+	noteUse();
+	return static_cast<int>(elements.size()/nbr);
     }
 
 private:
+    /** Keys are the positions in the product of the sets as long as these
+        fit into 63 bits, otherwise the index values are hashed together
+        and elements are compared index by index.  The positions are those
+        for the sizes the sets have now, a set which is itself a subset may
+        grow later on, see insertElement().
+    */
+    void initialize() {
+	packed = true;
+	unsigned long long product = 1;
+	for (int k=nbr-1; k>=0; k--) {
+	    stride[k] = product;
+	    bound[k] = std::max(S[k]->size(),1);
+	    const unsigned long long n = bound[k];
+	    if (product > (1ULL<<63)/n) {
+		packed = false;
+	    }
+	    product *= n;
+	}
+    }
+    /** Takes the keys anew for the present sizes of the sets.  The order
+	of the elements stays the same, as the packed keys order them like
+	their index values.
+    */
+    void repack() {
+	initialize();
+	keys.clear();
+	if (packed == true) {
+	    for (int e=0; e<size(); e++) {
+		keys.push_back(key(&elements[e*nbr]));
+	    }
+	}
+	if (table.empty() == false) {
+	    rehash(table.size());
+	}
+    }
+    unsigned long long key(const int* element) const {
+	unsigned long long k = 0;
+	if (packed == true) {
+	    for (int j=0; j<nbr; j++) {
+		k += stride[j]*element[j];
+	    }
+	} else {
+	    for (int j=0; j<nbr; j++) {
+		k = k*0x9E3779B1ULL + static_cast<unsigned int>(element[j]);
+	    }
+	}
+	return k;
+    }
+    size_t slot(unsigned long long k) const {
+	k ^= k >> 33;
+	k *= 0xFF51AFD7ED558CCDULL;
+	k ^= k >> 33;
+	return static_cast<size_t>(k) & (table.size()-1);
+    }
+    bool matches(int e, unsigned long long k, const int* element) const {
+	if (packed == true) {
+	    return keys[e] == k;
+	}
+	for (int j=0; j<nbr; j++) {
+	    if (elements[e*nbr+j] != element[j]) {
+		return false;
+	    }
+	}
+	return true;
+    }
+    /** Returns the number of element, or outOfBound.  Index values are
+        brought into range as by MP_set_base::check.
+    */
+    int find(const int* args) const {
+	noteUse();
+	int element[nbr];
+	for (int j=0; j<nbr; j++) {
+	    element[j] = S[j]->check(args[j]);
+	    if (element[j] == outOfBound) {
+		return outOfBound;
+	    }
+	    // all elements lie within the bounds, see insertElement()
+	    if (element[j] >= bound[j]) {
+		return outOfBound;
+	    }
+	}
+	if (table.empty() == true) {
+	    return outOfBound;
+	}
+	const unsigned long long k = key(element);
+	for (size_t i=slot(k); table[i]>=0; i=(i+1)&(table.size()-1)) {
+	    if (matches(table[i],k,element) == true) {
+		return table[i];
+	    }
+	}
+	return outOfBound;
+    }
+    void insertElement(const int* args) {
+	int element[nbr];
+	for (int j=0; j<nbr; j++) {
+	    element[j] = S[j]->check(args[j]);
+	    if (element[j] == outOfBound) {
+		return;
+	    }
+	}
+	for (int j=0; j<nbr; j++) {
+	    if (element[j] >= bound[j]) {
+		repack();
+		break;
+	    }
+	}
+	if (2*(size()+1) > static_cast<int>(table.size())) {
+	    rehash(std::max(static_cast<size_t>(16),2*table.size()));
+	}
+	const unsigned long long k = key(element);
+	size_t i = slot(k);
+	for (; table[i]>=0; i=(i+1)&(table.size()-1)) {
+	    if (matches(table[i],k,element) == true) {
+		return;  // insert if not existent
+	    }
+	}
+	table[i] = size();
+	elements.insert(elements.end(),element,element+nbr);
+	if (packed == true) {
+	    keys.push_back(k);
+	}
+	unsorted = 1;
+	touch();
+    }
+    /// orders elements by their index values.
+    class ElementLess {
+    public:
+	ElementLess(const MP_subset* s) : S(s) {}
+	bool operator()(int a, int b) const {
+	    if (S->packed == true) {
+		return S->keys[a] < S->keys[b];
+	    }
+	    return std::lexicographical_compare(
+		&S->elements[a*nbr], &S->elements[a*nbr]+nbr,
+		&S->elements[b*nbr], &S->elements[b*nbr]+nbr);
+	}
+    private:
+	const MP_subset* S;
+    };
+    /** Brings the sorted order up to date before a traversal.  Generation
+	threads may traverse the subset at the same time, the first one
+	sorts.
+    */
+    void sort() const {
+#ifdef FLOPCPP_THREAD
+	if (__sync_fetch_and_add(&unsorted, 0) == 0) {
+	    return;
+	}
+	while (__sync_lock_test_and_set(&locked, 1) != 0) {}
+	if (unsorted != 0) {
+	    sortFrom(static_cast<int>(order.size()));
+	    __sync_lock_release(&unsorted);
+	}
+	__sync_lock_release(&locked);
+#else
+	if (unsorted != 0) {
+	    sortFrom(static_cast<int>(order.size()));
+	    unsorted = 0;
+	}
+#endif
+    }
+    /// adds the elements from first on to the sorted order.
+    void sortFrom(int first) const {
+	const size_t old = order.size();
+	const int number = static_cast<int>(elements.size()/nbr);
+	for (int e=first; e<number; e++) {
+	    order.push_back(e);
+	}
+	ElementLess less(this);
+	std::vector<int>::iterator middle = order.begin()+old;
+	for (std::vector<int>::iterator i=middle; i!=order.end(); i++) {
+	    if (i!=middle && less(*i,*(i-1))) {
+		std::sort(middle,order.end(),less);
+		break;
+	    }
+	}
+	if (middle!=order.begin() && middle!=order.end() && 
+	    less(*middle,*(middle-1))) {
+	    std::inplace_merge(order.begin(),middle,order.end(),less);
+	}
+    }
+    void rehash(size_t slots) {
+	table.assign(slots,-1);
+	for (int e=0; e<size(); e++) {
+	    size_t i = slot(key(&elements[e*nbr]));
+	    while (table[i]>=0) {
+		i = (i+1)&(slots-1);
+	    }
+	    table[i] = e;
+	}
+    }
+
     std::vector<const MP_set*> S; 
-	std::map<std::vector<int>, int> elements;
+    /// the index values of the elements, nbr for each element.
+    std::vector<int> elements;
+    /// the packed keys of the elements, when packed.
+    std::vector<unsigned long long> keys;
+    /// the numbers of the elements in sorted order, see sort().
+    mutable std::vector<int> order;
+    /// whether elements were inserted since the order was last sorted.
+    mutable int unsorted;
+    mutable int locked;
+    /// the hash table: numbers of elements, -1 for an empty slot.
+    std::vector<int> table;
+    unsigned long long stride[nbr];
+    /// the sizes of the sets the strides were taken for.
+    int bound[nbr];
+    bool packed;
 };
 
 /** @brief Internal representation of a "set" 
@@ -281,6 +579,24 @@ private:
 	int evaluate() const {
 	    return 0;
 	}
+	/** For looping over the elements of the subset: gets the indices
+	    of the reference, provided they are all plain indices, and the
+	    sets of the subset.
+	*/
+	virtual bool getIndices(std::vector<MP_index*>& indices,
+				std::vector<const MP_set_base*>& sets) const {
+	    return false;
+	}
+	/// number of elements of the subset referred to.
+	virtual int getSize() const {
+	    return 0;
+	}
+	/** index values of the element at position p in sorted order, as
+	    of the last call of getSize().
+	*/
+	virtual const int* getElement(int p) const {
+	    return 0;
+	}
     };
 
 /** @brief Internal representation of a "set" 
@@ -298,8 +614,10 @@ private:
 		  const MP_index_exp& i2,
 		  const MP_index_exp& i3,
 		  const MP_index_exp& i4,
-		  const MP_index_exp& i5) : 
-	    S(s),I1(i1),I2(i2),I3(i3),I4(i4),I5(i5) {} 
+		  const MP_index_exp& i5,
+		  const MP_index_exp& i6,
+		  const MP_index_exp& i7) : 
+	    S(s),I1(i1),I2(i2),I3(i3),I4(i4),I5(i5),I6(i6),I7(i7) {} 
 	void display()const
 	{
 // 		Messenger &msgr=*MP_model::getCurrentModel()->getMessenger();
@@ -317,14 +635,16 @@ private:
 	    return new MP_domain_subset<nbr>(S,
  		          makeVector<nbr>(I1->getIndex(), I2->getIndex(), 
 					  I3->getIndex(), I4->getIndex(), 
-					  I5->getIndex()) );
+					  I5->getIndex(), I6->getIndex(),
+					  I7->getIndex()) );
 	}
     
 	virtual MP_domain getDomain(MP_set* s) const {
 	    return new MP_domain_subset<nbr>(S,
 	        makeVector<nbr>(I1->getIndex(), I2->getIndex(), 
 				I3->getIndex(), I4->getIndex(), 
-				I5->getIndex()) );
+				I5->getIndex(), I6->getIndex(),
+				I7->getIndex()) );
 	}
 
 	SubsetRef& such_that(const MP_boolean& b) {
@@ -333,26 +653,43 @@ private:
 	}
 
  	int evaluate() const {
-	    std::vector<MP_index_exp> I = makeVector<nbr>(I1,I2,I3,I4,I5);
-	    std::vector<int> vi;
+	    const MP_index_exp* I[maxDimension] =
+		{&I1, &I2, &I3, &I4, &I5, &I6, &I7};
+	    int element[nbr];
 	    for (int k=0; k<nbr; k++) {
-		int temp = I[k]->evaluate();
-		vi.push_back(temp);
-	    }
-	    std::map<std::vector<int>, int>::const_iterator pos;
-	    pos = S->elements.find(vi);
-	    if (pos==S->elements.end()) {
-		return outOfBound;
-	    } else {
-		return pos->second;
+		element[k] = (*I[k])->evaluate();
 	    }
+	    return S->find(element);
 	}
 	MP_index* getIndex() const {
 	    return S;
 	}
+	bool getIndices(std::vector<MP_index*>& indices,
+			std::vector<const MP_set_base*>& sets) const {
+	    const MP_index_exp* I[maxDimension] =
+		{&I1, &I2, &I3, &I4, &I5, &I6, &I7};
+	    indices.clear();
+	    sets.clear();
+	    for (int k=0; k<nbr; k++) {
+		MP_index* index = (*I[k])->getIndex();
+		if (index == 0 || index != (*I[k]).operator->()) {
+		    return false;
+		}
+		indices.push_back(index);
+		sets.push_back(S->S[k]);
+	    }
+	    return true;
+	}
+	int getSize() const {
+	    S->sort();
+	    return S->size();
+	}
+	const int* getElement(int p) const {
+	    return &S->elements[S->order[p]*nbr];
+	}
 	MP_boolean B;
 	MP_subset<nbr>* S;
-	MP_index_exp I1,I2,I3,I4,I5;
+	MP_index_exp I1,I2,I3,I4,I5,I6,I7;
     };
 
 } // End of namespace flopc
@@ -0,0 +1,327 @@
+// ******************** FlopCpp **********************************************
+// File: MP_smps.cpp
+// $Id$
+//****************************************************************************
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include <cassert>
+
+#include <CoinFileIO.hpp>
+#include "MP_smps.hpp"
+#include "MP_set.hpp"
+#include "MP_data.hpp"
+#include "MP_variable.hpp"
+#include "MP_constraint.hpp"
+#include "MP_writer.hpp"
+
+using namespace flopc;
+using namespace std;
+
+namespace {
+    /// The largest index value of element k of a block in an MP_stage set
+    int indexStage(const MP_set_base* const* S, const int* sizes, int rank,
+		   int k) {
+	int stage = 0;
+	for (int j=rank-1; j>=0; j--) {
+	    const int i = k % sizes[j];
+	    k /= sizes[j];
+	    if (S[j]->isStage() && i > stage) {
+		stage = i;
+	    }
+	}
+	return stage;
+    }
+
+    bool readsStochasticData(const vector<const MP_data*>& used) {
+	for (size_t i=0; i<used.size(); i++) {
+	    if (dynamic_cast<const MP_stochastic_data*>(used[i]) != 0) {
+		return true;
+	    }
+	}
+	return false;
+    }
+
+    /** Sorts the rows or columns by stage, keeping their order within a
+	stage: those of stage s are order[first[s]],...,order[first[s+1]-1].
+    */
+    void sortByStage(const vector<int>& stage, int stages,
+		     vector<int>& order, vector<int>& first) {
+	first.assign(stages+1,0);
+	for (size_t i=0; i<stage.size(); i++) {
+	    first[stage[i]+1]++;
+	}
+	for (int s=0; s<stages; s++) {
+	    first[s+1] += first[s];
+	}
+	vector<int> next(first.begin(),first.end()-1);
+	order.resize(stage.size());
+	for (size_t i=0; i<stage.size(); i++) {
+	    order[next[stage[i]]++] = static_cast<int>(i);
+	}
+    }
+
+    /// Sorts and merges coefficients as they are kept by MP_smps
+    void prepare(vector<Coef>& coefs) {
+	std::sort(coefs.begin(),coefs.end(),rowOrder);
+	merge(coefs);
+	// The constant of the objective is not written
+	if (!coefs.empty() && coefs[0].row < 0 && coefs[0].col < 0) {
+	    coefs.erase(coefs.begin());
+	}
+    }
+
+    bool changeBefore(const pair<int,double>& change, int k) {
+	return change.first < k;
+    }
+}
+
+MP_smps::MP_smps(MP_model& md, const string& fileName, int compression) :
+    model(md), rows(new ElementNames), cols(new ElementNames), stoch(0),
+    randomObjective(false), stages(0), status(1) {
+    Messenger* messenger = model.messenger;
+    model.layout();
+    model.nameElements(*rows,*cols);
+    const int m = model.m;
+    const int n = model.n;
+
+    int last = 0;
+    colStage.assign(n,0);
+    for (MP_model::varIt j=model.Variables.begin(); 
+	 j!=model.Variables.end(); j++) {
+	const MP_set_base* S[maxDimension] = {(*j)->S1,(*j)->S2,(*j)->S3,
+					      (*j)->S4,(*j)->S5,(*j)->S6,
+					      (*j)->S7};
+	for (int k=0; k<(*j)->size(); k++) {
+	    const int s = indexStage(S,(*j)->sizes,(*j)->rank,k);
+	    colStage[(*j)->offset+k] = s;
+	    last = std::max(last,s);
+	}
+    }
+    rowStage.assign(m,0);
+    vector<MP_constraint*> blocks(model.Constraints.begin(),
+				  model.Constraints.end());
+    for (size_t b=0; b<blocks.size(); b++) {
+	const MP_set_base* S[maxDimension] = {&blocks[b]->S1,&blocks[b]->S2,
+					      &blocks[b]->S3,&blocks[b]->S4,
+					      &blocks[b]->S5,&blocks[b]->S6,
+					      &blocks[b]->S7};
+	for (int k=0; k<blocks[b]->size(); k++) {
+	    const int s = indexStage(S,blocks[b]->sizes,blocks[b]->rank,k);
+	    rowStage[blocks[b]->offset+k] = s;
+	    last = std::max(last,s);
+	}
+    }
+
+    // Rows are raised to the stages of their columns and coefficients,
+    // the core coefficients of the random blocks are kept.
+    bool random = false;
+    vector<int> coefStage(m,0);
+    vector<Coef> coefs;
+    vector<int> stage;
+    for (size_t b=0; b<blocks.size(); b++) {
+	model.generate(blocks[b],coefs,&stage);
+	for (size_t k=0; k<coefs.size(); k++) {
+	    const int r = coefs[k].row;
+	    if (coefs[k].col >= 0) {
+		rowStage[r] = std::max(rowStage[r],colStage[coefs[k].col]);
+	    }
+	    coefStage[r] = std::max(coefStage[r],stage[k]);
+	}
+	if (readsStochasticData(blocks[b]->dataUsed)) {
+	    random = true;
+	    randomBlocks.push_back(blocks[b]);
+	    firstCoef.push_back(core.size());
+	    prepare(coefs);
+	    core.insert(core.end(),coefs.begin(),coefs.end());
+	}
+    }
+    if (model.Objective.operator->() != 0) {
+	model.generateObjective(coefs);
+	if (readsStochasticData(model.objectiveData)) {
+	    random = true;
+	    randomObjective = true;
+	    firstCoef.push_back(core.size());
+	    prepare(coefs);
+	    core.insert(core.end(),coefs.begin(),coefs.end());
+	}
+    }
+    firstCoef.push_back(core.size());
+    vector<Coef>().swap(coefs);
+    if (random == true && last < 1) {
+	last = 1;
+    }
+    stages = last+1;
+    for (int i=0; i<m; i++) {
+	rowStage[i] = std::max(rowStage[i],std::min(coefStage[i],last));
+    }
+
+    vector<int> rowsByStage;
+    vector<int> colsByStage;
+    vector<int> firstRow;
+    vector<int> firstCol;
+    sortByStage(rowStage,stages,rowsByStage,firstRow);
+    sortByStage(colStage,stages,colsByStage,firstCol);
+    for (int s=0; s<stages; s++) {
+	if (firstRow[s] == firstRow[s+1] || firstCol[s] == firstCol[s+1]) {
+	    ostringstream os;
+	    os<<"FlopCpp: stage "<<s<<" has no rows or no columns";
+	    messenger->logMessage(0,os.str().c_str());
+	    status = 2;
+	    return;
+	}
+    }
+
+    const string problem = fileName.substr(fileName.find_last_of("/\\")+1);
+    string name = fileName+".cor";
+    CoinFileOutput* out = openOutput(name,compression,messenger);
+    if (out == 0) {
+	return;
+    }
+    const bool written =
+	model.writeMps(*out,*rows,*cols,problem,rowsByStage,colsByStage);
+    delete out;
+    if (written == false) {
+	return;
+    }
+
+    name = fileName+".tim";
+    out = openOutput(name,compression,messenger);
+    if (out == 0) {
+	return;
+    }
+    {
+	LineWriter time(*out);
+	time<<"TIME          "<<problem<<"\n";
+	time<<"PERIODS       IMPLICIT\n";
+	for (int s=0; s<stages; s++) {
+	    time<<"    "<<(*cols)(colsByStage[firstCol[s]])<<"  "
+		<<(*rows)(rowsByStage[firstRow[s]])<<"  STAGE"<<s<<"\n";
+	}
+	time<<"ENDATA\n";
+    }
+    delete out;
+
+    name = fileName+".sto";
+    stoch = openOutput(name,compression,messenger);
+    if (stoch == 0) {
+	return;
+    }
+    LineWriter header(*stoch);
+    header<<"STOCH         "<<problem<<"\n";
+    header<<"SCENARIOS     DISCRETE\n";
+    status = 0;
+}
+
+MP_smps::~MP_smps() {
+    if (stoch != 0) {
+	{
+	    LineWriter out(*stoch);
+	    out<<"ENDATA\n";
+	}
+	delete stoch;
+    }
+    delete rows;
+    delete cols;
+}
+
+int MP_smps::stage(const Coef& c) const {
+    return c.row >= 0 ? rowStage[c.row] : colStage[c.col];
+}
+
+double MP_smps::value(int s, size_t k) const {
+    for (; s >= 0; s = parents[s]) {
+	const vector<pair<int,double> >& c = changes[s];
+	vector<pair<int,double> >::const_iterator i = 
+	    std::lower_bound(c.begin(),c.end(),static_cast<int>(k),
+			     changeBefore);
+	if (i != c.end() && i->first == static_cast<int>(k)) {
+	    return i->second;
+	}
+    }
+    return core[k].val;
+}
+
+bool MP_smps::compare(vector<Coef>& coefs, size_t first, size_t last,
+		      int parent, int from,
+		      vector<pair<int,double> >& changed) const {
+    prepare(coefs);
+    size_t i = 0;
+    for (size_t k=first; k<last; k++) {
+	// Coefficients the core lacks can only be zero
+	for (; i<coefs.size() && rowOrder(coefs[i],core[k]); i++) {
+	    if (coefs[i].val != 0.0) {
+		return false;
+	    }
+	}
+	double v = 0.0;
+	if (i<coefs.size() && coefs[i].row==core[k].row && 
+	    coefs[i].col==core[k].col) {
+	    v = coefs[i++].val;
+	}
+	if (stage(core[k]) >= from && v != value(parent,k)) {
+	    changed.push_back(make_pair(static_cast<int>(k),v));
+	}
+    }
+    for (; i<coefs.size(); i++) {
+	if (coefs[i].val != 0.0) {
+	    return false;
+	}
+    }
+    return true;
+}
+
+int MP_smps::addScenario(double probability, int parent, int from) {
+    const int number = getNumberScenarios();
+    if (status != 0 || parent < -1 || parent >= number || 
+	from < 1 || from >= stages) {
+	return -1;
+    }
+    assert(static_cast<int>(rowStage.size()) == model.m &&
+	   static_cast<int>(colStage.size()) == model.n);
+    vector<pair<int,double> > changed;
+    vector<Coef> coefs;
+    const size_t blocks = randomBlocks.size();
+    bool matched = true;
+    for (size_t b=0; b<blocks && matched; b++) {
+	model.generate(randomBlocks[b],coefs);
+	matched = compare(coefs,firstCoef[b],firstCoef[b+1],parent,from,
+			  changed);
+    }
+    if (randomObjective == true && matched == true) {
+	model.generateObjective(coefs);
+	matched = compare(coefs,firstCoef[blocks],firstCoef[blocks+1],
+			  parent,from,changed);
+    }
+    if (matched == false) {
+	model.messenger->logMessage(0,"FlopCpp: scenario has coefficients "
+				    "which are not in the core");
+	return -1;
+    }
+
+    LineWriter out(*stoch);
+    out<<" SC S"<<number+1<<"  ";
+    if (parent < 0) {
+	out<<"ROOT";
+    } else {
+	out<<"S"<<parent+1;
+    }
+    out<<"  "<<probability<<"  STAGE"<<from<<"\n";
+    for (size_t i=0; i<changed.size(); i++) {
+	const Coef& c = core[changed[i].first];
+	const double v = changed[i].second;
+	if (c.col < 0) {
+	    out<<"    RHS  "<<(*rows)(c.row)<<"  "<<-v<<"\n";
+	} else if (c.row < 0) {
+	    out<<"    "<<(*cols)(c.col)<<"  OBJ  "<<v<<"\n";
+	} else {
+	    out<<"    "<<(*cols)(c.col)<<"  "<<(*rows)(c.row)<<"  "<<v<<"\n";
+	}
+    }
+    parents.push_back(parent);
+    changes.push_back(vector<pair<int,double> >());
+    changes.back().swap(changed);
+    return number;
+}
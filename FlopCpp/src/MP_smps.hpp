@@ -0,0 +1,101 @@
+// ******************** FlopCpp **********************************************
+// File: MP_smps.hpp
+// $Id$
+// ****************************************************************************
+
+#ifndef _MP_smps_hpp_
+#define _MP_smps_hpp_
+
+#include <vector>
+#include <string>
+#include <utility>
+#include "MP_model.hpp"
+
+class CoinFileOutput;
+
+namespace flopc {
+
+    /** @brief Writes a stochastic model in SMPS format: the core and time
+        files of its deterministic core, and a stoch file to which its
+        scenarios are appended one at a time.
+        @ingroup PublicInterface
+        The core is the model with the data it has when the MP_smps is
+        constructed, written to fileName.cor as by MP_model::write() but
+        with its rows and columns sorted by stage; fileName.tim gives the
+        first row and column of each stage (STAGE0, STAGE1, ...).  The
+        stage of a column is the largest of its index values in MP_stage
+        sets.  That of a row is the largest of its own such index values,
+        of the stages of its columns and of the stages recorded for its
+        coefficients (see GenerateFunctor::setStages), which also make
+        the model have two stages at least if it reads MP_stochastic_data.
+        <br>
+        A scenario is added by setting the MP_stochastic_data it differs
+        in and calling addScenario().  Only the constraint blocks and the
+        objective which read MP_stochastic_data are generated again, and
+        the coefficients, right hand sides and objective coefficients
+        which differ from those of the parent scenario are appended to
+        fileName.sto.  The deterministic equivalent is never built:
+        besides a block at a time, only the core coefficients of these
+        blocks and the changes made by each scenario are kept.
+        @note Every stage needs rows and columns of its own, so the
+        variables of later stages must be indexed by an MP_stage set.
+        The bounds of the variables are not random.
+        @param compression as for MP_model::write(), for all three files.
+    */
+    class MP_smps {
+    public:
+        MP_smps(MP_model& model, const std::string& fileName,
+                int compression = 0);
+        /// ends and closes the stoch file.
+        ~MP_smps();
+        /// 0 if the core and time files were written, nonzero otherwise.
+        int getStatus() const {
+            return status;
+        }
+        int getNumberStages() const {
+            return stages;
+        }
+        int getNumberScenarios() const {
+            return static_cast<int>(parents.size());
+        }
+        /** Writes the model with the current data as a scenario of the
+            given probability (not conditional on its parent), which is
+            the same as scenario parent, or the core for -1, up to the
+            given stage.
+            @return the number of the scenario, or -1 if it could not be
+            written, e.g. because it has coefficients the core lacks.
+        */
+        int addScenario(double probability, int parent = -1, int stage = 1);
+    private:
+        MP_smps(const MP_smps&);
+        MP_smps& operator=(const MP_smps&);
+        /// stage of a coefficient of the core
+        int stage(const Coef& c) const;
+        /// value of core coefficient k in scenario s
+        double value(int s, size_t k) const;
+        bool compare(std::vector<Coef>& coefs, size_t first, size_t last,
+                     int parent, int stage,
+                     std::vector<std::pair<int,double> >& changes) const;
+
+        MP_model& model;
+        ElementNames* rows;
+        ElementNames* cols;
+        CoinFileOutput* stoch;
+        std::vector<int> rowStage;
+        std::vector<int> colStage;
+        /// the blocks reading MP_stochastic_data, and their core
+        /// coefficients: those of block b start at firstCoef[b], those of
+        /// the objective, if it is random, at firstCoef.back().
+        std::vector<MP_constraint*> randomBlocks;
+        bool randomObjective;
+        std::vector<Coef> core;
+        std::vector<size_t> firstCoef;
+        /// parent and changes of each scenario, sorted by coefficient
+        std::vector<int> parents;
+        std::vector<std::vector<std::pair<int,double> > > changes;
+        int stages;
+        int status;
+    };
+
+} // End of namespace flopc
+#endif
@@ -9,3 +9,117 @@
 #include "MP_utilities.hpp"
 using namespace flopc;
 
+
+unsigned long Stamped::clock = 0;
+
+#ifdef FLOPCPP_THREAD
+__thread int flopc::currentThreadSlot = 0;
+
+namespace {
+    // Slot 0 is shared by the threads which did not reserve one
+    int slotTaken[FLOPCPP_MAX_THREADS] = {1};
+}
+
+int flopc::acquireThreadSlot() {
+    for (int i=1; i<FLOPCPP_MAX_THREADS; i++) {
+	if (__sync_lock_test_and_set(&slotTaken[i], 1) == 0) {
+	    return i;
+	}
+    }
+    return -1;
+}
+
+void flopc::releaseThreadSlot(int slot) {
+    if (slot > 0) {
+	__sync_lock_release(&slotTaken[slot]);
+    }
+}
+#endif
+
+namespace {
+    // Nodes are a few dozen bytes, blocks hold a few thousand of them.
+    const size_t blockSize = 1<<16;
+    const size_t alignment = 16;
+}
+
+FLOPCPP_THREAD_LOCAL Arena* Arena::current_ = 0;
+
+Arena::Arena() : next(0), end(0), locked(0) {}
+
+Arena::~Arena() {
+    if (current_ == this) {
+	current_ = 0;
+    }
+    // Later nodes refer to earlier ones, not the other way round.
+    for (size_t i=nodes.size(); i>0; i--) {
+	nodes[i-1]->~ArenaNode();
+    }
+    for (size_t i=0; i<blocks.size(); i++) {
+	::operator delete(blocks[i].first);
+    }
+}
+
+void Arena::lock() {
+#ifdef FLOPCPP_THREAD
+    while (__sync_lock_test_and_set(&locked, 1) != 0) {}
+#endif
+}
+
+void Arena::unlock() {
+#ifdef FLOPCPP_THREAD
+    __sync_lock_release(&locked);
+#endif
+}
+
+void* Arena::allocate(size_t size) {
+    size = (size + alignment - 1) & ~(alignment - 1);
+    lock();
+    if (next + size > end) {
+	const size_t length = size > blockSize ? size : blockSize;
+	next = static_cast<char*>(::operator new(length));
+	end = next + length;
+	blocks.push_back(std::make_pair(next,end));
+    }
+    void* p = next;
+    next += size;
+    unlock();
+    return p;
+}
+
+bool Arena::contains(const void* p) const {
+    const char* c = static_cast<const char*>(p);
+    // A node is constructed right after it is allocated, so the search
+    // starts with the newest block.
+    for (size_t i=blocks.size(); i>0; i--) {
+	if (c >= blocks[i-1].first && c < blocks[i-1].second) {
+	    return true;
+	}
+    }
+    return false;
+}
+
+bool Arena::adopt(ArenaNode* node) {
+    lock();
+    const bool owned = contains(node);
+    if (owned == true) {
+	nodes.push_back(node);
+    }
+    unlock();
+    return owned;
+}
+
+void* ArenaNode::operator new(size_t size) {
+    if (Arena::current() != 0) {
+	return Arena::current()->allocate(size);
+    } else {
+	return ::operator new(size);
+    }
+}
+
+void ArenaNode::operator delete(void* p) {
+    // Arena memory is only handed back here when a constructor throws,
+    // it is released with the arena.
+    if (Arena::current() == 0 || Arena::current()->contains(p) == false) {
+	::operator delete(p);
+    }
+}
@@ -12,6 +12,22 @@
 #include <string>
 #include <vector>
 
+#include "FlopCppConfig.h"
+
+#ifdef FLOPCPP_THREAD
+# ifndef FLOPCPP_MAX_THREADS
+#  define FLOPCPP_MAX_THREADS 64
+# endif
+# ifndef FLOPCPP_CACHE_LINE
+#  define FLOPCPP_CACHE_LINE 64
+# endif
+# define FLOPCPP_THREAD_LOCAL __thread
+#else
+# undef FLOPCPP_MAX_THREADS
+# define FLOPCPP_MAX_THREADS 1
+# define FLOPCPP_THREAD_LOCAL
+#endif
+
 namespace flopc {
 
     /** @file This file contains several different useful utilities which are
@@ -34,23 +50,21 @@ namespace flopc {
 	Functor& operator=(const Functor&);
     };	
 
+    /** Number of index slots of sets, data, variables and constraints:
+        they are indexed by at most this many sets.
+        @ingroup INTERNAL_USE
+     */
+    const int maxDimension = 7;
+
     /** This template makes a vector of appropriate size out of the
         variable number of arguments.
         @ingroup INTERNAL_USE
      */
     template<int nbr, class T>
-    std::vector<T> makeVector(T i1, T i2=0, T i3=0, T i4=0, T i5=0) {
-	std::vector<T> S(nbr);
-	S[0] = i1; 
-	if (nbr==1) return S;
-	S[1] = i2;
-	if (nbr==2) return S;
-	S[2] = i3;
-	if (nbr==3) return S;
-	S[3] = i4;
-	if (nbr==4) return S;
-	S[4] = i5; 
-	return S;
+    std::vector<T> makeVector(T i1, T i2=0, T i3=0, T i4=0, T i5=0,
+			      T i6=0, T i7=0) {
+	const T all[maxDimension] = {i1, i2, i3, i4, i5, i6, i7};
+	return std::vector<T>(all,all+nbr);
     }
 
     /// return the strictly positive modulus of two integers
@@ -70,21 +84,39 @@ namespace flopc {
     public:
 	int size() const { return size_; }
     protected:
-	RowMajor(int s1, int s2, int s3, int s4, int s5) :
-	    size1(s1), size2(s2), size3(s3), size4(s4), size5(s5),
-	    size_(s1*s2*s3*s4*s5) {}
-	int f(int i1=0, int i2=0, int i3=0, int i4=0, int i5=0) const {
-	    if ( i1==outOfBound || i2==outOfBound || i3==outOfBound ||
-		 i4==outOfBound || i5==outOfBound ) {
-		return outOfBound;
-	    } else {
-		int i = i1;
-		i *= size2; i += i2;  i *= size3; i += i3;
-		i *= size4; i += i4;  i *= size5; i += i5;
-		return i;
-	    } 
+	RowMajor(int s1, int s2, int s3, int s4, int s5, int s6, int s7) :
+	    size_(s1*s2*s3*s4*s5*s6*s7) {
+	    sizes[0] = s1; sizes[1] = s2; sizes[2] = s3; 
+	    sizes[3] = s4; sizes[4] = s5; sizes[5] = s6; sizes[6] = s7;
+	    // Trailing dimensions of size 1 do not move the offset.
+	    rank = maxDimension;
+	    while (rank > 1 && sizes[rank-1] == 1) {
+		rank--;
+	    }
 	}
-	int size1,size2,size3,size4,size5,size_;
+	int f(int i1=0, int i2=0, int i3=0, int i4=0, int i5=0, int i6=0,
+	      int i7=0) const {
+	    const int element[maxDimension] = {i1, i2, i3, i4, i5, i6, i7};
+	    for (int k=0; k<maxDimension; k++) {
+		if (element[k] == outOfBound) {
+		    return outOfBound;
+		}
+	    }
+	    return f(element);
+	}
+	/** Offset of an element given by checked index values, of which
+	    only the first rank are read: the others can only be 0.
+	*/
+	int f(const int* element) const {
+	    int i = element[0];
+	    for (int k=1; k<rank; k++) {
+		i = i*sizes[k] + element[k];
+	    }
+	    return i;
+	}
+	int sizes[maxDimension];
+	int size_;
+	int rank;
     };
 
     /** @brief Utility interface class for adding a string name onto a
@@ -99,8 +131,176 @@ namespace flopc {
 	std::string name;
     };
 
+#ifdef FLOPCPP_THREAD
+    extern __thread int currentThreadSlot;
+    /// returns the slot of the calling thread in PerThread objects.
+    inline int threadSlot() { return currentThreadSlot; }
+    /// sets the slot of the calling thread (0 <= slot < FLOPCPP_MAX_THREADS).
+    inline void setThreadSlot(int slot) { currentThreadSlot = slot; }
+    /** reserves a slot no other thread uses, -1 if all are taken.  Slot
+        0 is that of the threads which never reserved one.
+    */
+    int acquireThreadSlot();
+    /// hands back a slot reserved by acquireThreadSlot().
+    void releaseThreadSlot(int slot);
+    inline void incrementCount(int& c) { __sync_add_and_fetch(&c, 1); }
+    inline int decrementCount(int& c) { return __sync_sub_and_fetch(&c, 1); }
+#else
+    inline int threadSlot() { return 0; }
+    inline void setThreadSlot(int) {}
+    inline int acquireThreadSlot() { return 0; }
+    inline void releaseThreadSlot(int) {}
+    inline void incrementCount(int& c) { ++c; }
+    inline int decrementCount(int& c) { return --c; }
+#endif
+
+    /** @brief Utility class holding one value for each thread generating
+        coefficients.
+        @ingroup INTERNAL_USE
+        Symbolic objects are shared between the threads of
+        MP_model::setNumberThreads, but the state they hold while a
+        domain is traversed (index values, partial sums) is not.  The
+        slots are padded to FLOPCPP_CACHE_LINE bytes, so that threads
+        writing their own values do not contend for a cache line.  Without
+        FLOPCPP_THREAD there is a single slot, unpadded.
+     */
+    template<class T> class PerThread {
+    public:
+	PerThread() {}
+	PerThread(const T& t) {
+	    for (int i=0; i<FLOPCPP_MAX_THREADS; i++) {
+		v[i].value = t;
+	    }
+	}
+	T& operator()() const { return v[threadSlot()].value; }
+	/// sets the value of all threads.
+	void setAll(const T& t) {
+	    for (int i=0; i<FLOPCPP_MAX_THREADS; i++) {
+		v[i].value = t;
+	    }
+	}
+    private:
+	// The values held are a few bytes, so slots a line apart never
+	// share one.
+	struct Slot {
+	    T value;
+#ifdef FLOPCPP_THREAD
+	    char pad[FLOPCPP_CACHE_LINE - sizeof(T)%FLOPCPP_CACHE_LINE];
+#endif
+	};
+	mutable Slot v[FLOPCPP_MAX_THREADS];
+    };
+
+    /** @brief Utility interface class for recording when a structure was
+        last modified.
+        @ingroup INTERNAL_USE
+        Stamps are drawn from a single increasing clock, so comparing a
+        stamp with a value of now() taken earlier tells whether the object
+        was modified in the meantime.
+     */
+    class Stamped {
+    public:
+	unsigned long getStamp() const { return stamp; }
+	/// marks the object as modified.
+	void touch() { stamp = tick(); }
+	/// returns the most recently handed out stamp.
+	static unsigned long now() {
+#ifdef FLOPCPP_THREAD
+	    return __sync_fetch_and_add(&clock, 0);
+#else
+	    return clock;
+#endif
+	}
+	/// hands out a new stamp.
+	static unsigned long tick() {
+#ifdef FLOPCPP_THREAD
+	    return __sync_add_and_fetch(&clock, 1);
+#else
+	    return ++clock;
+#endif
+	}
+    protected:
+	Stamped() : stamp(tick()) {}
+    private:
+	unsigned long stamp;
+	static unsigned long clock;
+    };
+
+    class ArenaNode;
+
+    /** @brief Bump allocator owning the symbolic nodes of a model.
+        @ingroup INTERNAL_USE
+        Nodes constructed while an arena is current are carved out of
+        large blocks and are not reference counted: they are all destroyed
+        together with the arena, in the reverse order of their
+        construction.  Each thread has its own current arena.
+        @see MP_model::useArena()
+     */
+    class Arena {
+    public:
+	Arena();
+	~Arena();
+	/// the arena new nodes are placed in, 0 for the free store.
+	static Arena* current() { return current_; }
+	static void setCurrent(Arena* a) { current_ = a; }
+	/// the number of nodes owned by the arena.
+	size_t size() const { return nodes.size(); }
+	/// the number of blocks the nodes are carved out of.
+	size_t numberBlocks() const { return blocks.size(); }
+	/// makes an arena (or the free store) current while it is in scope.
+	class Scope {
+	public:
+	    Scope(Arena* a) : saved(current_) { current_ = a; }
+	    ~Scope() { current_ = saved; }
+	private:
+	    Arena* saved;
+	};
+    private:
+	friend class ArenaNode;
+	Arena(const Arena&);
+	Arena& operator=(const Arena&);
+	void* allocate(size_t size);
+	bool contains(const void* p) const;
+	bool adopt(ArenaNode* node);
+	void lock();
+	void unlock();
+	/// the first and the one past last byte of each block
+	std::vector<std::pair<char*,char*> > blocks;
+	char* next;
+	char* end;
+	std::vector<ArenaNode*> nodes;
+	int locked;
+	static FLOPCPP_THREAD_LOCAL Arena* current_;
+    };
+
+    /** @brief Base class of the reference counted symbolic nodes, which
+        are placed in the current Arena if there is one.
+        @ingroup INTERNAL_USE
+     */
+    class ArenaNode {
+    public:
+	static void* operator new(size_t size);
+	static void operator delete(void* p);
+	/// whether the node is owned by an arena, handles do not count it.
+	bool inArena() const { return owned; }
+    protected:
+	ArenaNode() : owned(false) { adopt(); }
+	ArenaNode(const ArenaNode&) : owned(false) { adopt(); }
+	ArenaNode& operator=(const ArenaNode&) { return *this; }
+	virtual ~ArenaNode() {}
+    private:
+	void adopt() {
+	    if (Arena::current() != 0) {
+		owned = Arena::current()->adopt(this);
+	    }
+	}
+	friend class Arena;
+	bool owned;
+    };
+
     /** @brief Utility for doing reference counted pointers.
         @ingroup INTERNAL_USE
+        Nodes owned by an Arena are not counted.
      */
     template<class T> class Handle {
     public:
@@ -126,19 +326,15 @@ namespace flopc {
 	}
     protected:
 	void increment() {
-	    if(root != 0) {
-		(root->count)++;
+	    if(root != 0 && root->inArena() == false) {
+		incrementCount(root->count);
 	    }
 	}
 	void decrement() {
-	    if(root != 0) {
-		if(root->count == 1) {
+	    if(root != 0 && root->inArena() == false) {
+		if(decrementCount(root->count) == 0) {
 		    delete root;
 		    root = 0;
-		} else {
-		    ///if(root->count != 0) {
-		    --(root->count);
-		    ///}
 		}
 	    }
 	}
@@ -23,9 +23,16 @@ VariableRef::VariableRef(MP_variable* v,
 			 const MP_index_exp& i2,
 			 const MP_index_exp& i3,
 			 const MP_index_exp& i4,
-			 const MP_index_exp& i5) :
-    V(v),I1(i1),I2(i2),I3(i3),I4(i4),I5(i5) { 
+			 const MP_index_exp& i5,
+			 const MP_index_exp& i6,
+			 const MP_index_exp& i7) :
+    V(v),I1(i1),I2(i2),I3(i3),I4(i4),I5(i5),I6(i6),I7(i7) { 
     offset = v->offset; 
+    const MP_set_base* S[maxDimension] =
+	{V->S1, V->S2, V->S3, V->S4, V->S5, V->S6, V->S7};
+    const MP_index_exp* I[maxDimension] =
+	{&I1, &I2, &I3, &I4, &I5, &I6, &I7};
+    slots = usedSlots(S,I);
 }
 
 double VariableRef::level() const {
@@ -34,26 +41,26 @@ double VariableRef::level() const {
 				V->S2->evaluate(),
 				V->S3->evaluate(),
 				V->S4->evaluate(),
-				V->S5->evaluate())];
+				V->S5->evaluate(),
+				V->S6->evaluate(),
+				V->S7->evaluate())];
 }
 
 int VariableRef::getColumn() const { 
-    int i1 = V->S1->check(I1->evaluate());
-    int i2 = V->S2->check(I2->evaluate());
-    int i3 = V->S3->check(I3->evaluate());
-    int i4 = V->S4->check(I4->evaluate());
-    int i5 = V->S5->check(I5->evaluate());
-    
-    if (i1==outOfBound || i2==outOfBound || i3==outOfBound ||
-	i4==outOfBound || i5==outOfBound) {
+    const MP_set_base* S[maxDimension] =
+	{V->S1, V->S2, V->S3, V->S4, V->S5, V->S6, V->S7};
+    const MP_index_exp* I[maxDimension] =
+	{&I1, &I2, &I3, &I4, &I5, &I6, &I7};
+    int element[maxDimension];
+    if (evaluateSlots(slots,S,I,element) == false) {
 	return outOfBound;
     } else {
-	return V->offset +  V->f(i1,i2,i3,i4,i5);
+	return V->offset +  V->f(element);
     }
 }
 
 void VariableRef::generate(const MP_domain& domain,
-			   vector<Constant > multiplicators,
+			   const vector<Constant>& multiplicators,
 			   GenerateFunctor& f,
 			   double m)  const {
     f.setMultiplicator(multiplicators,m);
@@ -65,11 +72,14 @@ MP_variable::MP_variable(const MP_set_base &s1,
 			 const MP_set_base &s2, 
 			 const MP_set_base &s3,
 			 const MP_set_base &s4, 
-			 const MP_set_base &s5) :
-    RowMajor(s1.size(),s2.size(),s3.size(),s4.size(),s5.size()),
-    upperLimit(MP_data(s1,s2,s3,s4,s5)),
-    lowerLimit(MP_data(s1,s2,s3,s4,s5)),
-    S1(&s1),S2(&s2),S3(&s3),S4(&s4),S5(&s5),
+			 const MP_set_base &s5, 
+			 const MP_set_base &s6, 
+			 const MP_set_base &s7) :
+    RowMajor(s1.size(),s2.size(),s3.size(),s4.size(),s5.size(),s6.size(),
+	     s7.size()),
+    upperLimit(MP_data(s1,s2,s3,s4,s5,s6,s7)),
+    lowerLimit(MP_data(s1,s2,s3,s4,s5,s6,s7)),
+    S1(&s1),S2(&s2),S3(&s3),S4(&s4),S5(&s5),S6(&s6),S7(&s7),
     offset(-1)
 {
     lowerLimit.initialize(0.0);
@@ -77,8 +87,13 @@ MP_variable::MP_variable(const MP_set_base &s1,
     type = continuous;
 }    
 
-double MP_variable::level(int lcl_i1, int lcl_i2, int lcl_i3, int lcl_i4, int lcl_i5) {
-    return M->solution[offset +  f(lcl_i1,lcl_i2,lcl_i3,lcl_i4,lcl_i5)];
+double MP_variable::level(int lcl_i1, int lcl_i2, int lcl_i3, int lcl_i4,
+			  int lcl_i5, int lcl_i6, int lcl_i7) {
+    if (rank==1 && lcl_i1>=size()) {
+	return M->solution[added[lcl_i1-size()]];
+    }
+    return M->solution[offset +  f(lcl_i1,lcl_i2,lcl_i3,lcl_i4,lcl_i5,lcl_i6,
+				   lcl_i7)];
 }
 
 void MP_variable::operator()() const {
@@ -87,18 +102,23 @@ void MP_variable::operator()() const {
     if (S3!=&MP_set::getEmpty()) cout << i3.evaluate() << " ";
     if (S4!=&MP_set::getEmpty()) cout << i4.evaluate() << " ";
     if (S5!=&MP_set::getEmpty()) cout << i5.evaluate() << " ";
+    if (S6!=&MP_set::getEmpty()) cout << i6.evaluate() << " ";
+    if (S7!=&MP_set::getEmpty()) cout << i7.evaluate() << " ";
     cout<<"  "<< M->solution[offset +
 			     f(i1.evaluate(),
 			       i2.evaluate(),
 			       i3.evaluate(),
 			       i4.evaluate(),
-			       i5.evaluate())]<<endl;
+			       i5.evaluate(),
+			       i6.evaluate(),
+			       i7.evaluate())]<<endl;
 }
 
 void MP_variable::display(const std::string &s) {
   cout<<s<<endl;
   if (offset >= 0) {
-    ((*S1)(i1)*(*S2)(i2)*(*S3)(i3)*(*S4)(i4)*(*S5)(i5)).Forall(this);
+    ((*S1)(i1)*(*S2)(i2)*(*S3)(i3)*(*S4)(i4)*(*S5)(i5)*(*S6)(i6)*
+     (*S7)(i7)).Forall(this);
   } else {
     cout<<"No solution available!"<<endl;
   }
@@ -42,7 +42,9 @@ namespace flopc {
 		    const MP_index_exp& i2,
 		    const MP_index_exp& i3,
 		    const MP_index_exp& i4,
-		    const MP_index_exp& i5);
+		    const MP_index_exp& i5,
+		    const MP_index_exp& i6,
+		    const MP_index_exp& i7);
 
 	double level() const;
 
@@ -55,13 +57,18 @@ namespace flopc {
 	int getStage() const { 
 	    return 0;
 	}
+	bool factorize(double& factor, std::vector<DataEntry>& entries) const {
+	    return true;
+	}
 	void generate(const MP_domain& domain,
-		      std::vector<Constant> multiplicators,
+		      const std::vector<Constant>& multiplicators,
 		      GenerateFunctor& f,
 		      double m) const;
 	MP_variable* V;
 	int offset;
-	const MP_index_exp I1,I2,I3,I4,I5;
+	const MP_index_exp I1,I2,I3,I4,I5,I6,I7;
+	/// number of the indices above which getColumn() evaluates.
+	int slots;
     };
 
 
@@ -72,8 +79,11 @@ namespace flopc {
         parametersof construction are MP_set s which specify the indexes
         over which the variable is defined.
     */
-    class MP_variable : public RowMajor, public Functor , public Named{
+    class MP_variable : public RowMajor, public Functor , public Named,
+                        public Stamped {
 	friend class MP_model;
+	friend class MP_benders;
+	friend class MP_smps;
 	friend class DisplayVariable;
 	friend class VariableRef;
     public:
@@ -81,15 +91,21 @@ namespace flopc {
 		    const MP_set_base &s2 = MP_set::getEmpty(), 
 		    const MP_set_base &s3 = MP_set::getEmpty(),
 		    const MP_set_base &s4 = MP_set::getEmpty(), 
-		    const MP_set_base &s5 = MP_set::getEmpty());
+		    const MP_set_base &s5 = MP_set::getEmpty(), 
+		    const MP_set_base &s6 = MP_set::getEmpty(), 
+		    const MP_set_base &s7 = MP_set::getEmpty());
 
         void display(const std::string &s = "");  
 
 	~MP_variable() {
 	}
 
-    /// Returns the value of the variable given the specific index values.
-	double level(int i1=0, int i2=0, int i3=0, int i4=0, int i5=0);
+    /** Returns the value of the variable given the specific index values.
+        Columns appended by MP_model::addColumns() follow the elements of
+        the set of a one dimensional variable.
+    */
+	double level(int i1=0, int i2=0, int i3=0, int i4=0, int i5=0,
+		     int i6=0, int i7=0);
 
     /// Interal use only.
 	const VariableRef& operator()(
@@ -97,9 +113,11 @@ namespace flopc {
 	    const MP_index_exp& d2 = MP_index_exp::getEmpty(), 
 	    const MP_index_exp& d3 = MP_index_exp::getEmpty(),
 	    const MP_index_exp& d4 = MP_index_exp::getEmpty(), 
-	    const MP_index_exp& d5 = MP_index_exp::getEmpty()
+	    const MP_index_exp& d5 = MP_index_exp::getEmpty(), 
+	    const MP_index_exp& d6 = MP_index_exp::getEmpty(), 
+	    const MP_index_exp& d7 = MP_index_exp::getEmpty()
 	    ) {
-	    return *new VariableRef(this, d1, d2, d3, d4, d5);
+	    return *new VariableRef(this, d1, d2, d3, d4, d5, d6, d7);
 	}
     
 	//void display(string s = "");  
@@ -108,11 +126,13 @@ namespace flopc {
 	void binary() { 
 	    upperLimit.initialize(1);
 	    type = discrete; 
+	    touch();
 	}
 
     /// Call this method to turn the MP_variable into an integer variable
 	void integer() { 
 	    type = discrete; 
+	    touch();
 	}
  
     /// Upper bound on the variable value.
@@ -121,12 +141,14 @@ namespace flopc {
 	MP_data lowerLimit;
     private:
 	void operator()() const;
-	const MP_set_base *S1, *S2, *S3, *S4, *S5;
-	MP_index i1,i2,i3,i4,i5;
+	const MP_set_base *S1, *S2, *S3, *S4, *S5, *S6, *S7;
+	MP_index i1,i2,i3,i4,i5,i6,i7;
 
 	MP_model *M;
 	variableType type;
 	int offset;
+	/// solver columns appended by MP_model::addColumns()
+	std::vector<int> added;
     };
 
     /** Specialized subclass of MP_variable where the variable is
@@ -139,8 +161,10 @@ namespace flopc {
 			   const MP_set_base &s2 = MP_set::getEmpty(), 
 			   const MP_set_base &s3 = MP_set::getEmpty(),
 			   const MP_set_base &s4 = MP_set::getEmpty(), 
-			   const MP_set_base &s5 = MP_set::getEmpty()) :
-	    MP_variable(s1,s2,s3,s4,s5) {
+			   const MP_set_base &s5 = MP_set::getEmpty(), 
+			   const MP_set_base &s6 = MP_set::getEmpty(), 
+			   const MP_set_base &s7 = MP_set::getEmpty()) :
+	    MP_variable(s1,s2,s3,s4,s5,s6,s7) {
 	    binary();
 	}
     };
@@ -0,0 +1,179 @@
+// ******************** FlopCpp **********************************************
+// File: MP_writer.hpp
+// $Id$
+// ****************************************************************************
+
+#ifndef _MP_writer_hpp_
+#define _MP_writer_hpp_
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+#include <CoinFileIO.hpp>
+#include "MP_model.hpp"
+
+/* What MP_model::write() and MP_smps share to write their files.  This
+   header is not installed.
+*/
+namespace flopc {
+
+    /// Collects the text of a file being written in blocks, formatting
+    /// numbers in place rather than through temporary strings.
+    class LineWriter {
+    public:
+	LineWriter(CoinFileOutput& o) : out(o), used(0) {}
+	~LineWriter() {
+	    flush();
+	}
+	LineWriter& operator<<(const char* s) {
+	    return append(s,std::strlen(s));
+	}
+	LineWriter& operator<<(const std::string& s) {
+	    return append(s.data(),s.size());
+	}
+	LineWriter& operator<<(int i) {
+	    char digits[16];
+	    char* p = reserve(16);
+	    unsigned int u = i;
+	    if (i < 0) {
+		*p++ = '-';
+		u = 0u-u;
+	    }
+	    int k = 0;
+	    do {
+		digits[k++] = static_cast<char>('0'+u%10);
+		u /= 10;
+	    } while (u > 0);
+	    while (k > 0) {
+		*p++ = digits[--k];
+	    }
+	    used = p-buffer;
+	    return *this;
+	}
+	LineWriter& operator<<(double d) {
+	    if (std::abs(d) < 1e9 && d == static_cast<int>(d)) {
+		return *this<<static_cast<int>(d);
+	    }
+	    used += std::sprintf(reserve(32),"%.15g",d);
+	    return *this;
+	}
+	void flush() {
+	    if (used > 0) {
+		out.write(buffer,static_cast<int>(used));
+		used = 0;
+	    }
+	}
+    private:
+	LineWriter& append(const char* s, size_t size) {
+	    if (size > sizeof(buffer)/2) {
+		flush();
+		out.write(s,static_cast<int>(size));
+	    } else {
+		std::memcpy(reserve(size),s,size);
+		used += size;
+	    }
+	    return *this;
+	}
+	char* reserve(size_t size) {
+	    if (used+size > sizeof(buffer)) {
+		flush();
+	    }
+	    return buffer+used;
+	}
+	CoinFileOutput& out;
+	char buffer[1<<16];
+	size_t used;
+    };
+
+    /** Names the rows or columns of a model after their block and index
+        values, without storing a name for each of them.
+    */
+    class ElementNames {
+    public:
+	/// The name of one row or column, as written by a LineWriter
+	struct Name {
+	    const ElementNames* names;
+	    int i;
+	};
+	void add(const std::string& name, char prefix, int offset, int size,
+		 const int* sizes, int rank) {
+	    Block b;
+	    b.name = name;
+	    if (b.name.empty()) {
+		std::ostringstream os;
+		os<<prefix<<blocks.size()+1;
+		b.name = os.str();
+	    }
+	    b.size = size;
+	    b.rank = rank;
+	    for (int k=0; k<maxDimension; k++) {
+		b.sizes[k] = sizes[k];
+	    }
+	    offsets.push_back(offset);
+	    blocks.push_back(b);
+	}
+	Name operator()(int i) const {
+	    Name name = {this,i};
+	    return name;
+	}
+	void write(LineWriter& out, int i) const {
+	    const size_t k = std::upper_bound(offsets.begin(),offsets.end(),i)
+		- offsets.begin() - 1;
+	    const Block& b = blocks[k];
+	    out<<b.name;
+	    if (b.size == 1 && b.rank == 1 && b.sizes[0] == 1) {
+		return;
+	    }
+	    int element[maxDimension];
+	    int rest = i-offsets[k];
+	    for (int j=b.rank-1; j>=0; j--) {
+		element[j] = rest % b.sizes[j];
+		rest /= b.sizes[j];
+	    }
+	    out<<"(";
+	    for (int j=0; j<b.rank; j++) {
+		if (j>0) {
+		    out<<",";
+		}
+		out<<element[j];
+	    }
+	    out<<")";
+	}
+    private:
+	struct Block {
+	    std::string name;
+	    int size;
+	    int sizes[maxDimension];
+	    int rank;
+	};
+	std::vector<int> offsets;
+	std::vector<Block> blocks;
+    };
+
+    inline LineWriter& operator<<(LineWriter& out,
+				  const ElementNames::Name& name) {
+	name.names->write(out,name.i);
+	return out;
+    }
+
+    /** Opens a file for MP_model::write() and MP_smps, appending the
+	suffix of the compression used to name.  Logs a message and
+	returns 0 if the file cannot be opened.
+    */
+    CoinFileOutput* openOutput(std::string& name, int compression, 
+			       Messenger* messenger);
+
+    /// Orders coefficients by row, then column
+    bool rowOrder(const Coef& a, const Coef& b);
+
+    /// Sums up coefficients of the same row and column, which are next
+    /// to each other once sorted.
+    void merge(std::vector<Coef>& coefs);
+
+} // End of namespace flopc
+#endif
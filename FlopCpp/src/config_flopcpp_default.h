@@ -15,3 +15,7 @@
 
 /* Release Version number of project */
 #define FLOPCPP_VERSION_RELEASE 9999
+
+/* Define to 1 if FlopCpp should generate constraint blocks in parallel
+   (requires pthreads) */
+/* #define FLOPCPP_THREAD 1 */
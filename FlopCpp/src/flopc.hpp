@@ -18,6 +18,8 @@
 #include "MP_expression.hpp"
 #include "MP_boolean.hpp"
 #include "MP_model.hpp"
+#include "MP_benders.hpp"
+#include "MP_smps.hpp"
 
 /** @defgroup PublicInterface Public interface
     @brief Classes in this group are for normal modeling purposes.
@@ -0,0 +1,69 @@
+// $Id$
+// Memory benchmark for repeated generation of the same model.  Each round
+// reassigns the data of the model, part of it through a conditional sum
+// for every element, and attaches the model to a new solver, which makes
+// it generate every constraint block again.  Nothing is kept from one
+// round to the next, so the resident set size should stay flat.
+//
+// Usage: attachMemory [number of rounds] [size of the sets]
+#include <cstdio>
+#include <cstdlib>
+#include "flopc.hpp"
+using namespace flopc;
+using namespace std;
+#include "OsiCbcSolverInterface.hpp"
+#include "CoinTime.hpp"
+
+namespace {
+    // Resident set size in kB, 0 where /proc is not available
+    long residentSize() {
+        long pages = 0;
+        long resident = 0;
+        FILE* statm = fopen("/proc/self/statm","r");
+        if (statm != 0) {
+            if (fscanf(statm,"%ld %ld",&pages,&resident) != 2) {
+                resident = 0;
+            }
+            fclose(statm);
+        }
+        return resident*4;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int rounds = argc>1 ? atoi(argv[1]) : 10;
+    const int size = argc>2 ? atoi(argv[2]) : 300;
+
+    MP_model model(new OsiCbcSolverInterface);
+    model.silent();
+    MP_set s(size), d(size), k(10);
+    MP_data cost(s,d), capacity(s,d), supplies(s), demands(d);
+    MP_variable x(s,d);
+    MP_constraint supply(s), demand(d), limit(s,d);
+    supply(s) = sum(d.such_that(cost(s,d)<size), x(s,d)) <= supplies(s);
+    demand(d) = sum(s.such_that(cost(s,d)<size), x(s,d)) >= demands(d);
+    limit(s,d) = x(s,d) <= capacity(s,d);
+    model.setObjective(sum(s*d, cost(s,d)*x(s,d)));
+
+    long first = 0;
+    for (int r=0; r<rounds; r++) {
+        const double time = CoinCpuTime();
+        cost(s,d) = s + d + r;
+        cost(s,d).such_that(s==d) = 2*size;
+        capacity(s,d) = sum(k.such_that(k<=s), cost(s,d));
+        supplies(s) = size;
+        demands(d) = size/2;
+        MP_expression total = sum((s*d).such_that(cost(s,d)<size),
+                                  cost(s,d));
+        const double level = total->level();
+        model.attach(new OsiCbcSolverInterface);
+        const long rss = residentSize();
+        if (r == 0) {
+            first = rss;
+        }
+        cout<<"round "<<r<<": "<<rss<<" kB resident, "
+            <<"sum "<<level<<", "<<CoinCpuTime()-time<<" s"<<endl;
+    }
+    cout<<"growth after the first round: "<<residentSize()-first<<" kB"<<endl;
+    return 0;
+}
@@ -0,0 +1,89 @@
+// $Id$
+// Memory benchmark for the coefficient buffers filled while generating
+// the constraint blocks of a model.  The same transportation-like model
+// is generated twice: first as a deterministic model, where coefficients
+// are stored without a stage, then with a stage set declared for the
+// model, which makes it keep the stage of every coefficient as well.
+//
+// Usage: coefMemory [number of sources] [number of destinations]
+#include <cstdlib>
+#include "flopc.hpp"
+using namespace flopc;
+using namespace std;
+#include "OsiCbcSolverInterface.hpp"
+#include "CoinTime.hpp"
+
+namespace {
+    struct BufferUse {
+        BufferUse() : coefs(0), bytes(0) {}
+        size_t coefs;
+        size_t bytes;
+    };
+
+    // Adds up the memory held by the coefficient buffers handed to the
+    // messenger after each block is generated.
+    class CountingMessenger : public Messenger {
+    public:
+        CountingMessenger(BufferUse& u) : use(u) {}
+    private:
+        virtual void constraintDebug(string name, const vector<Coef>& cfs) {
+            use.coefs += cfs.size();
+            use.bytes += cfs.capacity()*sizeof(Coef);
+        }
+        virtual void constraintDebug(string name, const vector<Coef>& cfs,
+                                     const vector<int>& stages) {
+            constraintDebug(name,cfs);
+            use.bytes += stages.capacity()*sizeof(int);
+        }
+        BufferUse& use;
+    };
+
+    double generate(int sources, int destinations, bool staged,
+                    BufferUse& use) {
+        MP_model model(new OsiCbcSolverInterface, new CountingMessenger(use));
+        if (staged) {
+            MP_stage T(2);
+        }
+        MP_set s(sources), d(destinations);
+        MP_data cost(s,d), supplies(s), demands(d);
+        cost(s,d) = s + d + 1;
+        supplies(s) = destinations;
+        demands(d) = sources;
+
+        MP_variable x(s,d);
+        MP_constraint supply(s), demand(d), link(s,d);
+        supply(s) = sum(d, x(s,d)) <= supplies(s);
+        demand(d) = sum(s, cost(s,d)*x(s,d)) >= demands(d);
+        link(s,d) = x(s,d) + x(s,d) <= cost(s,d);
+        model.setObjective(sum(s*d, cost(s,d)*x(s,d)));
+
+        const double time = CoinCpuTime();
+        model.attach();
+        return CoinCpuTime()-time;
+    }
+
+    void report(const char* layout, const BufferUse& use, double time) {
+        cout<<layout<<": "<<use.coefs<<" coefficients, "
+            <<use.bytes<<" bytes ("
+            <<static_cast<double>(use.bytes)/use.coefs<<" per coefficient), "
+            <<"generation "<<time<<" s"<<endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int sources = argc>1 ? atoi(argv[1]) : 400;
+    const int destinations = argc>2 ? atoi(argv[2]) : 400;
+
+    BufferUse deterministic;
+    const double time1 = generate(sources,destinations,false,deterministic);
+
+    BufferUse staged;
+    const double time2 = generate(sources,destinations,true,staged);
+
+    cout<<"sizeof(Coef) = "<<sizeof(Coef)<<endl;
+    report("deterministic",deterministic,time1);
+    report("with stages  ",staged,time2);
+    cout<<"saving: "
+        <<100.0*(staged.bytes-deterministic.bytes)/staged.bytes<<"%"<<endl;
+    return 0;
+}
@@ -0,0 +1,108 @@
+// $Id$
+// Builds and solves independent models on as many threads at the same
+// time, each within an MP_context of its own, and checks that they give
+// the same solutions as when they are solved one after the other.
+// Without --enable-flopcpp-parallel (FLOPCPP_THREAD) both runs are
+// serial.
+//
+// Usage: concurrentModels [number of models]
+#include <cstdlib>
+#include "flopc.hpp"
+using namespace flopc;
+using namespace std;
+#include "OsiCbcSolverInterface.hpp"
+#ifdef FLOPCPP_THREAD
+#include <pthread.h>
+#endif
+
+namespace {
+    struct Scenario {
+        int number;
+        double objective;
+        vector<double> flows;
+    };
+
+    // A transportation problem with a fixed charge for opening sources,
+    // whose costs and demands depend on the scenario.
+    void* solve(void* info) {
+        Scenario& scenario = *static_cast<Scenario*>(info);
+        const int r = scenario.number;
+        MP_context context;
+        MP_model model(new OsiCbcSolverInterface);
+        model.silent();
+        model->messageHandler()->setLogLevel(0);
+        MP_set S(6), D(10);
+        MP_data cost(S,D), capacity(S), demand(D);
+        for (int i=0; i<S.size(); i++) {
+            capacity(i) = 30 + 5*((i+r)%3);
+            for (int j=0; j<D.size(); j++) {
+                cost(i,j) = 1 + (7*i + 3*j + r)%11;
+            }
+        }
+        for (int j=0; j<D.size(); j++) {
+            demand(j) = 5 + (j*r)%7;
+        }
+        MP_variable x(S,D);
+        MP_binary_variable open(S);
+        MP_constraint supply(S), fill(D);
+        supply(S) = sum(D, x(S,D)) <= capacity(S)*open(S);
+        fill(D) = sum(S.such_that(cost(S,D)<11), x(S,D)) >= demand(D);
+        model.setObjective(sum(S*D, cost(S,D)*x(S,D)) + sum(S, 20*open(S)));
+        model.minimize();
+
+        scenario.objective = model->getObjValue();
+        for (int i=0; i<S.size(); i++) {
+            for (int j=0; j<D.size(); j++) {
+                scenario.flows.push_back(x.level(i,j));
+            }
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int number = argc>1 ? atoi(argv[1]) : 32;
+
+    vector<Scenario> serial(number);
+    for (int k=0; k<number; k++) {
+        serial[k].number = k;
+        solve(&serial[k]);
+    }
+
+    vector<Scenario> concurrent(number);
+    for (int k=0; k<number; k++) {
+        concurrent[k].number = k;
+    }
+#ifdef FLOPCPP_THREAD
+    vector<pthread_t> threads(number);
+    for (int k=0; k<number; k++) {
+        if (pthread_create(&threads[k],NULL,solve,&concurrent[k])!=0) {
+            cout<<"cannot start thread "<<k<<endl;
+            return 1;
+        }
+    }
+    for (int k=0; k<number; k++) {
+        pthread_join(threads[k],NULL);
+    }
+#else
+    for (int k=0; k<number; k++) {
+        solve(&concurrent[k]);
+    }
+#endif
+
+    int failed = 0;
+    for (int k=0; k<number; k++) {
+        if (concurrent[k].objective!=serial[k].objective ||
+            concurrent[k].flows!=serial[k].flows) {
+            cout<<"model "<<k<<": objective "<<concurrent[k].objective
+                <<" concurrently, "<<serial[k].objective<<" serially"<<endl;
+            failed++;
+        }
+    }
+    if (failed>0) {
+        cout<<failed<<" of "<<number<<" models differ"<<endl;
+        return 1;
+    }
+    cout<<number<<" concurrent models agree with the serial run"<<endl;
+    return 0;
+}
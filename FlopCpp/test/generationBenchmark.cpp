@@ -0,0 +1,245 @@
+// $Id$
+// Benchmark for model generation on synthetic models of a given number of
+// nonzeros (roughly: the sizes of the sets are derived from it).
+//
+//   transport   dense transportation model over two sets
+//   network     flow conservation over the arcs of a sparse MP_subset<2>
+//   lotsizing   multi-period lot sizing with setups and capacities
+//   stochastic  inventory model over an MP_stage with stochastic demands
+//
+// For every model one line of JSON is written to standard output, with
+// the time and allocations taken to construct the model (its sets,
+// subsets, data, variables and constraints), the generation profile of
+// attach() (see GenerationProfile), the number of allocations made by
+// attach() per nonzero and the peak resident set size of the process.  As the peak never goes down, each model should be
+// run in a process of its own when memory is compared; "make benchmark"
+// does so.  Sizes between 10k and 50M nonzeros are meant to be used.
+//
+// Usage: generationBenchmark [model|all] [nonzeros] [threads]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <new>
+#include <sys/resource.h>
+#include "flopc.hpp"
+using namespace flopc;
+using namespace std;
+#include "OsiCbcSolverInterface.hpp"
+#include "CoinTime.hpp"
+
+namespace {
+    size_t allocations = 0;
+
+    // Peak resident set size in kB
+    long peakResidentSize() {
+        rusage usage;
+        if (getrusage(RUSAGE_SELF,&usage) != 0) {
+            return 0;
+        }
+        return usage.ru_maxrss;
+    }
+
+    // Wall time, CPU time and allocations since the start of a phase
+    class Phase {
+    public:
+        Phase() : wall(CoinGetTimeOfDay()), cpu(CoinCpuTime()),
+                  made(allocations) {}
+        double wallTime() const { return CoinGetTimeOfDay()-wall; }
+        double cpuTime() const { return CoinCpuTime()-cpu; }
+        size_t allocated() const { return allocations-made; }
+    private:
+        double wall;
+        double cpu;
+        size_t made;
+    };
+
+    void report(const char* name, MP_model& model,
+                double constructionWall, double constructionCpu,
+                size_t constructionAllocated, size_t allocated) {
+        const GenerationProfile& p = model.getGenerationProfile();
+        printf("{\"model\": \"%s\", \"rows\": %d, \"columns\": %d, "
+               "\"nonzeros\": %ld, \"threads\": %d, "
+               "\"constructionWallTime\": %g, \"constructionCpuTime\": %g, "
+               "\"constructionAllocations\": %lu, "
+               "\"wallTime\": %g, \"cpuTime\": %g, \"generateTime\": %g, "
+               "\"assembleTime\": %g, \"loadTime\": %g, "
+               "\"allocations\": %lu, \"allocationsPerNonzero\": %g, "
+               "\"peakRss\": %ld}\n",
+               name,p.m,p.n,static_cast<long>(p.nz),model.getNumberThreads(),
+               constructionWall,constructionCpu,
+               static_cast<unsigned long>(constructionAllocated),
+               p.wallTime,p.cpuTime,p.generateTime,p.assembleTime,p.loadTime,
+               static_cast<unsigned long>(allocated),
+               p.nz>0 ? static_cast<double>(allocated)/p.nz : 0.0,
+               peakResidentSize());
+        fflush(stdout);
+    }
+
+    // construction is the phase which built the model
+    void attach(const char* name, MP_model& model, const Phase& construction) {
+        const double wall = construction.wallTime();
+        const double cpu = construction.cpuTime();
+        const size_t allocated = construction.allocated();
+        const Phase attaching;
+        model.attach();
+        report(name,model,wall,cpu,allocated,attaching.allocated());
+    }
+
+    // 2*S*D nonzeros
+    void transport(int nonzeros, int threads) {
+        const Phase construction;
+        const int size = std::max(2,static_cast<int>(sqrt(nonzeros/2.0)));
+        MP_model model(new OsiCbcSolverInterface);
+        model.silent();
+        model.setNumberThreads(threads);
+        MP_set s(size), d(size);
+        MP_data cost(s,d), supplies(s), demands(d);
+        cost(s,d) = s + d + 1;
+        supplies(s) = size;
+        demands(d) = size - 1;
+
+        MP_variable x(s,d);
+        MP_constraint supply(s), demand(d);
+        supply(s) = sum(d, x(s,d)) <= supplies(s);
+        demand(d) = sum(s, x(s,d)) >= demands(d);
+        model.setObjective(sum(s*d, cost(s,d)*x(s,d)));
+        attach("transport",model,construction);
+    }
+
+    // 3 nonzeros per arc, with a fixed number of arcs leaving each node
+    void network(int nonzeros, int threads) {
+        const Phase construction;
+        const int degree = 8;
+        const int nodes = std::max(degree+1,nonzeros/(3*degree));
+        MP_model model(new OsiCbcSolverInterface);
+        model.silent();
+        model.setNumberThreads(threads);
+        MP_set N(nodes);
+        MP_subset<2> arcs(N,N);
+        for (int i=0; i<nodes; i++) {
+            for (int k=1; k<=degree; k++) {
+                arcs.insert(i,(i+k*k*7919)%nodes);
+            }
+        }
+        MP_data supplies(N), capacity(arcs), cost(arcs);
+        supplies(N) = 0;
+        supplies(0) = degree;
+        supplies(nodes-1) = -degree;
+        for (int a=0; a<arcs.size(); a++) {
+            capacity(a) = 1 + a % 5;
+            cost(a) = 1 + a % 3;
+        }
+
+        MP_index i, j;
+        MP_variable flow(arcs);
+        MP_constraint balance(N), limit(arcs);
+        balance(N) = sum(arcs(N,j), flow(arcs(N,j))) -
+            sum(arcs(i,N), flow(arcs(i,N))) == supplies(N);
+        limit(arcs(i,j)) = flow(arcs(i,j)) <= capacity(arcs(i,j));
+        model.setObjective(sum(arcs(i,j), cost(arcs(i,j))*flow(arcs(i,j))));
+        attach("network",model,construction);
+    }
+
+    // 7 nonzeros per product and period
+    void lotsizing(int nonzeros, int threads) {
+        const Phase construction;
+        const int periods = 24;
+        const int products = std::max(1,nonzeros/(7*periods));
+        MP_model model(new OsiCbcSolverInterface);
+        model.silent();
+        model.setNumberThreads(threads);
+        MP_set p(products), t(periods);
+        MP_data demand(p,t), use(p), setupTime(p), bigM(p), hold(p),
+            setupCost(p), capacity(t);
+        demand(p,t) = p + t;
+        use(p) = 1;
+        setupTime(p) = 2;
+        bigM(p) = 2*(products+periods);
+        hold(p) = 1;
+        setupCost(p) = 10;
+        capacity(t) = 2*products*(products+periods);
+
+        MP_variable produce(p,t), stock(p,t);
+        MP_binary_variable setup(p,t);
+        MP_constraint balance(p,t), link(p,t), limit(t);
+        balance(p,t) = stock(p,t-1) + produce(p,t) - stock(p,t) == demand(p,t);
+        link(p,t) = produce(p,t) <= bigM(p)*setup(p,t);
+        limit(t) = sum(p, use(p)*produce(p,t) + setupTime(p)*setup(p,t)) <=
+            capacity(t);
+        model.setObjective(sum(p*t, hold(p)*stock(p,t) +
+                               setupCost(p)*setup(p,t)));
+        attach("lotsizing",model,construction);
+    }
+
+    // 4 nonzeros per stage and item, every coefficient tagged with a stage
+    void stochastic(int nonzeros, int threads) {
+        const Phase construction;
+        const int stages = 4;
+        const int items = std::max(1,nonzeros/(4*stages));
+        MP_model model(new OsiCbcSolverInterface);
+        model.silent();
+        model.setNumberThreads(threads);
+        MP_stage T(stages);
+        MP_set i(items);
+        MP_stochastic_data demand(T,i);
+        MP_data cost(i), budget(T);
+        demand(T,i) = T + 1;
+        cost(i) = i + 1;
+        budget(T) = items*items;
+
+        MP_variable buy(T,i), store(T,i);
+        MP_constraint balance(T,i), spend(T);
+        balance(T,i) = store(T-1,i) + buy(T,i) - store(T,i) == demand(T,i);
+        spend(T) = sum(i, cost(i)*buy(T,i)) <= budget(T);
+        model.setObjective(sum(T*i, cost(i)*buy(T,i) + store(T,i)));
+        attach("stochastic",model,construction);
+    }
+}
+
+// Counts the allocations of the whole program
+void* operator new(size_t size) {
+#ifdef FLOPCPP_THREAD
+    __sync_fetch_and_add(&allocations,1);
+#else
+    allocations++;
+#endif
+    void* p = malloc(size>0 ? size : 1);
+    if (p == 0) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) throw() {
+    free(p);
+}
+
+int main(int argc, char** argv) {
+    const char* model = argc>1 ? argv[1] : "all";
+    const int nonzeros = argc>2 ? atoi(argv[2]) : 10000;
+    const int threads = argc>3 ? atoi(argv[3]) : 1;
+    const bool all = strcmp(model,"all")==0;
+    bool known = all;
+    if (all || strcmp(model,"transport")==0) {
+        transport(nonzeros,threads);
+        known = true;
+    }
+    if (all || strcmp(model,"network")==0) {
+        network(nonzeros,threads);
+        known = true;
+    }
+    if (all || strcmp(model,"lotsizing")==0) {
+        lotsizing(nonzeros,threads);
+        known = true;
+    }
+    if (all || strcmp(model,"stochastic")==0) {
+        stochastic(nonzeros,threads);
+        known = true;
+    }
+    if (known == false) {
+        fprintf(stderr,"unknown model %s\n",model);
+        return 1;
+    }
+    return 0;
+}
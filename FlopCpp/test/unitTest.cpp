@@ -4,6 +4,7 @@ using namespace flopc;
 using namespace std;
 #include "OsiCbcSolverInterface.hpp"
 #include "CoinFloatEqual.hpp"
+#include <sstream>
 
 
 namespace Aircraft {
@@ -166,6 +167,313 @@ int main() {
 
     y.display("y second model");
   }
+
+  /* Re-solving after modifying data regenerates only the parts of the
+     model depending on it.  The result must be the same as for a model
+     generated from scratch.
+  */
+  {
+    MP_model m3(new OsiCbcSolverInterface);
+    MP_set s(2), d(3);
+    MP_data supplies(s), demands(d), cost(s,d), yield(s,d);
+    supplies(0) = 350; supplies(1) = 600;
+    demands(0) = 325;  demands(1) = 300;  demands(2) = 275;
+    cost(0,0) = 2.5; cost(0,1) = 1.7; cost(0,2) = 1.8;
+    cost(1,0) = 2.5; cost(1,1) = 1.8; cost(1,2) = 1.4;
+    yield(s,d) = 1.0;
+
+    MP_variable x(s,d);
+    MP_constraint supply(s), demand(d);
+    supply(s) = sum(d, x(s,d)) <= supplies(s);
+    demand(d) = sum(s, yield(s,d)*x(s,d)) >= demands(d);
+
+    m3.minimize(sum(s*d, cost(s,d)*x(s,d)));
+    assert(m3->getObjValue()>=1707.49 && m3->getObjValue()<=1707.51);
+
+    demands(1) = 250;   // right hand side only
+    yield(0,2) = 0.9;   // a matrix coefficient
+    cost(1,1) = 1.6;    // an objective coefficient
+    x.upperLimit(0,0) = 300;
+    m3.minimize();
+
+    // Only the demand block and the objective were generated again
+    const GenerationProfile& p3 = m3.getGenerationProfile();
+    assert(p3.kind=="update" && p3.blocks.size()==1);
+    assert(p3.blocks[0].coefficients==9 && p3.objective.coefficients==6);
+    assert(p3.cpuTime>=0 && p3.wallTime>=p3.generateTime);
+    ostringstream json;
+    p3.writeJson(json);
+    assert(json.str().find("\"kind\": \"update\"")!=string::npos);
+
+    MP_model m4(new OsiCbcSolverInterface);
+    m4.add(supply).add(demand);
+    m4.minimize(sum(s*d, cost(s,d)*x(s,d)));
+
+    assert(m3->getNumElements()==m4->getNumElements());
+    CoinRelFltEq eq(1.e-05);
+#ifndef NDEBUG
+    double m3ObjValue=m3->getObjValue();
+    double m4ObjValue=m4->getObjValue();
+#endif
+    assert( eq(m3ObjValue,m4ObjValue) );
+  }
+  /* A constraint summing over a subset is generated again once the
+     subset has grown.
+  */
+  {
+    MP_model m5(new OsiCbcSolverInterface);
+    MP_set S(2), D(2);
+    MP_subset<2> Link(S,D);
+    Link.insert(0,0);
+    MP_variable x(S,D);
+    MP_constraint cover(S);
+    cover(S) = sum(Link(S,D), x(S,D)) >= 1;
+    m5.add(cover);
+    m5.minimize(sum(S*D, x(S,D)));
+    assert(m5->getNumElements()==1);
+    Link.insert(1,1);
+    m5.minimize(sum(S*D, x(S,D)));
+    assert(m5->getNumElements()==2);
+    assert(m5->getObjValue()>=1.99 && m5->getObjValue()<=2.01);
+  }
+
+  /* Generating the constraint blocks with several threads must give the
+     same matrix as generating them one after the other.
+  */
+  {
+    MP_model m6(new OsiCbcSolverInterface);
+    m6.setNumberThreads(4);
+    MP_set i(40), j(30);
+    MP_data a(i,j);
+    a(i,j) = i + j;
+
+    MP_variable x(i,j);
+    MP_constraint rows(i), cols(j);
+    rows(i) = sum(j, a(i,j)*x(i,j)) + sum(j, x(i,j)) <= 100;
+    cols(j) = sum(i.such_that(i>=j), x(i,j)) >= 1;
+    m6.setObjective(sum(i*j, x(i,j)));
+    m6.attach();
+
+    MP_model m7(new OsiCbcSolverInterface);
+    m7.add(rows).add(cols);
+    m7.setObjective(sum(i*j, x(i,j)));
+    m7.attach();
+
+    const CoinPackedMatrix* A6 = m6->getMatrixByCol();
+    const CoinPackedMatrix* A7 = m7->getMatrixByCol();
+    assert(A6->getNumElements()==A7->getNumElements());
+    for (int k=0; k<A6->getNumCols(); k++) {
+      assert(A6->getVectorStarts()[k]==A7->getVectorStarts()[k]);
+      assert(A6->getVectorLengths()[k]==A7->getVectorLengths()[k]);
+      for (int e=A6->getVectorStarts()[k];
+           e<A6->getVectorStarts()[k]+A6->getVectorLengths()[k]; e++) {
+        assert(A6->getIndices()[e]==A7->getIndices()[e]);
+        assert(A6->getElements()[e]==A7->getElements()[e]);
+      }
+    }
+    // The profiles add up the slices of the blocks
+    const GenerationProfile& p6 = m6.getGenerationProfile();
+    const GenerationProfile& p7 = m7.getGenerationProfile();
+    assert(p6.blocks.size()==2 && p7.blocks.size()==2);
+    assert(p6.nz==A6->getNumElements());
+    for (size_t b=0; b<p6.blocks.size(); b++) {
+      assert(p6.blocks[b].rows==p7.blocks[b].rows);
+      assert(p6.blocks[b].iterations==p7.blocks[b].iterations);
+      assert(p6.blocks[b].coefficients==p7.blocks[b].coefficients);
+      assert(p6.blocks[b].iterations>=p6.blocks[b].coefficients);
+    }
+    for (int k=0; k<m6->getNumRows(); k++) {
+      assert(m6->getRowLower()[k]==m7->getRowLower()[k]);
+      assert(m6->getRowUpper()[k]==m7->getRowUpper()[k]);
+    }
+  }
+  /* A domain which is the product of a subset and a set can be used in
+     several constraints and in the objective.
+  */
+  {
+    MP_model m8(new OsiCbcSolverInterface);
+    MP_set S(2), D(2), P(3);
+    MP_subset<2> Link(S,D);
+    Link.insert(0,0); Link.insert(1,1);
+    MP_variable x(S,D,P);
+    MP_domain dom = Link(S,D)*P;
+    MP_constraint lower, upper;
+    lower = sum(dom, x(S,D,P)) >= 1;
+    upper = sum(dom, 2*x(S,D,P)) <= 10;
+    m8.add(lower).add(upper);
+    m8.minimize(sum(dom, x(S,D,P)));
+    assert(m8->getNumRows()==2);
+    assert(m8->getNumCols()==12);
+    assert(m8->getNumElements()==12);
+    assert(m8->getObjValue()>=0.99 && m8->getObjValue()<=1.01);
+  }
+  /* Sets, data, variables and constraints with seven indices.
+  */
+  {
+    MP_model m9(new OsiCbcSolverInterface);
+    MP_set A(2), B(2), C(2), D(2), E(2), F(2), G(3);
+    MP_index a, b, c, d, e, f, g;
+    MP_data cost(A,B,C,D,E,F,G);
+    cost(A,B,C,D,E,F,G) = 1;
+    cost(1,1,1,1,1,1,2) = 0.5;
+    MP_subset<7> arcs(A,B,C,D,E,F,G);
+    arcs.insert(0,0,0,0,0,0,1);
+    arcs.insert(1,1,1,1,1,1,2);
+    arcs.insert(1,0,1,0,1,0,0);
+    MP_variable x(A,B,C,D,E,F,G);
+    MP_constraint pick(G);
+    pick(g) = sum(arcs(a,b,c,d,e,f,g), x(a,b,c,d,e,f,g)) >= 1;
+    m9.add(pick);
+    m9.minimize(sum(A*B*C*D*E*F*G, cost(A,B,C,D,E,F,G)*x(A,B,C,D,E,F,G)));
+    assert(m9->getNumRows()==3);
+    assert(m9->getNumCols()==192);
+    assert(m9->getNumElements()==3);
+    assert(m9->getObjValue()>=2.49 && m9->getObjValue()<=2.51);
+    assert(x.level(1,1,1,1,1,1,2)>=0.99 && x.level(1,0,1,0,1,0,0)>=0.99);
+    assert(x.level(1,1,1,1,1,1,1)<=0.01);
+  }
+  /* Coefficients of a column appended to a model only go into rows of
+     their constraint.
+  */
+  {
+    MP_model m10(new OsiCbcSolverInterface);
+    MP_set S(3), D(4);
+    MP_variable x(S,D), y(S);
+    MP_constraint demand(S,D);
+    demand(S,D) = x(S,D) + y(S) >= 1;
+    m10.add(demand);
+    m10.minimize(sum(S*D, x(S,D)) + sum(S, 3*y(S)));
+    const int rows = m10->getNumRows();
+    const int nz = m10->getNumElements();
+    MP_set P(1);
+    MP_variable z(P);
+    MP_column column(1.0);
+    column.add(demand, 7.0, 0, 5);   // out of range
+    column.add(demand, 2.0, 2, 3);
+    m10.addColumn(z, column);
+    assert(m10->getNumRows()==rows);
+    assert(m10->getNumElements()==nz+1);
+    const CoinPackedMatrix* A10 = m10->getMatrixByCol();
+    const int last = A10->getNumCols()-1;
+    assert(A10->getVectorLengths()[last]==1);
+    assert(A10->getIndices()[A10->getVectorStarts()[last]]==
+           demand.offset+11);
+    assert(A10->getElements()[A10->getVectorStarts()[last]]==2.0);
+  }
+
+  /* A model solved again through its template must give the same as a
+     model generated from scratch, also once a condition on the data
+     changes and the template is dropped.
+  */
+  {
+    MP_model m11(new OsiCbcSolverInterface);
+    MP_set s(2), d(3);
+    MP_data supplies(s), demands(d), cost(s,d), yield(s,d), open(s);
+    supplies(0) = 350; supplies(1) = 600;
+    demands(0) = 325;  demands(1) = 300;  demands(2) = 275;
+    cost(0,0) = 2.5; cost(0,1) = 1.7; cost(0,2) = 1.8;
+    cost(1,0) = 2.5; cost(1,1) = 1.8; cost(1,2) = 1.4;
+    yield(s,d) = 1.0;
+    open(s) = 1;
+
+    MP_variable x(s,d);
+    MP_constraint supply(s), demand(d);
+    supply(s) = sum(d.such_that(open(s)>0), x(s,d)) <= supplies(s);
+    demand(d) = sum(s, 2*yield(s,d)*x(s,d)) >= 2*demands(d);
+
+    m11.setObjective(sum(s*d, cost(s,d)*x(s,d)));
+    const bool captured = m11.useTemplate();
+    assert(captured==true);
+    m11.minimize();
+    assert(m11->getObjValue()>=1707.49 && m11->getObjValue()<=1707.51);
+
+    CoinRelFltEq eq(1.e-05);
+    for (int round=0; round<2; round++) {
+      if (round==0) {
+        demands(1) = 250;   // right hand side only
+        yield(0,2) = 0.9;   // a matrix coefficient
+        cost(1,1) = 1.6;    // an objective coefficient
+        x.upperLimit(0,0) = 300;
+      } else {
+        open(1) = 0;        // drops the template
+        supplies(0) = 1000;
+      }
+      m11.minimize();
+
+      MP_model m12(new OsiCbcSolverInterface);
+      m12.add(supply).add(demand);
+      m12.minimize(sum(s*d, cost(s,d)*x(s,d)));
+
+      const CoinPackedMatrix* A11 = m11->getMatrixByCol();
+      const CoinPackedMatrix* A12 = m12->getMatrixByCol();
+      assert(A11->getNumElements()==A12->getNumElements());
+      for (int k=0; k<A11->getNumCols(); k++) {
+        for (int e=A11->getVectorStarts()[k];
+             e<A11->getVectorStarts()[k]+A11->getVectorLengths()[k]; e++) {
+          assert(A11->getIndices()[e]==A12->getIndices()[e]);
+          assert(A11->getElements()[e]==A12->getElements()[e]);
+        }
+      }
+#ifndef NDEBUG
+      double m11ObjValue=m11->getObjValue();
+      double m12ObjValue=m12->getObjValue();
+#endif
+      assert( eq(m11ObjValue,m12ObjValue) );
+    }
+  }
+  /* Regenerating the blocks whose data changed leaves the arena of the
+     model as it is.
+  */
+  {
+    MP_model m13(new OsiCbcSolverInterface);
+    m13.useArena();
+    Arena* arena = Arena::current();
+    MP_set s(3), d(4);
+    MP_data demands(d);
+    demands(d) = d + 1;
+    MP_variable x(s,d);
+    MP_constraint supply(s), demand(d);
+    supply(s) = sum(d, x(s,d)) <= 10;
+    demand(d) = sum(s, x(s,d)) >= demands(d);
+    m13.setObjective(sum(s*d, (s+d+1)*x(s,d)));
+    m13.attach();
+    const size_t nodes = arena->size();
+    const size_t blocks = arena->numberBlocks();
+    for (int k=0; k<2000; k++) {
+      demands(k%4) = k%7;
+      m13.attach();
+    }
+    assert(arena->size()==nodes);
+    assert(arena->numberBlocks()==blocks);
+    assert(m13->getRowLower()[demand.offset+3]==1999%7);
+  }
+  /* Rows added from a constraint stay in the model: solving again, also
+     after a change which regenerates the model, keeps them.
+  */
+  {
+    MP_model m14(new OsiCbcSolverInterface);
+    MP_set s(3);
+    MP_variable x(s);
+    MP_constraint total;
+    total = sum(s, x(s)) >= 3;
+    m14.add(total);
+    m14.minimize(sum(s, (s+1)*x(s)));
+    assert(m14->getObjValue()>=2.99 && m14->getObjValue()<=3.01);
+    const int rows = m14->getNumRows();
+    MP_constraint cap(s);
+    cap(s) = x(s) <= 1;
+    m14.addRows(cap);
+    m14.minimize();
+    assert(m14->getNumRows()==rows+3);
+    assert(m14->getObjValue()>=5.99 && m14->getObjValue()<=6.01);
+    MP_constraint bound;
+    bound = sum(s, x(s)) <= 100;
+    m14.add(bound);
+    m14.minimize();
+    assert(m14->getNumRows()==rows+4);
+    assert(m14->getObjValue()>=5.99 && m14->getObjValue()<=6.01);
+    assert(m14->getRowUpper()[cap.offset+2]==1);
+  }
   cout<<"All tests completed successfully"<<endl;
 
 }
@@ -0,0 +1,52 @@
+#include <cstdio>
+#include "flopc.hpp"
+#include "CoinMpsIO.hpp"
+#include "TestItem.hpp"
+
+using namespace flopc;
+
+bool arenaTest() {
+    TestItem *ti = new TestItem("flopc:arenaTest");
+    {
+        MP_model model(0);
+        model.silent();
+        model.useArena();
+        MP_set s(3), d(4);
+        MP_data cost(s,d);
+        cost(s,d) = s + d + 1;
+        MP_variable x(s,d);
+        MP_constraint supply(s), demand(d);
+        supply(s) = sum(d, x(s,d)) <= 10;
+        demand(d) = sum(s, cost(s,d)*x(s,d)) >= 2;
+        MP_expression objective = sum(s*d, cost(s,d)*x(s,d));
+        model.setObjective(objective);
+
+        // nodes go to the arena, indices and sets stay with the user
+        MP_index i;
+        if(objective->inArena()!=true || i.inArena()!=false ||
+           s.inArena()!=false)
+        {ti->failItem(__SPOT__); return false; }
+        MP_expression copy = objective;
+        if(copy.operator->()!=objective.operator->())
+        {ti->failItem(__SPOT__); return false; }
+
+        const char* mpsFile = "arenaTest.mps";
+        if(model.write(mpsFile)!=0)
+        {ti->failItem(__SPOT__); return false; }
+        CoinMpsIO mps;
+        mps.messageHandler()->setLogLevel(0);
+        if(mps.readMps(mpsFile,"")!=0)
+        {ti->failItem(__SPOT__); return false; }
+        std::remove(mpsFile);
+        if(mps.getNumRows()!=7 || mps.getNumCols()!=12 ||
+           mps.getNumElements()!=24)
+        {ti->failItem(__SPOT__); return false; }
+    }
+    // the arena went with the model
+    MP_expression later = MP_expression(Constant(1.0));
+    if(later->inArena()!=false)
+    {ti->failItem(__SPOT__); return false; }
+
+    ti->passItem();
+    return true;
+}
@@ -80,6 +80,29 @@ bool booleanTest()
 
 
 
+    // test splitting a conjunction, and finding the subset membership in it
+    flopc::MP_subset<2> mySubset(mySet,mySet);
+    mySubset.insert(0,1);
+    flopc::MP_index j;
+    flopc::MP_boolean b15(flopc::Constant(3)<=flopc::Constant(4));
+    flopc::MP_boolean b16 = b15 && (mySubset(i,j) && !b15);
+    std::vector<const flopc::Boolean_base*> parts;
+    b16->conjuncts(parts);
+    if(parts.size()!=3 || parts[0]!=b15.operator->())
+    {ti->failItem(__SPOT__);return false;}
+    if(parts[0]->membership()!=0 || parts[1]->membership()==0 ||
+       parts[2]->membership()!=0)
+    {ti->failItem(__SPOT__);return false;}
+    std::vector<flopc::MP_index*> indices;
+    std::vector<const flopc::MP_set_base*> sets;
+    if(parts[1]->membership()->getIndices(indices,sets)!=true ||
+       indices.size()!=2 || indices[0]!=&i || indices[1]!=&j ||
+       sets[1]!=&mySet)
+    {ti->failItem(__SPOT__);return false;}
+    if(parts[1]->membership()->getSize()!=1 ||
+       parts[1]->membership()->getElement(0)[1]!=1)
+    {ti->failItem(__SPOT__);return false;}
+
     /** @TODO finish out these tests.
     MP_boolean operator<=(const MP_index_exp& e1, const MP_index_exp& e2) {
 	return new Boolean_lessEq(e1, e2);
@@ -0,0 +1,58 @@
+#include <cstdio>
+#include "MP_set.hpp"
+#include "MP_data.hpp"
+#include "TestItem.hpp"
+
+using namespace flopc;
+
+bool dataTest() {
+    TestItem *ti = new TestItem("flopc:dataTest");
+    MP_set s(4), t(5);
+
+    // sparse data over columns of index values, sorted in row-major order
+    int i1[] = {0, 1, 1, 3};
+    int i2[] = {2, 0, 4, 1};
+    double values[] = {1.5, 2.5, 3.5, 4.5};
+    const int* indices[] = {i1, i2};
+    MP_data sorted(4,values,indices,s,t);
+    if(sorted.entries()!=4)
+    {ti->failItem(__SPOT__); return false; }
+    if(sorted(1,4)!=3.5 || sorted(3,1)!=4.5 || sorted(0,2)!=1.5)
+    {ti->failItem(__SPOT__); return false; }
+    if(sorted(2,2)!=0.0 || sorted(0,0)!=0.0)
+    {ti->failItem(__SPOT__); return false; }
+
+    // the same entries in another order, values written through
+    int j1[] = {3, 1, 0, 1};
+    int j2[] = {1, 4, 2, 0};
+    double values2[] = {4.5, 3.5, 1.5, 2.5};
+    const int* indices2[] = {j1, j2};
+    MP_data hashed(4,values2,indices2,s,t);
+    for(int a=0; a<4; a++) {
+        for(int b=0; b<5; b++) {
+            if(hashed(a,b)!=sorted(a,b))
+            {ti->failItem(__SPOT__); return false; }
+        }
+    }
+    hashed(1,0) = 7;
+    if(values2[3]!=7)
+    {ti->failItem(__SPOT__); return false; }
+
+    // saving and mapping a file
+    MP_data dense(s,t);
+    dense(2,3) = -1;
+    dense(0,4) = 6;
+    const char* fileName = "dataTest.tmp";
+    if(dense.save(fileName)!=true)
+    {ti->failItem(__SPOT__); return false; }
+    {
+        MP_data mapped(fileName,s,t);
+        if(mapped.entries()!=2 || mapped(2,3)!=-1 || mapped(0,4)!=6 ||
+           mapped(1,1)!=0)
+        {ti->failItem(__SPOT__); return false; }
+    }
+    std::remove(fileName);
+
+    ti->passItem();
+    return true;
+}
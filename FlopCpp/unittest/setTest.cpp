@@ -1,4 +1,5 @@
-#include "MP_set.hpp"
+#include <cstdio>
+#include "flopc.hpp"
 #include "TestItem.hpp"
 
 using namespace flopc;
@@ -52,3 +53,107 @@ bool setTest() {
     ti->passItem();
     return true;
 }
+
+bool subsetTest() {
+    TestItem *ti = new TestItem("flopc:subsetTest");
+    MP_set s(5), t(4);
+    MP_subset<2> arcs(s,t);
+    arcs.insert(3,1);
+    arcs.insert(0,2);
+    arcs.insert(3,1); // already there
+    arcs.insert(5,0); // out of range
+    if(arcs.size()!=2)
+    {ti->failItem(__SPOT__); return false; }
+    // elements are numbered in the order of insertion
+    if(arcs(3,1)!=0 || arcs(0,2)!=1 || arcs(2,2)!=outOfBound)
+    {ti->failItem(__SPOT__); return false; }
+
+    // bulk insertion, partly out of order and with duplicates
+    const int from[] = {4, 1, 1, 0, 3};
+    const int to[]   = {3, 0, 3, 2, 2};
+    arcs.insert(5,from,to);
+    if(arcs.size()!=6)
+    {ti->failItem(__SPOT__); return false; }
+    if(arcs(4,3)!=2 || arcs(1,0)!=3 || arcs(1,3)!=4 || arcs(3,2)!=5)
+    {ti->failItem(__SPOT__); return false; }
+    int found = 0;
+    for (int i=0; i<5; i++) {
+        for (int j=0; j<4; j++) {
+            if(arcs(i,j)!=outOfBound) {
+                found++;
+            }
+        }
+    }
+    if(found!=6)
+    {ti->failItem(__SPOT__); return false; }
+
+    // traversed in sorted order, also after inserting between traversals
+    MP_index i, j;
+    const SUBSETREF& ref = arcs(i,j);
+    for (int round=0; round<2; round++) {
+        if(ref.getSize()!=6+2*round)
+        {ti->failItem(__SPOT__); return false; }
+        for (int p=1; p<ref.getSize(); p++) {
+            const int* a = ref.getElement(p-1);
+            const int* b = ref.getElement(p);
+            if(a[0]>b[0] || (a[0]==b[0] && a[1]>=b[1]))
+            {ti->failItem(__SPOT__); return false; }
+        }
+        arcs.insert(2,1);
+        arcs.insert(0,0);
+    }
+
+    // sets too large for the positions to be packed into one integer
+    MP_set big(100000);
+    MP_subset<5> wide(big,big,big,big,big);
+    for (int k=0; k<1000; k++) {
+        wide.insert(k,2*k,3*k,4*k,99999-k);
+    }
+    wide.insert(7,14,21,28,99992);
+    if(wide.size()!=1000)
+    {ti->failItem(__SPOT__); return false; }
+    if(wide(7,14,21,28,99992)!=7 || wide(7,14,21,28,99993)!=outOfBound)
+    {ti->failItem(__SPOT__); return false; }
+
+    // a subset over a subset which grows after its construction
+    MP_subset<1> nodes(s);
+    MP_subset<2> links(t,nodes);
+    nodes.insert(0);
+    nodes.insert(1);
+    links.insert(0,1);
+    links.insert(1,0);
+    if(links.size()!=2 || links(0,1)!=0 || links(1,0)!=1 ||
+       links(0,0)!=outOfBound)
+    {ti->failItem(__SPOT__); return false; }
+    nodes.insert(2);
+    links.insert(3,2);
+    if(links.size()!=3 || links(3,2)!=2 || links(0,1)!=0 ||
+       links(1,0)!=1 || links(3,1)!=outOfBound)
+    {ti->failItem(__SPOT__); return false; }
+
+    // a loop over the subset with its leading index bound, as when rows
+    // are generated one index value at a time, visits only the elements
+    // having the value of that index
+    MP_index head, tail;
+    MP_variable y(s,t);
+    MP_expression e = sum((s(head)*t(tail)).such_that(arcs(head,tail)),
+                          y(head,tail));
+    GenerationProgram program;
+    program.compile(e.operator->(),MP_domain::getEmpty(),1.0);
+    program.prepare();
+    const int outgoing[] = {2, 2, 1, 2, 1};
+    head.instantiate();
+    for (int k=0; k<5; k++) {
+        head.assign(k);
+        std::vector<Coef> coefs;
+        ObjectiveGenerateFunctor f(coefs);
+        program.run(f);
+        if(f.getIterations()!=static_cast<size_t>(outgoing[k]) ||
+           coefs.size()!=static_cast<size_t>(outgoing[k]))
+        {ti->failItem(__SPOT__); return false; }
+    }
+    head.assign(0);
+    head.unInstantiate();
+    ti->passItem();
+    return true;
+}
@@ -0,0 +1,126 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "flopc.hpp"
+#include "CoinMpsIO.hpp"
+#include "TestItem.hpp"
+
+using namespace flopc;
+
+namespace {
+    bool readLines(const char* fileName, std::vector<std::string>& lines) {
+        std::ifstream in(fileName);
+        std::string line;
+        while(std::getline(in,line)) {
+            lines.push_back(line);
+        }
+        std::remove(fileName);
+        return !lines.empty();
+    }
+    bool contains(const std::vector<std::string>& lines,
+                  const std::string& line) {
+        return std::find(lines.begin(),lines.end(),line)!=lines.end();
+    }
+
+    // Counts the blocks generated with and without stages.
+    class StageCounter : public Messenger {
+    public:
+        StageCounter(int& p, int& s) : plain(p), staged(s) {}
+    private:
+        virtual void constraintDebug(std::string, const std::vector<Coef>&) {
+            plain++;
+        }
+        virtual void constraintDebug(std::string, const std::vector<Coef>&,
+                                     const std::vector<int>&) {
+            staged++;
+        }
+        int& plain;
+        int& staged;
+    };
+}
+
+bool smpsTest() {
+    TestItem *ti = new TestItem("flopc:smpsTest");
+    MP_model model(0);
+    model.silent();
+    MP_stage T(2);
+    MP_set J(2);
+    MP_data cost(J);
+    MP_stochastic_data demand(J);
+    cost(J) = J + 1;
+    demand(0) = 2;
+    demand(1) = 3;
+    MP_variable x(J), y(T,J);
+    x.setName("x");
+    y.setName("y");
+    MP_constraint cap(J), recourse(J);
+    cap.setName("cap");
+    recourse.setName("recourse");
+    cap(J) = x(J) <= 4;
+    recourse(J) = x(J) + y(1,J) >= demand(J);
+    model.setObjective(sum(J, cost(J)*x(J)) + sum(J, 3*y(1,J)));
+
+    {
+        MP_smps smps(model,"smpsTest");
+        if(smps.getStatus()!=0 || smps.getNumberStages()!=2)
+        {ti->failItem(__SPOT__); return false; }
+        demand(0) = 5;
+        if(smps.addScenario(0.5)!=0)
+        {ti->failItem(__SPOT__); return false; }
+        demand(0) = 2;
+        demand(1) = 6;
+        if(smps.addScenario(0.5)!=1 || smps.getNumberScenarios()!=2)
+        {ti->failItem(__SPOT__); return false; }
+        // the first stage cannot differ
+        if(smps.addScenario(0.5,-1,0)!=-1)
+        {ti->failItem(__SPOT__); return false; }
+    }
+
+    // The core, with the second stage rows and columns last
+    CoinMpsIO mps;
+    mps.messageHandler()->setLogLevel(0);
+    if(mps.readMps("smpsTest.cor","")!=0)
+    {ti->failItem(__SPOT__); return false; }
+    std::remove("smpsTest.cor");
+    if(mps.getNumRows()!=4 || mps.getNumCols()!=6)
+    {ti->failItem(__SPOT__); return false; }
+    if(mps.rowIndex("cap(1)")>1 || mps.rowIndex("recourse(0)")<2 ||
+       mps.columnIndex("y(0,1)")>3 || mps.columnIndex("y(1,0)")<4)
+    {ti->failItem(__SPOT__); return false; }
+    if(mps.getRowLower()[mps.rowIndex("recourse(1)")]!=3)
+    {ti->failItem(__SPOT__); return false; }
+
+    std::vector<std::string> time;
+    if(!readLines("smpsTest.tim",time) ||
+       !contains(time,"    y(1,0)  recourse(0)  STAGE1"))
+    {ti->failItem(__SPOT__); return false; }
+
+    // Each scenario lists the right hand sides it changes
+    std::vector<std::string> stoch;
+    if(!readLines("smpsTest.sto",stoch) || stoch.size()!=7 ||
+       stoch[1]!="SCENARIOS     DISCRETE" ||
+       stoch[2]!=" SC S1  ROOT  0.5  STAGE1" ||
+       stoch[3]!="    RHS  recourse(0)  5" ||
+       stoch[4]!=" SC S2  ROOT  0.5  STAGE1" ||
+       stoch[5]!="    RHS  recourse(1)  6" || stoch[6]!="ENDATA")
+    {ti->failItem(__SPOT__); return false; }
+
+    // Stages are kept per model: a model without stage sets stores no
+    // stages while another one has them
+    {
+        int plain = 0, staged = 0;
+        MP_model other(0, new StageCounter(plain,staged));
+        MP_variable z(J);
+        MP_constraint bound(J);
+        bound(J) = z(J) <= 1;
+        other.setObjective(sum(J, z(J)));
+        if(other.write("smpsTestOther.mps")!=0 || plain==0 || staged!=0)
+        {ti->failItem(__SPOT__); return false; }
+        std::remove("smpsTestOther.mps");
+    }
+
+    ti->passItem();
+    return true;
+}
@@ -0,0 +1,131 @@
+#include <cstdio>
+#include <string>
+#include <sstream>
+#include "flopc.hpp"
+#include "TestItem.hpp"
+#ifdef FLOPCPP_THREAD
+#include <pthread.h>
+#endif
+
+using namespace flopc;
+
+namespace {
+    std::string readFile(const std::string& name) {
+        std::string content;
+        FILE* fp = std::fopen(name.c_str(),"r");
+        if(fp!=0) {
+            char buffer[4096];
+            size_t n;
+            while((n=std::fread(buffer,1,sizeof(buffer),fp))>0) {
+                content.append(buffer,n);
+            }
+            std::fclose(fp);
+        }
+        std::remove(name.c_str());
+        return content;
+    }
+
+    /* Builds a model which keeps index values, partial sums of constants
+       and subset positions while it is generated, and writes it with the
+       given number of threads.
+    */
+    struct Job {
+        int seed;
+        int threads;
+        std::string mps;
+    };
+
+    void* buildAndWrite(void* info) {
+        Job* job = static_cast<Job*>(info);
+        MP_context context;
+        MP_model model(0);
+        model.silent();
+        model.setNumberThreads(job->threads);
+        MP_set i(20), j(15);
+        MP_subset<2> link(i,j);
+        for(int p=0; p<20; p++) {
+            link.insert(p,(p*7+job->seed)%15);
+        }
+        MP_data a(i,j);
+        a(i,j) = i + j + job->seed;
+        MP_variable x(i,j);
+        MP_constraint rows(i), cols(j), linked, out(i);
+        rows(i) = sum(j.such_that(a(i,j)>10), a(i,j)*x(i,j)) <= 100;
+        cols(j) = sum(i, x(i,j)) >= 0.01*sum(i, a(i,j));
+        linked = sum(link(i,j), x(i,j)) >= 2;
+        out(i) = sum(j.such_that(link(i,j)), x(i,j)) <= 3;
+        model.setObjective(sum(i*j, a(i,j)*x(i,j)));
+        std::ostringstream name;
+        name<<"threadTest"<<job->seed<<"_"<<job->threads<<".mps";
+        if(model.write(name.str())==0) {
+            job->mps = readFile(name.str());
+        }
+        return 0;
+    }
+}
+
+bool threadTest() {
+    TestItem *ti = new TestItem("flopc:threadTest");
+    const int numberJobs = 4;
+
+    // one model, generated with several threads
+    Job serial[numberJobs];
+    for(int k=0; k<numberJobs; k++) {
+        serial[k].seed = k;
+        serial[k].threads = 1;
+        buildAndWrite(&serial[k]);
+        if(serial[k].mps.empty()==true)
+        {ti->failItem(__SPOT__); return false; }
+    }
+    Job sliced = serial[0];
+    sliced.threads = 4;
+    buildAndWrite(&sliced);
+    if(sliced.mps!=serial[0].mps)
+    {ti->failItem(__SPOT__); return false; }
+
+    // independent models, each on a thread of its own
+    Job parallel[numberJobs];
+    for(int k=0; k<numberJobs; k++) {
+        parallel[k].seed = k;
+        parallel[k].threads = 2;
+    }
+#ifdef FLOPCPP_THREAD
+    pthread_t threads[numberJobs];
+    bool started[numberJobs];
+    for(int k=0; k<numberJobs; k++) {
+        started[k] = pthread_create(&threads[k],NULL,buildAndWrite,
+                                    &parallel[k])==0;
+    }
+    for(int k=0; k<numberJobs; k++) {
+        if(started[k]==true) {
+            pthread_join(threads[k],NULL);
+        } else {
+            buildAndWrite(&parallel[k]);
+        }
+    }
+#else
+    for(int k=0; k<numberJobs; k++) {
+        buildAndWrite(&parallel[k]);
+    }
+#endif
+    for(int k=0; k<numberJobs; k++) {
+        if(parallel[k].mps!=serial[k].mps)
+        {ti->failItem(__SPOT__); return false; }
+    }
+
+#ifdef FLOPCPP_THREAD
+    // the values of different threads are a cache line apart
+    PerThread<int> value(0);
+    const int slot = threadSlot();
+    setThreadSlot(0);
+    const char* first = reinterpret_cast<const char*>(&value());
+    setThreadSlot(1);
+    const char* second = reinterpret_cast<const char*>(&value());
+    setThreadSlot(slot);
+    if(second-first<FLOPCPP_CACHE_LINE)
+    {ti->failItem(__SPOT__); return false; }
+#endif
+
+    ti->passItem();
+    return true;
+}
@@ -12,8 +12,14 @@ int main() {
         bool bSuccess=true;
         bSuccess = indexTest();
         bSuccess = bSuccess && setTest();
+        bSuccess = bSuccess && subsetTest();
         bSuccess = bSuccess && constantTest();
+        bSuccess = bSuccess && dataTest();
         bSuccess = bSuccess && booleanTest();
+        bSuccess = bSuccess && writeTest();
+        bSuccess = bSuccess && arenaTest();
+        bSuccess = bSuccess && smpsTest();
+        bSuccess = bSuccess && threadTest();
 
         /* alternative if you don't like the TestItem TestBed arrangement.
         if(bSuccess)
@@ -2,8 +2,14 @@
 #define _UNITTEST_HPP_
 
 bool setTest();
+bool subsetTest();
 bool indexTest();
 bool constantTest();
+bool dataTest();
 bool booleanTest();
+bool writeTest();
+bool arenaTest();
+bool smpsTest();
+bool threadTest();
 
 #endif
@@ -0,0 +1,91 @@
+#include <cstdio>
+#include "flopc.hpp"
+#include "CoinMpsIO.hpp"
+#include "CoinLpIO.hpp"
+#include "TestItem.hpp"
+
+using namespace flopc;
+
+bool writeTest() {
+    TestItem *ti = new TestItem("flopc:writeTest");
+    MP_model model(0);
+    model.silent();
+    MP_set s(2), d(3);
+    MP_data cost(s,d);
+    cost(s,d) = s + d + 0.5;
+    MP_variable x(s,d), w;
+    MP_binary_variable open(s);
+    x.setName("x");
+    open.setName("open");
+    w.upperLimit() = 4;
+    MP_constraint supply(s), demand(d);
+    supply.setName("supply");
+    demand.setName("demand");
+    supply(s) = sum(d, x(s,d)) <= 10*open(s);
+    demand(d) = sum(s, x(s,d)) + w() >= 3;
+    model.setObjective(sum(s*d, cost(s,d)*x(s,d)) + sum(s, 5*open(s)));
+
+    // MPS, with names made of the block name and index values
+    const char* mpsFile = "writeTest.mps";
+    if(model.write(mpsFile)!=0)
+    {ti->failItem(__SPOT__); return false; }
+    CoinMpsIO mps;
+    mps.messageHandler()->setLogLevel(0);
+    if(mps.readMps(mpsFile,"")!=0)
+    {ti->failItem(__SPOT__); return false; }
+    std::remove(mpsFile);
+    if(mps.getNumRows()!=5 || mps.getNumCols()!=9)
+    {ti->failItem(__SPOT__); return false; }
+    const int row = mps.rowIndex("supply(1)");
+    const int col = mps.columnIndex("x(1,2)");
+    const int opened = mps.columnIndex("open(1)");
+    if(row<0 || col<0 || opened<0 || mps.rowIndex("demand(2)")<0)
+    {ti->failItem(__SPOT__); return false; }
+    if(mps.getObjCoefficients()[col]!=3.5 ||
+       mps.getObjCoefficients()[opened]!=5 || mps.isInteger(opened)!=true)
+    {ti->failItem(__SPOT__); return false; }
+    if(mps.getRowUpper()[row]!=0 ||
+       mps.getMatrixByRow()->getCoefficient(row,opened)!=-10 ||
+       mps.getMatrixByRow()->getCoefficient(row,col)!=1)
+    {ti->failItem(__SPOT__); return false; }
+    if(mps.getNumElements()!=17)
+    {ti->failItem(__SPOT__); return false; }
+    // the unnamed scalar variable is named after its block number
+    int unnamed = -1;
+    for(int j=0; j<mps.getNumCols(); j++) {
+        if(mps.columnName(j)[0]=='C') {
+            unnamed = j;
+        }
+    }
+    if(unnamed<0 || mps.getColUpper()[unnamed]!=4)
+    {ti->failItem(__SPOT__); return false; }
+
+    // LP, read back in the order of first appearance
+    const char* lpFile = "writeTest.lp";
+    if(model.write(lpFile,MP_model::LP)!=0)
+    {ti->failItem(__SPOT__); return false; }
+    CoinLpIO lp;
+    lp.readLp(lpFile);
+    std::remove(lpFile);
+    if(lp.getNumRows()!=5 || lp.getNumCols()!=9 ||
+       lp.getNumElements()!=17)
+    {ti->failItem(__SPOT__); return false; }
+    const int lpRow = lp.rowIndex("demand(1)");
+    if(lpRow<0 || lp.getRowLower()[lpRow]!=3 ||
+       lp.getObjCoefficients()[lp.columnIndex("x(1,2)")]!=3.5)
+    {ti->failItem(__SPOT__); return false; }
+
+    // the LP file states the direction, which the reader turns into
+    // minimization
+    model.setDirection(MP_model::MAXIMIZE);
+    if(model.write(lpFile,MP_model::LP)!=0)
+    {ti->failItem(__SPOT__); return false; }
+    CoinLpIO maximized;
+    maximized.readLp(lpFile);
+    std::remove(lpFile);
+    if(maximized.getObjCoefficients()[maximized.columnIndex("x(1,2)")]!=-3.5)
+    {ti->failItem(__SPOT__); return false; }
+
+    ti->passItem();
+    return true;
+}
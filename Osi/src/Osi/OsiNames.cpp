@@ -13,6 +13,7 @@
 #include "CoinLpIO.hpp"
 #include "CoinMpsIO.hpp"
 #include "CoinModel.hpp"
+#include "CoinBinaryModel.hpp"
 
 /*
   These routines support three name disciplines:
@@ -806,3 +807,65 @@ void OsiSolverInterface::setRowColNames (CoinLpIO &mod)
 */
   return ; }
 
+
+
+
+/*
+  Install the name information from a CoinBinaryModel object. The file may
+  have been written without names, in which case rowName and columnName
+  return NULL and we treat the names as empty.
+*/
+void OsiSolverInterface::setRowColNames (const CoinBinaryModel &mod)
+
+{ int nameDiscipline,m,n ;
+/*
+  Determine how we're handling names. It's possible that the underlying solver
+  has overridden getIntParam, but doesn't recognise OsiNameDiscipline. In that
+  case, we want to default to auto names
+*/
+  bool recognisesOsiNames = getIntParam(OsiNameDiscipline,nameDiscipline) ;
+  if (recognisesOsiNames == false)
+  { nameDiscipline = 0 ; }
+/*
+  Whatever happens, we're about to clean out the current name vectors. Decide
+  on an appropriate size and call reallocRowColNames to adjust capacity.
+*/
+  if (nameDiscipline == 0)
+  { m = 0 ;
+    n = 0 ; }
+  else
+  { m = mod.getNumRows() ;
+    n = mod.getNumCols() ; }
+  reallocRowColNames(rowNames_,m,colNames_,n) ;
+/*
+  If name discipline is auto, we're done already. Otherwise, load 'em up.
+*/
+  if (nameDiscipline != 0)
+  { int maxRowNdx=-1, maxColNdx=-1 ;
+    rowNames_.resize(m) ;
+    for (int i = 0 ; i < m ; i++)
+    { const char *name = mod.rowName(i) ;
+      std::string nme = name ? name : "" ;
+      if (nme.length() == 0)
+      { if (nameDiscipline == 2)
+	{ nme = dfltRowColName('r',i) ; } }
+      if (nme.length() > 0)
+      { maxRowNdx = i ; }
+      rowNames_[i] = nme ; }
+    rowNames_.resize(maxRowNdx+1) ;
+    objName_ = mod.getObjectiveName() ;
+    colNames_.resize(n) ;
+    for (int j = 0 ; j < n ; j++)
+    { const char *name = mod.columnName(j) ;
+      std::string nme = name ? name : "" ;
+      if (nme.length() == 0)
+      { if (nameDiscipline == 2)
+	{ nme = dfltRowColName('c',j) ; } }
+      if (nme.length() > 0)
+      { maxColNdx = j ; }
+      colNames_[j] = nme ; }
+    colNames_.resize(maxColNdx+1) ; }
+/*
+  And we're done.
+*/
+  return ; }
@@ -1683,7 +1683,7 @@ CoinPostsolveMatrix::CoinPostsolveMatrix(OsiSolverInterface*  si,
 */
   free_list_ = 0 ;
   maxlink_ = bulk0_ ;
-  link_ = new int[maxlink_] ;
+  link_ = new CoinBigIndex[maxlink_] ;
 
   nrows_ = si->getNumRows() ;
   ncols_ = si->getNumCols() ;
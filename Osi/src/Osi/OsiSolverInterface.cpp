@@ -8,6 +8,7 @@
 #include "CoinPragma.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinMpsIO.hpp"
+#include "CoinBinaryModel.hpp"
 #include "CoinMessage.hpp"
 #include "CoinWarmStart.hpp"
 #ifdef COIN_SNAPSHOT
@@ -76,7 +77,7 @@ OsiSolverInterface::getFractionalIndices(const double etol) const
 }
 
 
-int OsiSolverInterface::getNumElements() const
+CoinBigIndex OsiSolverInterface::getNumElements() const
 {
   return getMatrixByRow()->getNumElements();
 }
@@ -377,15 +378,15 @@ OsiSolverInterface::addCols(const int numcols,
   }
 }
 
-void OsiSolverInterface::addCols(const int numcols, const int* columnStarts,
+void OsiSolverInterface::addCols(const int numcols, const CoinBigIndex* columnStarts,
 				 const int* rows, const double* elements,
 				 const double* collb, const double* colub,   
 				 const double* obj)
 {
   double infinity = getInfinity();
   for (int i = 0; i < numcols; ++i) {
-    int start = columnStarts[i];
-    int number = columnStarts[i+1]-start;
+    CoinBigIndex start = columnStarts[i];
+    int number = static_cast<int>(columnStarts[i+1]-start);
     assert (number>=0);
     addCol(number, rows+start, elements+start, collb ? collb[i] : 0.0, 
 	   colub ? colub[i] : infinity, 
@@ -481,7 +482,7 @@ OsiSolverInterface::addCols( CoinModel & modelObject)
         new CoinPackedVectorBase * [numberColumns2];
       assert (columnLower);
       for (iColumn=0;iColumn<numberColumns2;iColumn++) {
-        int start = columnStart[iColumn];
+        CoinBigIndex start = columnStart[iColumn];
         columns[iColumn] = 
           new CoinPackedVector(columnLength[iColumn],
                                row+start,element+start);
@@ -559,14 +560,14 @@ OsiSolverInterface::addRow(int numberElements,
   The default implementation simply makes repeated calls to addRow().
 */
 void 
-OsiSolverInterface::addRows(const int numrows, const int* rowStarts,
+OsiSolverInterface::addRows(const int numrows, const CoinBigIndex* rowStarts,
 			    const int* columns, const double* elements,
 			    const double* rowlb, const double* rowub)
 {
   double infinity = getInfinity();
   for (int i = 0; i < numrows; ++i) {
-    int start = rowStarts[i];
-    int number = rowStarts[i+1]-start;
+    CoinBigIndex start = rowStarts[i];
+    int number = static_cast<int>(rowStarts[i+1]-start);
     assert (number>=0);
     addRow(number, columns+start, elements+start, rowlb ? rowlb[i] : -infinity, 
 	   rowub ? rowub[i] : infinity);
@@ -683,7 +684,7 @@ OsiSolverInterface::addRows( CoinModel & modelObject)
         new CoinPackedVectorBase * [numberRows2];
       assert (rowLower);
       for (iRow=0;iRow<numberRows2;iRow++) {
-        int start = rowStart[iRow];
+        CoinBigIndex start = rowStart[iRow];
         rows[iRow] = 
           new CoinPackedVector(rowLength[iRow],
                                column+start,element+start);
@@ -1256,6 +1257,46 @@ OsiSolverInterface::readGMPL(const char *filename, const char * dataname)
     }
   }
   return numberErrors;
+}
+/* Read a problem written by CoinMpsIO::writeBinary or CoinModel::writeBinary.
+   The arrays are passed to loadProblem as they are in the file.
+*/
+int 
+OsiSolverInterface::readBinary(const char *filename)
+{
+  CoinBinaryModel m;
+  int returnCode = m.read(filename);
+  handler_->message(COIN_SOLVER_MPS,messages_)
+    <<m.getProblemName()<< returnCode <<CoinMessageEol;
+  if (!returnCode) {
+
+    // set objective function offest
+    setDblParam(OsiObjOffset,m.objectiveOffset());
+
+    // set problem name
+    setStrParam(OsiProbName,m.getProblemName());
+
+    // no errors --- load problem, set names and integrality
+    loadProblem(m.getNumCols(),m.getNumRows(),
+		m.getVectorStarts(),m.getIndices(),m.getElements(),
+		m.getColLower(),m.getColUpper(),m.getObjCoefficients(),
+		m.getRowLower(),m.getRowUpper());
+    setRowColNames(m) ;
+    const char * integer = m.integerColumns();
+    if (integer) {
+      int i,n=0;
+      int nCols=m.getNumCols();
+      int * index = new int [nCols];
+      for (i=0;i<nCols;i++) {
+	if (integer[i]) {
+	  index[n++]=i;
+	}
+      }
+      setInteger(index,n);
+      delete [] index;
+    }
+  }
+  return returnCode;
 }
  /* Read a problem in MPS format from the given full filename.
    
@@ -23,6 +23,7 @@
 class CoinSnapshot;
 class CoinLpIO;
 class CoinMpsIO;
+class CoinBinaryModel;
 
 class OsiCuts;
 class OsiAuxInfo;
@@ -496,7 +497,7 @@ public:
     virtual int getNumRows() const = 0;
 
     /// Get the number of nonzero elements
-    virtual int getNumElements() const = 0;
+    virtual CoinBigIndex getNumElements() const = 0;
 
     /// Get the number of integer variables
     virtual int getNumIntegers() const ;
@@ -1036,6 +1037,14 @@ public:
     */
     void setRowColNames(CoinLpIO &mod) ;
 
+    /*! \brief Set row and column names from a CoinBinaryModel object.
+
+      Also sets the name of the objective function. If the file has no
+      names, rows and columns get default names only under the lazy
+      discipline.
+    */
+    void setRowColNames(const CoinBinaryModel &mod) ;
+
   //@}
   //-------------------------------------------------------------------------
     
@@ -1091,7 +1100,7 @@ public:
       The default implementation simply makes repeated calls to
       addCol().
     */
-    virtual void addCols(const int numcols, const int* columnStarts,
+    virtual void addCols(const int numcols, const CoinBigIndex* columnStarts,
 			 const int* rows, const double* elements,
 			 const double* collb, const double* colub,   
 			 const double* obj);
@@ -1180,7 +1189,7 @@ public:
       The default implementation simply makes repeated calls to
       addRow().
     */
-    virtual void addRows(const int numrows, const int *rowStarts,
+    virtual void addRows(const int numrows, const CoinBigIndex *rowStarts,
 			 const int *columns, const double *element,
 			 const double *rowlb, const double *rowub);
 
@@ -1435,6 +1444,16 @@ public:
     */
     virtual int readGMPL (const char *filename, const char *dataname=NULL);
 
+    /*! \brief Read a problem written by CoinMpsIO::writeBinary or
+	    CoinModel::writeBinary.
+
+      The default implementation loads the arrays of the (mapped) file
+      directly, without going through CoinMpsIO. Returns 0, -1 if the file
+      could not be opened, -2 if it is not a binary model and -3 if it is
+      too large for this CoinBigIndex.
+    */
+    virtual int readBinary (const char *filename);
+
     /*! \brief Write the problem in MPS format to the specified file.
 
       If objSense is non-zero, a value of -1.0 causes the problem to be
@@ -359,6 +359,7 @@ bool processParameters (int argc, const char **argv, std::map<std::string, std::
     definedKeyWords.insert("-netlibDir");
     definedKeyWords.insert("-miplib3Dir");
     definedKeyWords.insert("-testOsiSolverInterface");
+    definedKeyWords.insert("-testBigIndex");
     definedKeyWords.insert("-nobuf");
     definedKeyWords.insert("-cutsOnly");
     definedKeyWords.insert("-verbosity");
@@ -416,7 +417,7 @@ bool processParameters (int argc, const char **argv, std::map<std::string, std::
         if (definedKeyWords.find(key) == definedKeyWords.end()) {
             if( key != "-usage" && key != "-help" )
                 std::cerr << "Undefined parameter \"" << key << "\"." << std::endl ;
-            std::cerr << "Usage: unitTest [-nobuf] [-mpsDir=V1] [-netlibDir=V2] [-miplibDir=V3] [-testOsiSolverInterface] [-cutsOnly] [-verbosity=num]" << std::endl ;
+            std::cerr << "Usage: unitTest [-nobuf] [-mpsDir=V1] [-netlibDir=V2] [-miplibDir=V3] [-testOsiSolverInterface] [-testBigIndex[=V4]] [-cutsOnly] [-verbosity=num]" << std::endl ;
             std::cerr << "  where:" << std::endl ;
             std::cerr << "  -cerr2cout: redirect cerr to cout; sometimes useful to synchronise cout & cerr." << std::endl;
             std::cerr << "  -mpsDir: directory containing mps test files." << std::endl
@@ -427,6 +428,9 @@ bool processParameters (int argc, const char **argv, std::map<std::string, std::
                       << "       Default value V3=\"../../Data/miplib3\"" << std::endl;
             std::cerr << "  -testOsiSolverInterface: run each OSI on the netlib problem set." << std::endl
                       << "       Default is to not run the netlib problem set." << std::endl;
+            std::cerr << "  -testBigIndex: solve a generated problem with V4 elements, more than 2^31" << std::endl
+                      << "       by default, which needs a 64 bit CoinBigIndex and lots of memory." << std::endl
+                      << "       Default is to not run it." << std::endl;
             std::cerr << "  -cutsOnly: If specified, only OsiCut tests are run." << std::endl;
             std::cerr << "  -nobuf: use unbuffered output." << std::endl
                       << "       Default is buffered output." << std::endl;
@@ -1091,7 +1091,7 @@ int OsiCpxSolverInterface::getNumRows() const
 
   return CPXgetnumrows( env_, getMutableLpPtr() );
 }
-int OsiCpxSolverInterface::getNumElements() const
+CoinBigIndex OsiCpxSolverInterface::getNumElements() const
 {
   debugMessage("OsiCpxSolverInterface::getNumElements()\n");
 
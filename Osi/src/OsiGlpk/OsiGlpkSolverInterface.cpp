@@ -1196,7 +1196,7 @@ int OGSI::getNumRows() const
 	return lpx_get_num_rows( getMutableModelPtr() );
 }
 
-int OGSI::getNumElements() const
+CoinBigIndex OGSI::getNumElements() const
 {
 	return lpx_get_num_nz( getMutableModelPtr() );
 }
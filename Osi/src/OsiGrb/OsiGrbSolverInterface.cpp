@@ -1025,7 +1025,7 @@ int OsiGrbSolverInterface::getNumRows() const
   return numrows;
 }
 
-int OsiGrbSolverInterface::getNumElements() const
+CoinBigIndex OsiGrbSolverInterface::getNumElements() const
 {
   debugMessage("OsiGrbSolverInterface::getNumElements()\n");
 
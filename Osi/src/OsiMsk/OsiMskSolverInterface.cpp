@@ -1824,7 +1824,7 @@ int OsiMskSolverInterface::getNumRows() const
 //-----------------------------------------------------------------------------
 // Returns number of non-zeroes (in matrix) in MOSEK task
 
-int OsiMskSolverInterface::getNumElements() const
+CoinBigIndex OsiMskSolverInterface::getNumElements() const
 {
   #if MSK_OSI_DEBUG_LEVEL > 3
   debugMessage("Begin OsiMskSolverInterface::getNumElements()\n");
@@ -638,7 +638,7 @@ int OsiSpxSolverInterface::getNumRows() const
 {
   return soplex_->nRows();
 }
-int OsiSpxSolverInterface::getNumElements() const
+CoinBigIndex OsiSpxSolverInterface::getNumElements() const
 {
 #if 0
   return soplex_->nNzos();
@@ -576,7 +576,7 @@ OsiXprSolverInterface::getNumRows() const
    return nrows;
 }
 //-----------------------------------------------------------------------------
-int
+CoinBigIndex
 OsiXprSolverInterface::getNumElements() const
 {
    if ( !isDataLoaded() ) return 0;
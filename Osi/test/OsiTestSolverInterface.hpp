@@ -174,7 +174,7 @@ public:
   	rowMatrix_.getNumRows() : colMatrix_.getNumRows(); }
   
       /// Get number of nonzero elements
-      virtual int getNumElements() const {
+      virtual CoinBigIndex getNumElements() const {
         return rowMatrixCurrent_?
   	rowMatrix_.getNumElements() : colMatrix_.getNumElements(); }
   